@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# Runs rtos_benchmark under QEMU and prints its BENCH lines.
+#
+# usage: run_qemu.sh [elf] [timeout in seconds]
+#
+# QEMU may be set to the qemu-system-arm binary to use.  Exits 0 only if
+# the benchmark printed BENCH_END within the timeout.
+
+ELF=${1:-Debug/rtos_benchmark.elf}
+TIMEOUT=${2:-300}
+QEMU=${QEMU:-qemu-system-arm}
+LOG=$(mktemp)
+
+"$QEMU" -M xilinx-zynq-a9 -m 512M -nographic -monitor none \
+	-serial null -serial file:"$LOG" -icount shift=0 \
+	-kernel "$ELF" &
+PID=$!
+
+STATUS=1
+ELAPSED=0
+while [ "$ELAPSED" -lt "$TIMEOUT" ] && kill -0 "$PID" 2>/dev/null; do
+	if grep -q '^BENCH_END' "$LOG"; then
+		STATUS=0
+		break
+	fi
+	if grep -q '^BENCH_ERROR' "$LOG"; then
+		break
+	fi
+	sleep 1
+	ELAPSED=$((ELAPSED + 1))
+done
+
+kill "$PID" 2>/dev/null
+wait "$PID" 2>/dev/null
+
+tr -d '\r' < "$LOG" | grep '^BENCH'
+rm -f "$LOG"
+exit $STATUS
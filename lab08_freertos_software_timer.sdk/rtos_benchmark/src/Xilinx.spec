@@ -0,0 +1,2 @@
+*startfile:
+crti%O%s crtbegin%O%s
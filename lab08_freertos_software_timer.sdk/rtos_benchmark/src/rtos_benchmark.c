@@ -0,0 +1,1685 @@
+/*
+    Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+    Copyright (C) 2012 - 2018 Xilinx, Inc. All Rights Reserved.
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of
+    this software and associated documentation files (the "Software"), to deal in
+    the Software without restriction, including without limitation the rights to
+    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+    the Software, and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software. If you wish to use our Amazon
+    FreeRTOS name, please do so in a fair use way that does not cause confusion.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+    FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+    COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+    IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+    http://www.FreeRTOS.org
+    http://aws.amazon.com/freertos
+
+
+    1 tab == 4 spaces!
+*/
+/*
+ * rtos_benchmark.c
+ *
+ * Created on: 	18 October 2026 (based on rtos_software_timer.c)
+ *    Version: 	2.14
+ */
+
+/********************************************************************************************
+* VERSION HISTORY
+********************************************************************************************
+* 	v2.14 - 18 October 2026
+* 		Added the context-switch data cache benchmark, to compare the TCB layouts.
+*
+* 	v2.13 - 18 October 2026
+* 		Added the placed heap benchmarks.
+*
+* 	v2.12 - 18 October 2026
+* 		Report where the kernel data and the heap are placed, so runs with the kernel
+* 		in the on-chip memory can be told from runs with it in DDR.
+*
+* 	v2.11 - 18 October 2026
+* 		Added the task and queue churn benchmarks and the object pool statistics.
+*
+* 	v2.10 - 18 October 2026
+* 		Added the heap benchmarks and the fragmentation they leave.
+*
+* 	v2.9 - 18 October 2026
+* 		Added the queue set benchmarks.
+*
+* 	v2.8 - 18 October 2026
+* 		Added the RCU read and publish benchmarks.
+*
+* 	v2.7 - 18 October 2026
+* 		Added uncontended mutex and spin lock benchmarks, and the contended spin lock
+* 		benchmark.
+*
+* 	v2.6 - 18 October 2026
+* 		Added the contended mutex benchmark and its mutex metrics.
+*
+* 	v2.5 - 18 October 2026
+* 		Added the event group interrupt to task latency benchmark.
+*
+* 	v2.4 - 18 October 2026
+* 		Added burst benchmarks, item by item and through the multiple item queue API.
+*
+* 	v2.3 - 18 October 2026
+* 		Added stream buffer benchmarks, by copy and in place.
+*
+* 	v2.2 - 18 October 2026
+* 		Added queue and single producer, single consumer ring benchmarks for 4, 64 and
+* 		1024 byte items.
+*
+* 	v2.1 - 18 October 2026
+* 		Added frame queue benchmarks, by copy and through a zero copy queue.
+*
+* 	v2.0 - 18 October 2026
+* 		Added queue, notification, semaphore and tick ISR benchmarks.
+* 		Report percentiles in a comma separated format for regression tracking.
+*
+* 	v1.0 - 18 October 2026
+* 		Context-switch benchmark for the lazy FPU context switch.
+*
+*******************************************************************************************/
+
+/********************************************************************************************
+* TASK DESCRIPTION
+********************************************************************************************
+* CTRLtask    := runs each benchmark in turn and reports the results over the UART.
+*
+* MEASUREtask := takes the samples of one benchmark with the PMU cycle counter.
+*
+* PARTNERtask := the other side of the two-task benchmarks.
+*
+* BENCHMARKS (all values in CPU cycles)
+*   cs_int         - taskYIELD() round trip between two tasks, i.e. two context switches.
+*                    Neither task has an FPU context.
+*   cs_fpu_owner   - as cs_int, but PARTNERtask has an FPU context and uses it every
+*                    BENCH_FPU_PERIOD switches, while MEASUREtask has none and never
+*                    uses it.  The FPU never changes owner, so no VFP registers are
+*                    moved after the first trap.
+*   cs_fpu_shared  - as cs_int, both tasks use the FPU every BENCH_FPU_PERIOD switches.
+*   cs_fpu_always  - as cs_int, both tasks use the FPU on every switch, so every
+*                    switch-in takes the undefined instruction trap.
+*   cs_dcache      - as cs_int, with the L1 data cache cleaned and invalidated before
+*                    each round trip, so every line of the TCBs, stacks and kernel data
+*                    the two switches touch is refilled once.  The refills and accesses
+*                    counted by the PMU follow as a BENCH_DCACHE line.  The simulation
+*                    has no caches and counts none.
+*   queue_rtt      - xQueueSend() to PARTNERtask and xQueueReceive() of its reply, with
+*                    both tasks at the same priority.
+*   queue_frame    - as queue_rtt with BENCH_FRAME_SIZE byte items, so each round trip
+*                    copies a frame four times.
+*   zc_queue_frame - as queue_frame through zero copy queues: each side borrows the frame
+*                    it is sent and fills the frame it sends in place.  Only built when
+*                    configUSE_ZERO_COPY_QUEUES is 1.
+*   queue_sr_<n>   - xQueueSend() followed by xQueueReceive() of an <n> byte item, in one
+*                    task, for n = 4, 64 and 1024.
+*   spsc_sr_<n>    - as queue_sr_<n> with xSPSCRingSend() and xSPSCRingReceive().  The
+*                    spsc_ benchmarks are only built when configUSE_SPSC_RINGS is 1.
+*   spsc_rtt       - as queue_rtt through two rings, so both tasks block and are woken
+*                    by the ring's task notification.
+*   queue_burst    - BENCH_BURST_SIZE xQueueSend() calls followed by as many
+*                    xQueueReceive() calls, of 4 byte items, in one task.  The queue holds
+*                    BENCH_BURST_QUEUE_LENGTH items, so bursts wrap at varying offsets.
+*   queue_multi    - as queue_burst with one xQueueSendMultiple() and one
+*                    xQueueReceiveMultiple() call per burst.
+*   qset_select    - xQueueSend() to one of BENCH_SET_MEMBERS queues in a queue set,
+*                    xQueueSelectFromSet() and xQueueReceive() from the member selected.
+*   qset_many      - xQueueSend() to every member of the set, one
+*                    uxQueueSelectManyFromSet() and an xQueueReceive() from each member.
+*                    Only built when configUSE_QUEUE_SET_BITMAP is 1.
+*   stream_copy    - xStreamBufferSend() of BENCH_FRAME_SIZE bytes followed by
+*                    xStreamBufferReceive() of them, in one task.  The stream buffer holds
+*                    a little over three frames, so the frames wrap at varying offsets.
+*   stream_spans   - as stream_copy, written in place through xStreamBufferGetWriteSpan()
+*                    and xStreamBufferCommitWrite() and read in place through
+*                    xStreamBufferReceiveSpans() and vStreamBufferReleaseSpans().  The
+*                    stream_ benchmarks are only built when configSTREAM_BUFFER is 1.
+*   notify_latency - from xTaskNotifyGive() to the return of ulTaskNotifyTake() in a
+*                    higher priority PARTNERtask, i.e. one preempting switch.
+*   eg_isr_latency - from xEventGroupSetBitsFromISR() in the tick hook to the return of
+*                    xEventGroupWaitBits() in MEASUREtask, one sample per tick.
+*                    PARTNERtask waits for that bit and one that is never set.  With
+*                    configUSE_EVENT_GROUP_INDEX 1 the interrupt sets the bit itself and
+*                    does not visit PARTNERtask, otherwise the timer task sets it.  Only
+*                    built when configUSE_TICK_HOOK is 1.
+*   mutex_handoff  - xSemaphoreTake() of a mutex held by the lower priority PARTNERtask,
+*                    which inherits the priority of MEASUREtask and gives the mutex back,
+*                    i.e. two switches and an inheritance.  With configUSE_MUTEX_METRICS 1
+*                    the statistics of the mutex follow as a BENCH_MUTEX line.
+*   mutex_take_give - xSemaphoreTake() followed by xSemaphoreGive() of an uncontended
+*                    mutex.
+*   spin_take_give - as mutex_take_give with xSpinLockTake() and vSpinLockGive().  The
+*                    spin_ benchmarks are only built when configUSE_SPIN_LOCKS is 1.
+*   spin_handoff   - as mutex_handoff with a spin lock.  The lock is held by a task of
+*                    the same core, so MEASUREtask blocks at once rather than spinning.
+*   rcu_read       - pvRcuReadLock(), a read of the snapshot and vRcuReadUnlock(), to
+*                    compare with mutex_take_give.  The rcu_ benchmarks are only built
+*                    when configUSE_RCU is 1.
+*   rcu_publish    - pvRcuCopy() and vRcuPublish() of a new snapshot while no task is
+*                    inside a read section, i.e. an allocation, a copy and a free.
+*   heap_malloc    - pvPortMalloc() of 1 to BENCH_HEAP_MAX_SIZE bytes in a workload that
+*                    allocates or frees one of BENCH_HEAP_SLOTS blocks at random, from the
+*                    same pseudo-random sequence on every run.  The heap state the
+*                    workload leaves follows as a BENCH_HEAP line.
+*   heap_free      - vPortFree() in the heap_malloc workload.
+*   heap_bulk      - pvPortMallocPlaced() of a BENCH_FRAME_SIZE byte, cache line aligned
+*                    buffer from the bulk regions, and vPortFree() of it.  The heap_
+*                    benchmarks that place buffers are only built when configUSE_TLSF_HEAP
+*                    is 1.
+*   heap_dma       - as heap_bulk from the DMA region.  Only built when
+*                    configTOTAL_DMA_HEAP_SIZE is not 0.
+*   task_churn     - xTaskCreate() of a task below MEASUREtask and vTaskDelete() of it,
+*                    which frees its TCB and stack at once.  With configUSE_OBJECT_POOLS 1
+*                    the statistics of each object pool follow as BENCH_POOL lines.
+*   queue_churn    - xQueueCreate() of a 4 item queue and vQueueDelete() of it.
+*   sem_give_take  - xSemaphoreGive() followed by xSemaphoreTake() of an uncontended
+*                    binary semaphore.
+*   tick_isr       - time stolen from a spinning task by each tick interrupt, plus the
+*                    few cycles of the spin loop itself.
+*
+* OUTPUT
+*   BENCH_BEGIN,rtos_benchmark,<version>,<CPU clock in Hz>
+*   BENCH_PLACEMENT,<kernel>	(ocm with configPLACE_KERNEL_IN_OCM 1, default otherwise;
+*                    compare cs_int, notify_latency and tick_isr across the two)
+*   BENCH_FIELDS,name,samples,min,avg,max,p50,p90,p99
+*   BENCH,<name>,<samples>,<min>,<avg>,<max>,<p50>,<p90>,<p99>	(one per benchmark)
+*   BENCH_DCACHE,<name>,<switches>,<refills>,<accesses>,<refills per 100 switches>
+*                    (cs_dcache; L1 data cache events counted by the PMU)
+*   BENCH_MUTEX,<name>,<acquisitions>,<contended>,<max hold>,<max wait>	(mutex_handoff)
+*   BENCH_HEAP,<name>,<heap>,<free bytes>,<largest free block>,<free blocks>,<fragmentation %>
+*                    (heap_malloc; heap is heap_4 or heap_tlsf)
+*   BENCH_POOL,<name>,<block size>,<blocks>,<min free>,<allocations>,<fallbacks>
+*                    (task_churn, one per object pool)
+*   BENCH_END
+* A run that cannot take samples prints BENCH_ERROR,<reason> instead of BENCH_END.
+*
+*******************************************************************************************/
+
+/* Standard includes. */
+#include <stdlib.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "spsc_ring.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+#include "spin_lock.h"
+#include "rcu.h"
+#include "object_pool.h"
+/* Xilinx includes. */
+#include "xil_printf.h"
+#define	printf	xil_printf
+#include "xparameters.h"
+#include "xpm_counter.h"
+#include "xil_cache_l.h"
+
+/* benchmark definitions */
+#define	BENCH_VERSION			"2.14"
+#define	BENCH_ITERATIONS		1000						/* samples taken per benchmark */
+#define	BENCH_TICK_ITERATIONS	100							/* tick samples, one per tick */
+#define	BENCH_TICK_THRESHOLD	500UL						/* spin gap taken as an interrupt
+															   (in cycles) */
+#define	BENCH_FPU_PERIOD		16							/* switches between occasional
+															   FPU use */
+#define	BENCH_PMU_DCACHE_REFILL	3							/* counters of XPM_CNTRCFG1 */
+#define	BENCH_PMU_DCACHE_ACCESS	4
+#define	BENCH_FRAME_SIZE		1024						/* bytes per frame queue item */
+#define	BENCH_BURST_SIZE		32							/* items per queue burst */
+#define	BENCH_BURST_QUEUE_LENGTH	48						/* items the burst queue holds */
+#define	BENCH_SET_MEMBERS		12							/* queues in the queue set */
+#define	BENCH_HEAP_SLOTS		32							/* blocks the heap workload holds */
+#define	BENCH_HEAP_MAX_SIZE		512							/* largest block it allocates
+															   (in bytes) */
+#define	BENCH_HEAP_SEED			0x2545F491UL				/* start of its random sequence */
+#define	BENCH_EVENT_BIT			( 1UL << 0 )				/* set by the tick hook */
+#define	BENCH_EVENT_UNSET_BIT	( 1UL << 1 )				/* never set */
+#define	BENCH_STACK_SIZE		( configMINIMAL_STACK_SIZE * 2 )
+#define	BENCH_PRIORITY			( tskIDLE_PRIORITY + 2 )	/* MEASUREtask */
+#define	CTRL_PRIORITY			( tskIDLE_PRIORITY + 4 )	/* CTRLtask preempts the benchmark */
+#define	CLEANUP_DELAY			10UL						/* time for the idle task to free
+															   deleted tasks (in ms) */
+
+/* how often a task touches the FPU */
+typedef enum
+{
+	eFPUNever,
+	eFPUOccasional,
+	eFPUAlways
+} FPUUse_t;
+
+/* one benchmark */
+typedef struct
+{
+	const char *pcName;
+	TaskFunction_t pxMeasureTask;	/* takes the samples */
+	TaskFunction_t pxPartnerTask;	/* NULL if the benchmark needs one task */
+	UBaseType_t uxPartnerPriority;
+	FPUUse_t eMeasureFPU;			/* FPU use by MEASUREtask */
+	FPUUse_t ePartnerFPU;			/* FPU use by PARTNERtask */
+	UBaseType_t uxItemSize;			/* item size of the queue_sr_ and spsc_sr_ benchmarks */
+} Bench_t;
+/*-----------------------------------------------------------*/
+
+/* The tasks as described at the top of this file. */
+static void prvCTRLtask( void *pvParameters );
+static void prvSwitchMeasure( void *pvParameters );
+static void prvSwitchPartner( void *pvParameters );
+static void prvSwitchDCacheMeasure( void *pvParameters );
+static void prvQueueMeasure( void *pvParameters );
+static void prvQueuePartner( void *pvParameters );
+static void prvFrameMeasure( void *pvParameters );
+static void prvFramePartner( void *pvParameters );
+#if( configUSE_ZERO_COPY_QUEUES == 1 )
+	static void prvZeroCopyMeasure( void *pvParameters );
+	static void prvZeroCopyPartner( void *pvParameters );
+#endif
+static void prvQueueSendReceiveMeasure( void *pvParameters );
+static void prvBurstMeasure( void *pvParameters );
+static void prvMultipleMeasure( void *pvParameters );
+static void prvQueueSetMeasure( void *pvParameters );
+#if( configUSE_QUEUE_SET_BITMAP == 1 )
+	static void prvQueueSetManyMeasure( void *pvParameters );
+#endif
+#if( configSTREAM_BUFFER == 1 )
+	static void prvStreamCopyMeasure( void *pvParameters );
+	static void prvStreamSpansMeasure( void *pvParameters );
+#endif
+#if( configUSE_SPSC_RINGS == 1 )
+	static void prvRingSendReceiveMeasure( void *pvParameters );
+	static void prvRingMeasure( void *pvParameters );
+	static void prvRingPartner( void *pvParameters );
+#endif
+static void prvNotifyMeasure( void *pvParameters );
+static void prvNotifyPartner( void *pvParameters );
+#if( configUSE_TICK_HOOK == 1 )
+	static void prvEventMeasure( void *pvParameters );
+	static void prvEventPartner( void *pvParameters );
+#endif
+static void prvMutexMeasure( void *pvParameters );
+static void prvMutexPartner( void *pvParameters );
+static void prvMutexTakeGiveMeasure( void *pvParameters );
+#if( configUSE_SPIN_LOCKS == 1 )
+	static void prvSpinTakeGiveMeasure( void *pvParameters );
+	static void prvSpinMeasure( void *pvParameters );
+	static void prvSpinPartner( void *pvParameters );
+#endif
+#if( configUSE_RCU == 1 )
+	static void prvRcuReadMeasure( void *pvParameters );
+	static void prvRcuPublishMeasure( void *pvParameters );
+#endif
+static void prvHeapMallocMeasure( void *pvParameters );
+static void prvHeapFreeMeasure( void *pvParameters );
+#if( configUSE_TLSF_HEAP == 1 )
+	static void prvHeapBulkMeasure( void *pvParameters );
+	#if( configTOTAL_DMA_HEAP_SIZE > 0 )
+		static void prvHeapDMAMeasure( void *pvParameters );
+	#endif
+#endif
+static void prvTaskChurnMeasure( void *pvParameters );
+static void prvQueueChurnMeasure( void *pvParameters );
+static void prvSemaphoreMeasure( void *pvParameters );
+static void prvTickMeasure( void *pvParameters );
+
+/* The work done by a context-switch task between two switches. */
+static void prvBenchWork( FPUUse_t eUse, uint32_t ulIteration );
+
+/* Hands control back to CTRLtask at the end of a benchmark. */
+static void prvBenchDone( void );
+
+/* Sorts ulSamples and prints their statistics. */
+static void prvReport( const char *pcName );
+
+/* Prints the data cache events counted by cs_dcache. */
+static void prvReportDCache( const char *pcName );
+
+#if( configUSE_MUTEX_METRICS == 1 )
+	/* Prints the statistics kept by the mutex of mutex_handoff. */
+	static void prvReportMutex( const char *pcName );
+#endif
+
+/* Prints the heap state left by the heap_malloc workload. */
+static void prvReportHeap( const char *pcName );
+
+#if( configUSE_OBJECT_POOLS == 1 )
+	/* Prints the statistics of every object pool. */
+	static void prvReportPools( const char *pcName );
+#endif
+/*-----------------------------------------------------------*/
+
+static const Bench_t xBenches[] =
+{
+	{ "cs_int",			prvSwitchMeasure,	prvSwitchPartner,	BENCH_PRIORITY,		eFPUNever,		eFPUNever,		0	},
+	{ "cs_fpu_owner",	prvSwitchMeasure,	prvSwitchPartner,	BENCH_PRIORITY,		eFPUNever,		eFPUOccasional,	0	},
+	{ "cs_fpu_shared",	prvSwitchMeasure,	prvSwitchPartner,	BENCH_PRIORITY,		eFPUOccasional,	eFPUOccasional,	0	},
+	{ "cs_fpu_always",	prvSwitchMeasure,	prvSwitchPartner,	BENCH_PRIORITY,		eFPUAlways,		eFPUAlways,		0	},
+	{ "cs_dcache",		prvSwitchDCacheMeasure, prvSwitchPartner, BENCH_PRIORITY,	eFPUNever,		eFPUNever,		0	},
+	{ "queue_rtt",		prvQueueMeasure,	prvQueuePartner,	BENCH_PRIORITY,		eFPUNever,		eFPUNever,		0	},
+	{ "queue_frame",	prvFrameMeasure,	prvFramePartner,	BENCH_PRIORITY,		eFPUNever,		eFPUNever,		0	},
+#if( configUSE_ZERO_COPY_QUEUES == 1 )
+	{ "zc_queue_frame",	prvZeroCopyMeasure,	prvZeroCopyPartner,	BENCH_PRIORITY,		eFPUNever,		eFPUNever,		0	},
+#endif
+	{ "queue_sr_4",		prvQueueSendReceiveMeasure, NULL,		0,					eFPUNever,		eFPUNever,		4	},
+	{ "queue_sr_64",	prvQueueSendReceiveMeasure, NULL,		0,					eFPUNever,		eFPUNever,		64	},
+	{ "queue_sr_1024",	prvQueueSendReceiveMeasure, NULL,		0,					eFPUNever,		eFPUNever,		1024	},
+#if( configUSE_SPSC_RINGS == 1 )
+	{ "spsc_sr_4",		prvRingSendReceiveMeasure, NULL,		0,					eFPUNever,		eFPUNever,		4	},
+	{ "spsc_sr_64",		prvRingSendReceiveMeasure, NULL,		0,					eFPUNever,		eFPUNever,		64	},
+	{ "spsc_sr_1024",	prvRingSendReceiveMeasure, NULL,		0,					eFPUNever,		eFPUNever,		1024	},
+	{ "spsc_rtt",		prvRingMeasure,		prvRingPartner,		BENCH_PRIORITY,		eFPUNever,		eFPUNever,		0	},
+#endif
+	{ "queue_burst",	prvBurstMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "queue_multi",	prvMultipleMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "qset_select",	prvQueueSetMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+#if( configUSE_QUEUE_SET_BITMAP == 1 )
+	{ "qset_many",		prvQueueSetManyMeasure, NULL,			0,					eFPUNever,		eFPUNever,		0	},
+#endif
+#if( configSTREAM_BUFFER == 1 )
+	{ "stream_copy",	prvStreamCopyMeasure, NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "stream_spans",	prvStreamSpansMeasure, NULL,			0,					eFPUNever,		eFPUNever,		0	},
+#endif
+	{ "notify_latency",	prvNotifyMeasure,	prvNotifyPartner,	BENCH_PRIORITY + 1,	eFPUNever,		eFPUNever,		0	},
+#if( configUSE_TICK_HOOK == 1 )
+	{ "eg_isr_latency",	prvEventMeasure,	prvEventPartner,	BENCH_PRIORITY,		eFPUNever,		eFPUNever,		0	},
+#endif
+	{ "mutex_handoff",	prvMutexMeasure,	prvMutexPartner,	BENCH_PRIORITY - 1,	eFPUNever,		eFPUNever,		0	},
+	{ "mutex_take_give", prvMutexTakeGiveMeasure, NULL,			0,					eFPUNever,		eFPUNever,		0	},
+#if( configUSE_SPIN_LOCKS == 1 )
+	{ "spin_take_give",	prvSpinTakeGiveMeasure, NULL,			0,					eFPUNever,		eFPUNever,		0	},
+	{ "spin_handoff",	prvSpinMeasure,		prvSpinPartner,		BENCH_PRIORITY - 1,	eFPUNever,		eFPUNever,		0	},
+#endif
+#if( configUSE_RCU == 1 )
+	{ "rcu_read",		prvRcuReadMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "rcu_publish",	prvRcuPublishMeasure, NULL,				0,					eFPUNever,		eFPUNever,		0	},
+#endif
+	{ "heap_malloc",	prvHeapMallocMeasure, NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "heap_free",		prvHeapFreeMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+#if( configUSE_TLSF_HEAP == 1 )
+	{ "heap_bulk",		prvHeapBulkMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+#if( configTOTAL_DMA_HEAP_SIZE > 0 )
+	{ "heap_dma",		prvHeapDMAMeasure,	NULL,				0,					eFPUNever,		eFPUNever,		0	},
+#endif
+#endif
+	{ "task_churn",		prvTaskChurnMeasure, NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "queue_churn",	prvQueueChurnMeasure, NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "sem_give_take",	prvSemaphoreMeasure, NULL,				0,					eFPUNever,		eFPUNever,		0	},
+	{ "tick_isr",		prvTickMeasure,		NULL,				0,					eFPUNever,		eFPUNever,		0	}
+};
+
+/* The task handles of the benchmark being run. */
+static TaskHandle_t xCTRLtask;
+static TaskHandle_t xPARTNERtask;
+/* The queues and semaphore used by the benchmarks. */
+static QueueHandle_t xRequestQueue;
+static QueueHandle_t xReplyQueue;
+static QueueHandle_t xFrameRequestQueue;
+static QueueHandle_t xFrameReplyQueue;
+#if( configUSE_ZERO_COPY_QUEUES == 1 )
+	static QueueHandle_t xZeroCopyRequestQueue;
+	static QueueHandle_t xZeroCopyReplyQueue;
+#endif
+#if( configUSE_SPSC_RINGS == 1 )
+	static SPSCRingHandle_t xRequestRing;
+	static SPSCRingHandle_t xReplyRing;
+#endif
+static SemaphoreHandle_t xBenchSemaphore;
+static SemaphoreHandle_t xBenchMutex;
+#if( configUSE_SPIN_LOCKS == 1 )
+	static SpinLockHandle_t xBenchSpinLock;
+#endif
+#if( configUSE_RCU == 1 )
+	static RcuHandle_t xBenchRcu;
+#endif
+#if( configUSE_TICK_HOOK == 1 )
+	static EventGroupHandle_t xBenchEventGroup;
+	/* The tick hook only sets BENCH_EVENT_BIT while eg_isr_latency runs. */
+	static volatile BaseType_t xBenchEventArmed = pdFALSE;
+#endif
+/* The L1 data cache events counted by cs_dcache. */
+static uint64_t ullBenchDCacheRefills;
+static uint64_t ullBenchDCacheAccesses;
+/* The heap state left by the heap_malloc workload. */
+static HeapStats_t xBenchHeapStats;
+/* The frames copied by queue_frame, one per task; too large for the task stacks. */
+static uint32_t ulMeasureFrame[ BENCH_FRAME_SIZE / sizeof( uint32_t ) ];
+static uint32_t ulPartnerFrame[ BENCH_FRAME_SIZE / sizeof( uint32_t ) ];
+/* The samples of the benchmark being run, in CPU cycles. */
+static uint32_t ulSamples[ BENCH_ITERATIONS ];
+static volatile size_t uxSampleCount = 0;
+/* The start of a sample taken across two tasks. */
+static volatile uint32_t ulSampleStart = 0;
+/* Written by prvBenchWork() so the work is not optimised away. */
+static volatile uint32_t ulIntWork = 0;
+static volatile float fFloatWork = 0.0f;
+
+int main( void )
+{
+	/* The cycle counter is not running out of reset. */
+	vPortEnableCycleCounter();
+
+	printf( "Starting CTRLtask . . .\r\n" );
+	xTaskCreate(
+				prvCTRLtask,					/* The function implementing the task. */
+			( const char * ) "CTRLtask",		/* Text name provided for debugging. */
+				BENCH_STACK_SIZE,				/* Room for the report formatting. */
+				NULL,							/* The task parameter, not in use. */
+				( UBaseType_t ) CTRL_PRIORITY,	/* Above the benchmark tasks. */
+				&xCTRLtask );
+	printf( "\tSuccessful\r\n" );
+
+	/* Start the tasks running. */
+	vTaskStartScheduler();
+
+	/* If all is well, the scheduler will now be running, and the following line
+	will never be reached.  If the following line does execute, then there was
+	insufficient FreeRTOS heap memory available for the idle and/or timer tasks
+	to be created.  See the memory management section on the FreeRTOS web site
+	for more details. */
+	for( ;; );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvCTRLtask( void *pvParameters )
+{
+	const TickType_t xCleanupTicks = pdMS_TO_TICKS( CLEANUP_DELAY );
+	const Bench_t *pxBench;
+	TaskHandle_t xMEASUREtask;
+	uint32_t ulCycles;
+	size_t x;
+
+	printf( "BENCH_BEGIN,rtos_benchmark,%s,%u\r\n", BENCH_VERSION,
+			( unsigned int ) XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ );
+#if( configPLACE_KERNEL_IN_OCM == 1 )
+	printf( "BENCH_PLACEMENT,ocm\r\n" );
+#else
+	printf( "BENCH_PLACEMENT,default\r\n" );
+#endif
+
+	/* An emulator without a PMU reads the cycle counter as a constant. */
+	ulCycles = portGET_CYCLE_COUNT();
+	vTaskDelay( 1 );
+	if( portGET_CYCLE_COUNT() == ulCycles ) {
+		printf( "BENCH_ERROR,cycle counter not running\r\n" );
+		vTaskSuspend( NULL );
+	}
+
+	xRequestQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	xReplyQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	xFrameRequestQueue = xQueueCreate( 1, BENCH_FRAME_SIZE );
+	xFrameReplyQueue = xQueueCreate( 1, BENCH_FRAME_SIZE );
+	xBenchSemaphore = xSemaphoreCreateBinary();
+	xBenchMutex = xSemaphoreCreateMutex();
+	configASSERT( xRequestQueue );
+	configASSERT( xReplyQueue );
+	configASSERT( xFrameRequestQueue );
+	configASSERT( xFrameReplyQueue );
+	configASSERT( xBenchSemaphore );
+	configASSERT( xBenchMutex );
+#if( configUSE_ZERO_COPY_QUEUES == 1 )
+	xZeroCopyRequestQueue = xQueueCreateZeroCopy( 1, BENCH_FRAME_SIZE );
+	xZeroCopyReplyQueue = xQueueCreateZeroCopy( 1, BENCH_FRAME_SIZE );
+	configASSERT( xZeroCopyRequestQueue );
+	configASSERT( xZeroCopyReplyQueue );
+#endif
+#if( configUSE_SPSC_RINGS == 1 )
+	xRequestRing = xSPSCRingCreate( 1, sizeof( uint32_t ) );
+	xReplyRing = xSPSCRingCreate( 1, sizeof( uint32_t ) );
+	configASSERT( xRequestRing );
+	configASSERT( xReplyRing );
+#endif
+#if( configUSE_TICK_HOOK == 1 )
+	xBenchEventGroup = xEventGroupCreate();
+	configASSERT( xBenchEventGroup );
+#endif
+#if( configUSE_SPIN_LOCKS == 1 )
+	xBenchSpinLock = xSpinLockCreate();
+	configASSERT( xBenchSpinLock );
+#endif
+#if( configUSE_RCU == 1 )
+	xBenchRcu = xRcuCreate( pvPortMalloc( sizeof( uint32_t ) ) );
+	configASSERT( xBenchRcu );
+#endif
+
+	printf( "BENCH_FIELDS,name,samples,min,avg,max,p50,p90,p99\r\n" );
+
+	for( x = 0; x < sizeof( xBenches ) / sizeof( xBenches[ 0 ] ); x++ )
+	{
+		pxBench = &xBenches[ x ];
+		uxSampleCount = 0;
+		xPARTNERtask = NULL;
+
+		/* Both tasks run below CTRLtask, so neither starts until CTRLtask
+		blocks on the notification. */
+		if( pxBench->pxPartnerTask != NULL ) {
+			xTaskCreate( pxBench->pxPartnerTask, "PARTNERtask", BENCH_STACK_SIZE,
+						( void * ) pxBench, pxBench->uxPartnerPriority, &xPARTNERtask );
+			configASSERT( xPARTNERtask );
+		}
+		xTaskCreate( pxBench->pxMeasureTask, "MEASUREtask", BENCH_STACK_SIZE,
+					( void * ) pxBench, BENCH_PRIORITY, &xMEASUREtask );
+		configASSERT( xMEASUREtask );
+
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		vTaskDelete( xMEASUREtask );
+		if( xPARTNERtask != NULL ) {
+			vTaskDelete( xPARTNERtask );
+		}
+		/* A zero copy queue cannot be reset, but the benchmark returns all
+		its slots before finishing. */
+		xQueueReset( xRequestQueue );
+		xQueueReset( xReplyQueue );
+		xQueueReset( xFrameRequestQueue );
+		xQueueReset( xFrameReplyQueue );
+		prvReport( pxBench->pcName );
+		if( pxBench->pxMeasureTask == prvSwitchDCacheMeasure ) {
+			prvReportDCache( pxBench->pcName );
+		}
+#if( configUSE_MUTEX_METRICS == 1 )
+		if( pxBench->pxMeasureTask == prvMutexMeasure ) {
+			prvReportMutex( pxBench->pcName );
+		}
+#endif
+		if( pxBench->pxMeasureTask == prvHeapMallocMeasure ) {
+			prvReportHeap( pxBench->pcName );
+		}
+#if( configUSE_OBJECT_POOLS == 1 )
+		if( pxBench->pxMeasureTask == prvTaskChurnMeasure ) {
+			prvReportPools( pxBench->pcName );
+		}
+#endif
+
+		/* let the idle task free the deleted tasks before the next benchmark */
+		vTaskDelay( xCleanupTicks );
+	}
+
+	printf( "BENCH_END\r\n" );
+	vTaskSuspend( NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSwitchMeasure( void *pvParameters )
+{
+	const Bench_t *pxBench = ( const Bench_t * ) pvParameters;
+	uint32_t ulIteration, ulStart;
+
+	if( pxBench->eMeasureFPU != eFPUNever ) {
+		portTASK_USES_FLOATING_POINT();
+	}
+
+	/* Let PARTNERtask run once so both tasks are in their loops. */
+	taskYIELD();
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		prvBenchWork( pxBench->eMeasureFPU, ulIteration );
+		taskYIELD();
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSwitchPartner( void *pvParameters )
+{
+	const Bench_t *pxBench = ( const Bench_t * ) pvParameters;
+	uint32_t ulIteration;
+
+	if( pxBench->ePartnerFPU != eFPUNever ) {
+		portTASK_USES_FLOATING_POINT();
+	}
+
+	for( ulIteration = 0; ; ulIteration++ )
+	{
+		prvBenchWork( pxBench->ePartnerFPU, ulIteration );
+		taskYIELD();
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSwitchDCacheMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+	u32 ulEvents[ XPM_CTRCOUNT ];
+
+	ullBenchDCacheRefills = 0;
+	ullBenchDCacheAccesses = 0;
+
+	/* Let PARTNERtask run once so both tasks are in their loops. */
+	taskYIELD();
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		Xil_L1DCacheFlush();
+		/* resets and starts the event counters, but not the cycle counter */
+		Xpm_SetEvents( XPM_CNTRCFG1 );
+		ulStart = portGET_CYCLE_COUNT();
+		taskYIELD();
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		Xpm_GetEventCounters( ulEvents );
+
+		ullBenchDCacheRefills += ulEvents[ BENCH_PMU_DCACHE_REFILL ];
+		ullBenchDCacheAccesses += ulEvents[ BENCH_PMU_DCACHE_ACCESS ];
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvQueueMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart, ulReply;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xQueueSend( xRequestQueue, &ulIteration, portMAX_DELAY );
+		xQueueReceive( xReplyQueue, &ulReply, portMAX_DELAY );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ulReply == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvQueuePartner( void *pvParameters )
+{
+	uint32_t ulRequest;
+
+	for( ;; )
+	{
+		xQueueReceive( xRequestQueue, &ulRequest, portMAX_DELAY );
+		xQueueSend( xReplyQueue, &ulRequest, portMAX_DELAY );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvFrameMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		ulMeasureFrame[ 0 ] = ulIteration;
+		xQueueSend( xFrameRequestQueue, ulMeasureFrame, portMAX_DELAY );
+		xQueueReceive( xFrameReplyQueue, ulMeasureFrame, portMAX_DELAY );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ulMeasureFrame[ 0 ] == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvFramePartner( void *pvParameters )
+{
+	for( ;; )
+	{
+		xQueueReceive( xFrameRequestQueue, ulPartnerFrame, portMAX_DELAY );
+		xQueueSend( xFrameReplyQueue, ulPartnerFrame, portMAX_DELAY );
+	}
+}
+
+
+#if( configUSE_ZERO_COPY_QUEUES == 1 )
+/*-----------------------------------------------------------*/
+static void prvZeroCopyMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+	uint32_t *pulFrame;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		pulFrame = pvQueueAcquireSlot( xZeroCopyRequestQueue, portMAX_DELAY );
+		pulFrame[ 0 ] = ulIteration;
+		vQueueCommitSlot( xZeroCopyRequestQueue, pulFrame );
+		pulFrame = pvQueueBorrowSlot( xZeroCopyReplyQueue, portMAX_DELAY );
+		configASSERT( pulFrame[ 0 ] == ulIteration );
+		vQueueReleaseSlot( xZeroCopyReplyQueue, pulFrame );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvZeroCopyPartner( void *pvParameters )
+{
+	uint32_t *pulRequest, *pulReply;
+
+	for( ;; )
+	{
+		pulRequest = pvQueueBorrowSlot( xZeroCopyRequestQueue, portMAX_DELAY );
+		pulReply = pvQueueAcquireSlot( xZeroCopyReplyQueue, portMAX_DELAY );
+		pulReply[ 0 ] = pulRequest[ 0 ];
+		vQueueReleaseSlot( xZeroCopyRequestQueue, pulRequest );
+		vQueueCommitSlot( xZeroCopyReplyQueue, pulReply );
+	}
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+/* the length of the queue and ring of the send-receive benchmarks */
+#define	SEND_RECEIVE_LENGTH		4
+
+static void prvQueueSendReceiveMeasure( void *pvParameters )
+{
+	const Bench_t *pxBench = ( const Bench_t * ) pvParameters;
+	QueueHandle_t xQueue;
+	uint32_t ulIteration, ulStart;
+
+	xQueue = xQueueCreate( SEND_RECEIVE_LENGTH, pxBench->uxItemSize );
+	configASSERT( xQueue );
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulMeasureFrame[ 0 ] = ulIteration;
+		ulStart = portGET_CYCLE_COUNT();
+		xQueueSend( xQueue, ulMeasureFrame, 0 );
+		xQueueReceive( xQueue, ulPartnerFrame, 0 );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ulPartnerFrame[ 0 ] == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	vQueueDelete( xQueue );
+	prvBenchDone();
+}
+
+
+#if( configUSE_SPSC_RINGS == 1 )
+/*-----------------------------------------------------------*/
+static void prvRingSendReceiveMeasure( void *pvParameters )
+{
+	const Bench_t *pxBench = ( const Bench_t * ) pvParameters;
+	SPSCRingHandle_t xRing;
+	uint32_t ulIteration, ulStart;
+
+	xRing = xSPSCRingCreate( SEND_RECEIVE_LENGTH, pxBench->uxItemSize );
+	configASSERT( xRing );
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulMeasureFrame[ 0 ] = ulIteration;
+		ulStart = portGET_CYCLE_COUNT();
+		xSPSCRingSend( xRing, ulMeasureFrame, 0 );
+		xSPSCRingReceive( xRing, ulPartnerFrame, 0 );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ulPartnerFrame[ 0 ] == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	vSPSCRingDelete( xRing );
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRingMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart, ulReply;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xSPSCRingSend( xRequestRing, &ulIteration, portMAX_DELAY );
+		xSPSCRingReceive( xReplyRing, &ulReply, portMAX_DELAY );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ulReply == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRingPartner( void *pvParameters )
+{
+	uint32_t ulIteration, ulRequest;
+
+	/* Answer exactly BENCH_ITERATIONS requests.  A ring remembers the task
+	waiting on it, so the partner must not be deleted while it waits. */
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		xSPSCRingReceive( xRequestRing, &ulRequest, portMAX_DELAY );
+		xSPSCRingSend( xReplyRing, &ulRequest, portMAX_DELAY );
+	}
+
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+static void prvBurstMeasure( void *pvParameters )
+{
+	QueueHandle_t xQueue;
+	uint32_t ulIteration, ulStart, ulItem;
+
+	xQueue = xQueueCreate( BENCH_BURST_QUEUE_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		for( ulItem = 0; ulItem < BENCH_BURST_SIZE; ulItem++ ) {
+			ulMeasureFrame[ ulItem ] = ulIteration + ulItem;
+		}
+
+		ulStart = portGET_CYCLE_COUNT();
+		for( ulItem = 0; ulItem < BENCH_BURST_SIZE; ulItem++ ) {
+			xQueueSend( xQueue, &ulMeasureFrame[ ulItem ], 0 );
+		}
+		for( ulItem = 0; ulItem < BENCH_BURST_SIZE; ulItem++ ) {
+			xQueueReceive( xQueue, &ulPartnerFrame[ ulItem ], 0 );
+		}
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( ulPartnerFrame[ BENCH_BURST_SIZE - 1 ] == ulIteration + BENCH_BURST_SIZE - 1 );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	vQueueDelete( xQueue );
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvMultipleMeasure( void *pvParameters )
+{
+	QueueHandle_t xQueue;
+	uint32_t ulIteration, ulStart, ulItem;
+	UBaseType_t uxSent, uxReceived;
+
+	xQueue = xQueueCreate( BENCH_BURST_QUEUE_LENGTH, sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		for( ulItem = 0; ulItem < BENCH_BURST_SIZE; ulItem++ ) {
+			ulMeasureFrame[ ulItem ] = ulIteration + ulItem;
+		}
+
+		ulStart = portGET_CYCLE_COUNT();
+		uxSent = xQueueSendMultiple( xQueue, ulMeasureFrame, BENCH_BURST_SIZE, 0 );
+		uxReceived = xQueueReceiveMultiple( xQueue, ulPartnerFrame, BENCH_BURST_SIZE, 0 );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( ( uxSent == BENCH_BURST_SIZE ) && ( uxReceived == BENCH_BURST_SIZE ) );
+		for( ulItem = 0; ulItem < BENCH_BURST_SIZE; ulItem++ ) {
+			configASSERT( ulPartnerFrame[ ulItem ] == ulIteration + ulItem );
+		}
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	vQueueDelete( xQueue );
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+/* the queue set of the qset_ benchmarks and its members */
+static QueueSetHandle_t xBenchQueueSet;
+static QueueHandle_t xBenchSetMembers[ BENCH_SET_MEMBERS ];
+
+static void prvQueueSetCreate( void )
+{
+	uint32_t ulMember;
+
+	xBenchQueueSet = xQueueCreateSet( BENCH_SET_MEMBERS );
+	configASSERT( xBenchQueueSet );
+
+	for( ulMember = 0; ulMember < BENCH_SET_MEMBERS; ulMember++ ) {
+		xBenchSetMembers[ ulMember ] = xQueueCreate( 1, sizeof( uint32_t ) );
+		configASSERT( xBenchSetMembers[ ulMember ] );
+		xQueueAddToSet( xBenchSetMembers[ ulMember ], xBenchQueueSet );
+	}
+}
+
+static void prvQueueSetDelete( void )
+{
+	uint32_t ulMember;
+
+	for( ulMember = 0; ulMember < BENCH_SET_MEMBERS; ulMember++ ) {
+		xQueueRemoveFromSet( xBenchSetMembers[ ulMember ], xBenchQueueSet );
+		vQueueDelete( xBenchSetMembers[ ulMember ] );
+	}
+	vQueueDelete( xBenchQueueSet );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvQueueSetMeasure( void *pvParameters )
+{
+	QueueSetMemberHandle_t xMember;
+	uint32_t ulIteration, ulStart, ulItem;
+
+	prvQueueSetCreate();
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xQueueSend( xBenchSetMembers[ ulIteration % BENCH_SET_MEMBERS ], &ulIteration, 0 );
+		xMember = xQueueSelectFromSet( xBenchQueueSet, 0 );
+		xQueueReceive( ( QueueHandle_t ) xMember, &ulItem, 0 );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( ulItem == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvQueueSetDelete();
+	prvBenchDone();
+}
+
+
+#if( configUSE_QUEUE_SET_BITMAP == 1 )
+/*-----------------------------------------------------------*/
+static void prvQueueSetManyMeasure( void *pvParameters )
+{
+	QueueSetMemberHandle_t xMembers[ BENCH_SET_MEMBERS ];
+	uint32_t ulIteration, ulStart, ulMember, ulItem;
+	UBaseType_t uxSelected, uxIndex;
+
+	prvQueueSetCreate();
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		for( ulMember = 0; ulMember < BENCH_SET_MEMBERS; ulMember++ ) {
+			xQueueSend( xBenchSetMembers[ ulMember ], &ulIteration, 0 );
+		}
+		uxSelected = uxQueueSelectManyFromSet( xBenchQueueSet, xMembers, BENCH_SET_MEMBERS, 0 );
+		for( uxIndex = 0; uxIndex < uxSelected; uxIndex++ ) {
+			xQueueReceive( ( QueueHandle_t ) xMembers[ uxIndex ], &ulItem, 0 );
+		}
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( uxSelected == BENCH_SET_MEMBERS );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvQueueSetDelete();
+	prvBenchDone();
+}
+#endif /* configUSE_QUEUE_SET_BITMAP */
+
+
+/*-----------------------------------------------------------*/
+#if( configSTREAM_BUFFER == 1 )
+/* the capacity of the stream buffers of the stream benchmarks */
+#define	STREAM_SIZE				( ( 3 * BENCH_FRAME_SIZE ) + 256 )
+
+static void prvStreamCopyMeasure( void *pvParameters )
+{
+	StreamBufferHandle_t xStream;
+	uint32_t ulIteration, ulStart;
+
+	xStream = xStreamBufferCreateDMA( STREAM_SIZE, BENCH_FRAME_SIZE );
+	configASSERT( xStream );
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulMeasureFrame[ 0 ] = ulIteration;
+		ulStart = portGET_CYCLE_COUNT();
+		xStreamBufferSend( xStream, ulMeasureFrame, BENCH_FRAME_SIZE, 0 );
+		xStreamBufferReceive( xStream, ulPartnerFrame, BENCH_FRAME_SIZE, 0 );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ulPartnerFrame[ 0 ] == ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	vStreamBufferDelete( xStream );
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvStreamSpansMeasure( void *pvParameters )
+{
+	StreamBufferHandle_t xStream;
+	StreamBufferSpans_t xSpans;
+	uint32_t ulIteration, ulStart, ulCheck;
+	uint8_t *pucSpan;
+	size_t xLength, xWritten;
+
+	xStream = xStreamBufferCreateDMA( STREAM_SIZE, BENCH_FRAME_SIZE );
+	configASSERT( xStream );
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+
+		/* The frame is written in up to two pieces, as a DMA engine would. */
+		for( xWritten = 0; xWritten < BENCH_FRAME_SIZE; xWritten += xLength )
+		{
+			xLength = xStreamBufferGetWriteSpan( xStream, &pucSpan );
+			xLength = ( xLength < ( BENCH_FRAME_SIZE - xWritten ) ) ? xLength : ( BENCH_FRAME_SIZE - xWritten );
+			configASSERT( xLength > 0 );
+			pucSpan[ 0 ] = ( uint8_t ) ( ulIteration + xWritten );
+			xStreamBufferCommitWrite( xStream, xLength );
+		}
+
+		xStreamBufferReceiveSpans( xStream, &xSpans, 0 );
+		ulCheck = xSpans.pucSpan[ 0 ][ 0 ];
+		vStreamBufferReleaseSpans( xStream, xSpans.xSpanLengthBytes[ 0 ] + xSpans.xSpanLengthBytes[ 1 ] );
+
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		configASSERT( ( xSpans.xSpanLengthBytes[ 0 ] + xSpans.xSpanLengthBytes[ 1 ] ) == BENCH_FRAME_SIZE );
+		configASSERT( ulCheck == ( uint8_t ) ulIteration );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	vStreamBufferDelete( xStream );
+	prvBenchDone();
+}
+#endif /* configSTREAM_BUFFER */
+
+
+/*-----------------------------------------------------------*/
+static void prvNotifyMeasure( void *pvParameters )
+{
+	/* PARTNERtask has the higher priority, so it takes the sample before
+	xTaskNotifyGive() returns here. */
+	while( uxSampleCount < BENCH_ITERATIONS )
+	{
+		ulSampleStart = portGET_CYCLE_COUNT();
+		xTaskNotifyGive( xPARTNERtask );
+	}
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvNotifyPartner( void *pvParameters )
+{
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		ulSamples[ uxSampleCount ] = portGET_CYCLE_COUNT() - ulSampleStart;
+		uxSampleCount++;
+	}
+}
+
+
+#if( configUSE_TICK_HOOK == 1 )
+/*-----------------------------------------------------------*/
+static void prvEventMeasure( void *pvParameters )
+{
+	uint32_t ulIteration;
+
+	/* PARTNERtask ran first and is already waiting. */
+	xEventGroupClearBits( xBenchEventGroup, BENCH_EVENT_BIT );
+	xBenchEventArmed = pdTRUE;
+
+	for( ulIteration = 0; ulIteration < BENCH_TICK_ITERATIONS; ulIteration++ )
+	{
+		xEventGroupWaitBits( xBenchEventGroup, BENCH_EVENT_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulSampleStart;
+	}
+	xBenchEventArmed = pdFALSE;
+	uxSampleCount = BENCH_TICK_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvEventPartner( void *pvParameters )
+{
+	/* Never unblocked, as BENCH_EVENT_UNSET_BIT is never set; it is only
+	there to be passed over by each set of BENCH_EVENT_BIT. */
+	for( ;; )
+	{
+		xEventGroupWaitBits( xBenchEventGroup, BENCH_EVENT_BIT | BENCH_EVENT_UNSET_BIT,
+							pdFALSE, pdTRUE, portMAX_DELAY );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+void vApplicationTickHook( void )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( xBenchEventArmed != pdFALSE ) {
+		ulSampleStart = portGET_CYCLE_COUNT();
+		xEventGroupSetBitsFromISR( xBenchEventGroup, BENCH_EVENT_BIT, &xHigherPriorityTaskWoken );
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+	}
+}
+#endif /* configUSE_TICK_HOOK */
+
+
+/*-----------------------------------------------------------*/
+static void prvMutexMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		/* PARTNERtask takes the mutex and wakes this task while holding it. */
+		xTaskNotifyGive( xPARTNERtask );
+		xSemaphoreTake( xBenchSemaphore, portMAX_DELAY );
+
+		ulStart = portGET_CYCLE_COUNT();
+		xSemaphoreTake( xBenchMutex, portMAX_DELAY );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		xSemaphoreGive( xBenchMutex );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvMutexPartner( void *pvParameters )
+{
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xSemaphoreTake( xBenchMutex, portMAX_DELAY );
+		/* MEASUREtask preempts here, blocks on the mutex and lends this task
+		its priority until the give below. */
+		xSemaphoreGive( xBenchSemaphore );
+		xSemaphoreGive( xBenchMutex );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvMutexTakeGiveMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xSemaphoreTake( xBenchMutex, portMAX_DELAY );
+		xSemaphoreGive( xBenchMutex );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+#if( configUSE_SPIN_LOCKS == 1 )
+/*-----------------------------------------------------------*/
+static void prvSpinTakeGiveMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xSpinLockTake( xBenchSpinLock, portMAX_DELAY );
+		vSpinLockGive( xBenchSpinLock );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSpinMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		/* PARTNERtask takes the lock and wakes this task while holding it. */
+		xTaskNotifyGive( xPARTNERtask );
+		xSemaphoreTake( xBenchSemaphore, portMAX_DELAY );
+
+		ulStart = portGET_CYCLE_COUNT();
+		xSpinLockTake( xBenchSpinLock, portMAX_DELAY );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+		vSpinLockGive( xBenchSpinLock );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSpinPartner( void *pvParameters )
+{
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xSpinLockTake( xBenchSpinLock, portMAX_DELAY );
+		/* MEASUREtask preempts here and blocks on the lock until the give
+		below. */
+		xSemaphoreGive( xBenchSemaphore );
+		vSpinLockGive( xBenchSpinLock );
+	}
+}
+#endif /* configUSE_SPIN_LOCKS */
+
+
+#if( configUSE_RCU == 1 )
+/*-----------------------------------------------------------*/
+static void prvRcuReadMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+	volatile uint32_t ulValue;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		ulValue = *( const uint32_t * ) pvRcuReadLock( xBenchRcu );
+		vRcuReadUnlock();
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	( void ) ulValue;
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRcuPublishMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+	uint32_t *pulValue;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		pulValue = pvRcuCopy( xBenchRcu, sizeof( uint32_t ) );
+		configASSERT( pulValue );
+		*pulValue = ulIteration;
+		vRcuPublish( xBenchRcu, pulValue );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+#endif /* configUSE_RCU */
+
+
+/*-----------------------------------------------------------*/
+/* the next number of a xorshift sequence, the same on every run */
+static uint32_t prvBenchRandom( uint32_t *pulState )
+{
+	uint32_t ulState = *pulState;
+
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	*pulState = ulState;
+
+	return ulState;
+}
+
+/* Allocates or frees one of BENCH_HEAP_SLOTS blocks at random until
+BENCH_ITERATIONS calls of the kind measured have been timed. */
+static void prvHeapWorkload( BaseType_t xMeasureFree )
+{
+	void *pvSlots[ BENCH_HEAP_SLOTS ] = { NULL };
+	uint32_t ulState = BENCH_HEAP_SEED;
+	uint32_t ulRandom, ulStart, ulCycles;
+	size_t uxSlot, uxCount = 0;
+
+	while( uxCount < BENCH_ITERATIONS )
+	{
+		ulRandom = prvBenchRandom( &ulState );
+		uxSlot = ulRandom % BENCH_HEAP_SLOTS;
+
+		if( pvSlots[ uxSlot ] == NULL ) {
+			ulStart = portGET_CYCLE_COUNT();
+			pvSlots[ uxSlot ] = pvPortMalloc( 1 + ( ( ulRandom >> 8 ) % BENCH_HEAP_MAX_SIZE ) );
+			ulCycles = portGET_CYCLE_COUNT() - ulStart;
+			configASSERT( pvSlots[ uxSlot ] );
+			if( xMeasureFree == pdFALSE ) {
+				ulSamples[ uxCount++ ] = ulCycles;
+			}
+		}
+		else {
+			ulStart = portGET_CYCLE_COUNT();
+			vPortFree( pvSlots[ uxSlot ] );
+			ulCycles = portGET_CYCLE_COUNT() - ulStart;
+			pvSlots[ uxSlot ] = NULL;
+			if( xMeasureFree != pdFALSE ) {
+				ulSamples[ uxCount++ ] = ulCycles;
+			}
+		}
+	}
+	uxSampleCount = uxCount;
+
+	vPortGetHeapStats( &xBenchHeapStats );
+	for( uxSlot = 0; uxSlot < BENCH_HEAP_SLOTS; uxSlot++ ) {
+		vPortFree( pvSlots[ uxSlot ] );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvHeapMallocMeasure( void *pvParameters )
+{
+	prvHeapWorkload( pdFALSE );
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvHeapFreeMeasure( void *pvParameters )
+{
+	prvHeapWorkload( pdTRUE );
+	prvBenchDone();
+}
+
+
+#if( configUSE_TLSF_HEAP == 1 )
+/*-----------------------------------------------------------*/
+/* Allocates and frees a cache line aligned frame buffer from ePlacement. */
+static void prvHeapPlacedWorkload( HeapPlacement_t ePlacement )
+{
+	uint32_t ulIteration, ulStart;
+	void *pvBuffer;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		pvBuffer = pvPortMallocPlaced( BENCH_FRAME_SIZE, ePlacement, portCACHE_LINE_SIZE );
+		vPortFree( pvBuffer );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( pvBuffer );
+		configASSERT( ( ( size_t ) pvBuffer & ( portCACHE_LINE_SIZE - 1 ) ) == 0 );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+}
+
+static void prvHeapBulkMeasure( void *pvParameters )
+{
+	prvHeapPlacedWorkload( eHeapBulk );
+	prvBenchDone();
+}
+
+#if( configTOTAL_DMA_HEAP_SIZE > 0 )
+static void prvHeapDMAMeasure( void *pvParameters )
+{
+	prvHeapPlacedWorkload( eHeapDMA );
+	prvBenchDone();
+}
+#endif
+#endif /* configUSE_TLSF_HEAP */
+
+
+/*-----------------------------------------------------------*/
+/* the task created by task_churn, deleted before it runs */
+static void prvChurnTask( void *pvParameters )
+{
+	for( ;; );
+}
+
+static void prvTaskChurnMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+	TaskHandle_t xTask;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xTaskCreate( prvChurnTask, "CHURNtask", configMINIMAL_STACK_SIZE, NULL,
+					tskIDLE_PRIORITY, &xTask );
+		vTaskDelete( xTask );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( xTask );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvQueueChurnMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+	QueueHandle_t xQueue;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+		vQueueDelete( xQueue );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+
+		configASSERT( xQueue );
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSemaphoreMeasure( void *pvParameters )
+{
+	uint32_t ulIteration, ulStart;
+
+	for( ulIteration = 0; ulIteration < BENCH_ITERATIONS; ulIteration++ )
+	{
+		ulStart = portGET_CYCLE_COUNT();
+		xSemaphoreGive( xBenchSemaphore );
+		xSemaphoreTake( xBenchSemaphore, 0 );
+		ulSamples[ ulIteration ] = portGET_CYCLE_COUNT() - ulStart;
+	}
+	uxSampleCount = BENCH_ITERATIONS;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvTickMeasure( void *pvParameters )
+{
+	uint32_t ulLast, ulNow;
+	size_t uxCount = 0;
+
+	/* Nothing else is ready at this priority, so any long gap between two
+	reads of the cycle counter is an interrupt, and the only interrupt
+	enabled is the tick. */
+	ulLast = portGET_CYCLE_COUNT();
+	while( uxCount < BENCH_TICK_ITERATIONS )
+	{
+		ulNow = portGET_CYCLE_COUNT();
+		if( ( ulNow - ulLast ) > BENCH_TICK_THRESHOLD ) {
+			ulSamples[ uxCount ] = ulNow - ulLast;
+			uxCount++;
+		}
+		ulLast = ulNow;
+	}
+	uxSampleCount = uxCount;
+
+	prvBenchDone();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvBenchWork( FPUUse_t eUse, uint32_t ulIteration )
+{
+	if( ( eUse == eFPUAlways ) ||
+		( ( eUse == eFPUOccasional ) && ( ( ulIteration % BENCH_FPU_PERIOD ) == 0 ) ) ) {
+		fFloatWork = ( fFloatWork * 0.5f ) + 1.0f;
+	}
+	else {
+		ulIntWork = ( ulIntWork >> 1 ) + 1;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvBenchDone( void )
+{
+	/* CTRLtask preempts this task and deletes it. */
+	xTaskNotifyGive( xCTRLtask );
+	vTaskSuspend( NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvCompareSamples( const void *pvA, const void *pvB )
+{
+	const uint32_t ulA = *( const uint32_t * ) pvA;
+	const uint32_t ulB = *( const uint32_t * ) pvB;
+
+	return ( ulA > ulB ) - ( ulA < ulB );
+}
+
+
+/*-----------------------------------------------------------*/
+/* the sample below which uxPercent percent of the sorted samples lie */
+#define	PERCENTILE( uxCount, uxPercent )	ulSamples[ ( ( ( uxCount ) - 1 ) * ( uxPercent ) ) / 100 ]
+
+static void prvReport( const char *pcName )
+{
+	const size_t uxCount = uxSampleCount;
+	uint64_t ullTotal = 0;
+	size_t x;
+
+	if( uxCount == 0 ) {
+		printf( "BENCH_ERROR,%s took no samples\r\n", pcName );
+		return;
+	}
+
+	qsort( ulSamples, uxCount, sizeof( ulSamples[ 0 ] ), prvCompareSamples );
+	for( x = 0; x < uxCount; x++ )
+	{
+		ullTotal += ulSamples[ x ];
+	}
+
+	printf( "BENCH,%s,%u,%u,%u,%u,%u,%u,%u\r\n",
+			pcName,
+			( unsigned int ) uxCount,
+			( unsigned int ) ulSamples[ 0 ],
+			( unsigned int ) ( ullTotal / uxCount ),
+			( unsigned int ) ulSamples[ uxCount - 1 ],
+			( unsigned int ) PERCENTILE( uxCount, 50 ),
+			( unsigned int ) PERCENTILE( uxCount, 90 ),
+			( unsigned int ) PERCENTILE( uxCount, 99 ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvReportDCache( const char *pcName )
+{
+	/* each sample is a round trip, i.e. two switches */
+	const uint32_t ulSwitches = ( uint32_t ) uxSampleCount * 2UL;
+
+	if( ulSwitches == 0 ) {
+		return;
+	}
+
+	printf( "BENCH_DCACHE,%s,%u,%u,%u,%u\r\n",
+			pcName,
+			( unsigned int ) ulSwitches,
+			( unsigned int ) ullBenchDCacheRefills,
+			( unsigned int ) ullBenchDCacheAccesses,
+			( unsigned int ) ( ( ullBenchDCacheRefills * 100 ) / ulSwitches ) );
+}
+
+
+#if( configUSE_MUTEX_METRICS == 1 )
+/*-----------------------------------------------------------*/
+static void prvReportMutex( const char *pcName )
+{
+	MutexMetrics_t xMetrics;
+
+	vSemaphoreGetMutexMetrics( xBenchMutex, &xMetrics );
+	printf( "BENCH_MUTEX,%s,%u,%u,%u,%u\r\n",
+			pcName,
+			( unsigned int ) xMetrics.ulAcquisitions,
+			( unsigned int ) xMetrics.ulContendedAcquisitions,
+			( unsigned int ) xMetrics.ulMaxHoldCycles,
+			( unsigned int ) xMetrics.ulMaxWaitCycles );
+}
+#endif /* configUSE_MUTEX_METRICS */
+
+
+/*-----------------------------------------------------------*/
+static void prvReportHeap( const char *pcName )
+{
+	const size_t uxFree = xBenchHeapStats.xAvailableHeapSpaceInBytes;
+	const size_t uxLargest = xBenchHeapStats.xSizeOfLargestFreeBlockInBytes;
+
+	printf( "BENCH_HEAP,%s,%s,%u,%u,%u,%u\r\n",
+			pcName,
+#if( configUSE_TLSF_HEAP == 1 )
+			"heap_tlsf",
+#else
+			"heap_4",
+#endif
+			( unsigned int ) uxFree,
+			( unsigned int ) uxLargest,
+			( unsigned int ) xBenchHeapStats.xNumberOfFreeBlocks,
+			( unsigned int ) ( ( uxFree == 0 ) ? 0 : ( 100 - ( ( uxLargest * 100 ) / uxFree ) ) ) );
+}
+
+
+#if( configUSE_OBJECT_POOLS == 1 )
+/*-----------------------------------------------------------*/
+static void prvReportPools( const char *pcName )
+{
+	ObjectPoolStats_t xStats;
+	UBaseType_t uxPool;
+
+	for( uxPool = 0; uxPool < uxObjectPoolGetCount(); uxPool++ )
+	{
+		vObjectPoolGetStats( uxPool, &xStats );
+		printf( "BENCH_POOL,%s,%u,%u,%u,%u,%u\r\n",
+				pcName,
+				( unsigned int ) xStats.xBlockSize,
+				( unsigned int ) xStats.uxBlockCount,
+				( unsigned int ) xStats.uxMinimumEverBlocksFree,
+				( unsigned int ) xStats.ulAllocations,
+				( unsigned int ) xStats.ulFallbacks );
+	}
+}
+#endif /* configUSE_OBJECT_POOLS */
@@ -31,7 +31,7 @@
  *
  * Created on: 	10 November 2020 (based on rtos_task_management.c)
  *     Author: 	Leomar Duran
- *    Version: 	2.3
+ *    Version: 	2.6
  */
 
 /*
@@ -45,6 +45,18 @@
 /********************************************************************************************
 * VERSION HISTORY
 ********************************************************************************************
+* 	v2.6 - 18 October 2026
+* 		Created the tasks and the timer in statically allocated memory when
+* 		configSUPPORT_STATIC_ALLOCATION is 1, so startup takes them off the heap.
+*
+* 	v2.5 - 18 October 2026
+* 		Started the stack profiler, which samples every task and processor
+* 		mode stack in the background.
+*
+* 	v2.4 - 18 October 2026
+* 		Shared the timer periods with BTNtask through an RCU snapshot, or a
+* 		plain pointer when configUSE_RCU is 0.
+*
 * 	v2.3 - 10 November 2020
 * 		Implemented BTNtask.
 * 		Renamed vTIMERtask -> vTIMERtaskCallback to avoid confusion.
@@ -94,6 +106,8 @@
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "rcu.h"
+#include "stack_profile.h"
 /* Xilinx includes. */
 #include "xil_printf.h"
 #define	printf	xil_printf
@@ -118,6 +132,13 @@
 #define	TIMER_TASK_CHECK_THRESHOLD	9
 #define	TIMER_DELAY_INIT	5000UL					/* initial LED delay length (in ms) */
 #define	TIMER_DELAY_BTN1	10000UL					/* LED delay length on BTN1 (in ms) */
+#define	STACK_PROFILE_PERIOD	1000UL				/* stack profiler sample period (in ms) */
+
+/* the timer periods, read by BTNtask through xTIMERconfig */
+typedef struct {
+	TickType_t xTicksInit;							/* initial LED delay length (in ticks) */
+	TickType_t xTicksBtn1;							/* LED delay length on BTN1 (in ticks) */
+} TIMERconfig_t;
 
 /* GPIO instances */
 XGpio LdBtnInst;					/* GPIO Device driver instance for LEDs, Buttons */
@@ -142,12 +163,33 @@ XGpio SwInst;						/* GPIO Device driver instance for switches */
 static void prvBTNtask( void *pvParameters );
 static void prvSWtask ( void *pvParameters );
 static void vTIMERtaskCallback( TimerHandle_t pxTimer );
+static void prvReadTIMERconfig( TIMERconfig_t *pxTIMERconfig );
 /*-----------------------------------------------------------*/
 
 /* The task handles to control other tasks. */
 static TaskHandle_t xBTNtask;
 static TaskHandle_t xSWtask;
 static TimerHandle_t xTIMERtask = NULL;
+#if( configUSE_RCU == 1 )
+/* The published timer periods, see TIMERconfig_t. */
+static RcuHandle_t xTIMERconfig = NULL;
+#else
+/* The timer periods, which never change without RCU. */
+static const TIMERconfig_t *pxTIMERconfigFixed = NULL;
+#endif
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/* The memory of the tasks and the timer, sized at compile time. */
+static StaticTask_t xBTNtaskTCB portFAST_BSS;
+static StackType_t uxBTNtaskStack[ configMINIMAL_STACK_SIZE ] portFAST_BSS;
+static StaticTask_t xSWtaskTCB portFAST_BSS;
+static StackType_t uxSWtaskStack[ configMINIMAL_STACK_SIZE ] portFAST_BSS;
+static StaticTimer_t xTIMERtaskBuffer portFAST_BSS;
+/* The first timer periods and their RCU handle, never freed by RCU. */
+static TIMERconfig_t xTIMERconfigInit portFAST_BSS;
+#if( configUSE_RCU == 1 )
+static StaticRcu_t xTIMERconfigBuffer portFAST_BSS;
+#endif
+#endif
 long RxtaskCntr = 0;
 /* The LED blinker. */
 int ledBlnkr = LED_INIT;
@@ -156,10 +198,41 @@ int main( void )
 {
 	int Status;
 	const TickType_t xTIMERticks = pdMS_TO_TICKS( TIMER_DELAY_INIT );
+	TIMERconfig_t *pxTIMERconfig;
+
+	/* publish the timer periods before any task can read them */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	pxTIMERconfig = &xTIMERconfigInit;
+#else
+	pxTIMERconfig = pvPortMalloc( sizeof( TIMERconfig_t ) );
+	configASSERT( pxTIMERconfig );
+#endif
+	pxTIMERconfig->xTicksInit = xTIMERticks;
+	pxTIMERconfig->xTicksBtn1 = pdMS_TO_TICKS( TIMER_DELAY_BTN1 );
+#if( configUSE_RCU == 1 )
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xTIMERconfig = xRcuCreateStatic( pxTIMERconfig, &xTIMERconfigBuffer );
+#else
+	xTIMERconfig = xRcuCreate( pxTIMERconfig );
+#endif
+	configASSERT( xTIMERconfig );
+#else
+	pxTIMERconfigFixed = pxTIMERconfig;
+#endif
 
 	if (DO_BTN_TASK) {
 		printf( "Starting BTNtask. . .\r\n" );
 		/* Create BTNtask with priority 1. */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		xBTNtask = xTaskCreateStatic(
+					prvBTNtask,						/* The function implementing the task. */
+				( const char * ) "BTNtask",			/* Text name provided for debugging. */
+					configMINIMAL_STACK_SIZE,		/* Not much need for a stack. */
+					NULL,							/* The task parameter, not in use. */
+					( UBaseType_t ) 1,				/* The next to lowest priority. */
+					uxBTNtaskStack,					/* The stack, sized above. */
+					&xBTNtaskTCB );					/* The task control block. */
+#else
 		xTaskCreate(
 					prvBTNtask,						/* The function implementing the task. */
 				( const char * ) "BTNtask",			/* Text name provided for debugging. */
@@ -167,12 +240,23 @@ int main( void )
 					NULL,							/* The task parameter, not in use. */
 					( UBaseType_t ) 1,				/* The next to lowest priority. */
 					&xBTNtask );
+#endif
 		printf( "\tSuccessful\r\n" );
 	}
 
 	if (DO_SW_TASK) {
 		printf( "Starting SWtask . . .\r\n" );
 		/* Create SWtask with priority 1. */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		xSWtask = xTaskCreateStatic(
+					prvSWtask,						/* The function implementing the task. */
+				( const char * ) "SWtask",			/* Text name provided for debugging. */
+					configMINIMAL_STACK_SIZE,		/* Not much need for a stack. */
+					NULL,							/* The task parameter, not in use. */
+					( UBaseType_t ) 1,				/* The next to lowest priority. */
+					uxSWtaskStack,					/* The stack, sized above. */
+					&xSWtaskTCB );					/* The task control block. */
+#else
 		xTaskCreate(
 					prvSWtask,						/* The function implementing the task. */
 				( const char * ) "SWtask",			/* Text name provided for debugging. */
@@ -180,6 +264,7 @@ int main( void )
 					NULL,							/* The task parameter, not in use. */
 					( UBaseType_t ) 1,				/* The next to lowest priority. */
 					&xSWtask );
+#endif
 		printf( "\tSuccessful\r\n" );
 	}
 
@@ -191,11 +276,20 @@ int main( void )
 		 The tasks are deleted in the timer call back and a message is printed to convey that
 		 the example has run successfully.
 		 The timer expiry is set to 10 seconds and the timer set to not auto reload. */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		xTIMERtask = xTimerCreateStatic( (const char *) "TIMERtask",
+								xTIMERticks,
+								pdTRUE,				/* this is a multiple shot timer */
+								(void *) TIMER_TASK_ID,
+								vTIMERtaskCallback,
+								&xTIMERtaskBuffer);
+#else
 		xTIMERtask = xTimerCreate( (const char *) "TIMERtask",
 								xTIMERticks,
 								pdTRUE,				/* this is a multiple shot timer */
 								(void *) TIMER_TASK_ID,
 								vTIMERtaskCallback);
+#endif
 		/* Check the timer was created. */
 		configASSERT( xTIMERtask );
 
@@ -224,6 +318,12 @@ int main( void )
 	/* set switches to input direction to input */
 	XGpio_SetDataDirection(SW_DEV_CH, 0xFF);
 
+#if( configUSE_STACK_PROFILER == 1 )
+	/* sample the stacks in the background, before any interrupt is enabled,
+	   see stack_profile.h for reading the report */
+	xStackProfileStart( pdMS_TO_TICKS( STACK_PROFILE_PERIOD ) );
+#endif
+
 	/* Start the tasks and timer running. */
 	vTaskStartScheduler();
 
@@ -247,6 +347,18 @@ void printb(char* format, int i) {
 			);
 }
 
+/*-----------------------------------------------------------*/
+/* copies the current timer periods into pxTIMERconfig */
+static void prvReadTIMERconfig( TIMERconfig_t *pxTIMERconfig )
+{
+#if( configUSE_RCU == 1 )
+	*pxTIMERconfig = *( const TIMERconfig_t * ) pvRcuReadLock( xTIMERconfig );
+	vRcuReadUnlock();
+#else
+	*pxTIMERconfig = *pxTIMERconfigFixed;
+#endif
+}
+
 /*-----------------------------------------------------------*/
 static void vTIMERtaskCallback( TimerHandle_t pxTimer )
 {
@@ -277,8 +389,8 @@ static void vTIMERtaskCallback( TimerHandle_t pxTimer )
 static void prvBTNtask( void *pvParameters )
 {
 	const TickType_t BTNseconds = pdMS_TO_TICKS( BTN_DELAY );
-	const TickType_t xTIMERticksInit = pdMS_TO_TICKS( TIMER_DELAY_INIT );
-	const TickType_t xTIMERticksBtn1 = pdMS_TO_TICKS( TIMER_DELAY_BTN1 );
+	TIMERconfig_t xTIMERconfigCopy;
+	TickType_t xTIMERticks;
 
 	int btn[2];	/* Hold the button values, 0 : current, 1 : previous. */
 
@@ -311,8 +423,11 @@ static void prvBTNtask( void *pvParameters )
 		/* BTN1 sets the TIMERtask to 10 seconds */
 		if ((btn[0] & BTN1) == BTN1) {
 			printf("BTNtask : TIMERtask <- 10 seconds\r\n");
+			/* take the period from the current snapshot of the config */
+			prvReadTIMERconfig( &xTIMERconfigCopy );
+			xTIMERticks = xTIMERconfigCopy.xTicksBtn1;
 			xTimerChangePeriod(	xTIMERtask,
-								xTIMERticksBtn1,
+								xTIMERticks,
 								0
 					);
 		}
@@ -325,8 +440,10 @@ static void prvBTNtask( void *pvParameters )
 		/* BTN3 starts the TIMERtask, and sets the reinitializes the LEDs */
 		if ((btn[0] & BTN3) == BTN3) {
 			printf("BTNtask : TIMERtask and LEDs are reinitialized.\r\n");
+			prvReadTIMERconfig( &xTIMERconfigCopy );
+			xTIMERticks = xTIMERconfigCopy.xTicksInit;
 			xTimerChangePeriod(	xTIMERtask,
-								xTIMERticksInit,
+								xTIMERticks,
 								0
 					);
 			XGpio_DiscreteWrite( LED_DEV_CH, LED_INIT );
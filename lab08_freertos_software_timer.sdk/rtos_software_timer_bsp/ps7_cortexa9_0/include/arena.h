@@ -0,0 +1,191 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include arena.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Arena allocators.
+ *
+ * When configUSE_ARENAS is set to 1 in FreeRTOSConfig.h a task that allocates
+ * many short lived buffers while it processes one piece of work, and frees
+ * them all once the work is done, can take them from an arena instead of the
+ * heap.  An arena is one block of memory, taken from the FreeRTOS heap or
+ * provided by the application, that is handed out from the bottom up:
+ * allocating is rounding a pointer up to the required alignment and moving it
+ * past the buffer, without searching a free list and without suspending the
+ * scheduler.  Buffers are not freed one by one.  vArenaReset() frees every
+ * buffer in the arena at once by moving the pointer back to the bottom.
+ *
+ * As allocating and resetting take no lock an arena must only be used by one
+ * task at a time, normally the task that created it, and never from an
+ * interrupt.  Different tasks use different arenas.
+ *
+ * An allocation that does not fit in the space left returns NULL, and is
+ * counted in the arena's statistics along with the largest request that
+ * failed, so an arena that is too small can be found and sized from its
+ * high water mark.  When configARENA_OVERRUN_CHECK is set to 1 each buffer is
+ * also followed by guard bytes, which vArenaReset() and xArenaCheck() verify
+ * to catch a buffer written past its end.
+ */
+
+struct ArenaDefinition;
+typedef struct ArenaDefinition * ArenaHandle_t;
+
+/* The statistics of an arena, returned by vArenaGetStats(). */
+typedef struct xARENA_STATS
+{
+	size_t xSizeBytes;					/* The number of bytes the arena can hand out. */
+	size_t xUsedBytes;					/* The number of bytes in use at the time of the call, including alignment padding and guard bytes. */
+	size_t xHighWaterBytes;				/* The highest xUsedBytes since the arena was created. */
+	size_t xLargestFailedBytes;			/* The largest request that did not fit, zero if none has failed. */
+	uint32_t ulAllocations;				/* The number of buffers allocated since the arena was created. */
+	uint32_t ulFailedAllocations;		/* The number of requests that did not fit. */
+	uint32_t ulResets;					/* The number of calls to vArenaReset(). */
+} ArenaStats_t;
+
+/**
+ * arena.h
+ * <pre>ArenaHandle_t xArenaCreate( size_t xSizeBytes );</pre>
+ *
+ * Creates an arena that can hand out xSizeBytes bytes, allocated from the
+ * FreeRTOS heap along with the arena structure.  The alignment padding, and
+ * when configARENA_OVERRUN_CHECK is 1 the guard bytes, of each buffer are
+ * taken from the same xSizeBytes.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 for xArenaCreate() to be
+ * available.
+ *
+ * @return The handle of the arena, or NULL if it could not be allocated.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	ArenaHandle_t xArenaCreate( size_t xSizeBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ * <pre>ArenaHandle_t xArenaCreateStatic( size_t xSizeBytes, uint8_t *pucArenaStorage, StaticArena_t *pxStaticArena );</pre>
+ *
+ * Creates an arena that hands out the xSizeBytes bytes of pucArenaStorage,
+ * with pxStaticArena holding the arena structure.  Neither is written to by
+ * anything else while the arena exists.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 for xArenaCreateStatic()
+ * to be available.
+ *
+ * @return The handle of the arena, or NULL if pucArenaStorage or pxStaticArena
+ * is NULL.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	ArenaHandle_t xArenaCreateStatic( size_t xSizeBytes, uint8_t *pucArenaStorage, StaticArena_t *pxStaticArena ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ * <pre>void vArenaDelete( ArenaHandle_t xArena );</pre>
+ *
+ * Deletes an arena, freeing its memory if it was created by xArenaCreate().
+ * The buffers allocated from the arena must no longer be used.
+ */
+void vArenaDelete( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * <pre>void *pvArenaAlloc( ArenaHandle_t xArena, size_t xSize );</pre>
+ *
+ * Allocates xSize bytes, aligned to portBYTE_ALIGNMENT, from an arena.
+ *
+ * @return The buffer, or NULL if the space left in the arena cannot hold it.
+ */
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * <pre>void *pvArenaAllocAligned( ArenaHandle_t xArena, size_t xSize, size_t xAlignment );</pre>
+ *
+ * Allocates xSize bytes aligned to xAlignment, a power of two, from an arena.
+ * Alignments below portBYTE_ALIGNMENT are raised to it.  The padding needed to
+ * reach a larger alignment is lost until the arena is reset.
+ *
+ * @return The buffer, or NULL if the space left in the arena cannot hold it.
+ */
+void *pvArenaAllocAligned( ArenaHandle_t xArena, size_t xSize, size_t xAlignment ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * <pre>void vArenaReset( ArenaHandle_t xArena );</pre>
+ *
+ * Frees every buffer allocated from an arena, which must no longer be used.
+ * When configARENA_OVERRUN_CHECK is 1 the guard bytes of the buffers are
+ * verified first, and configASSERT() is called if one was overwritten.
+ */
+void vArenaReset( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * <pre>size_t xArenaGetFreeSize( ArenaHandle_t xArena );</pre>
+ *
+ * @return The number of bytes left in an arena.  A buffer of that size fits
+ * if no alignment padding or guard bytes are needed.
+ */
+size_t xArenaGetFreeSize( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * <pre>void vArenaGetStats( ArenaHandle_t xArena, ArenaStats_t *pxStats );</pre>
+ *
+ * Fills pxStats with the statistics of an arena.  Can be called by a task
+ * other than the one using the arena, in which case the values are a snapshot
+ * that can be out of date as soon as they are returned.
+ */
+void vArenaGetStats( ArenaHandle_t xArena, ArenaStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ * <pre>BaseType_t xArenaCheck( ArenaHandle_t xArena );</pre>
+ *
+ * Verifies the guard bytes that follow every buffer allocated from an arena
+ * since it was last reset.  Always passes if configARENA_OVERRUN_CHECK is 0.
+ *
+ * @return pdPASS if no buffer was written past its end, otherwise pdFAIL.
+ */
+BaseType_t xArenaCheck( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
@@ -0,0 +1,175 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef CRITICAL_PROFILE_H
+#define CRITICAL_PROFILE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include critical_profile.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Critical section profiling.
+ *
+ * When configUSE_CRITICAL_SECTION_PROFILING is set to 1 in FreeRTOSConfig.h
+ * the port timestamps, using the Cortex-A9 PMU cycle counter, every point at
+ * which interrupts are masked (taskENTER_CRITICAL(), portDISABLE_INTERRUPTS()
+ * and portSET_INTERRUPT_MASK_FROM_ISR()) and unmasked again, and the kernel
+ * does the same each time the scheduler is suspended with vTaskSuspendAll()
+ * and resumed with xTaskResumeAll().  For each call site (the return address
+ * of the function that opened the section) the number of sections, the
+ * longest section and the total time spent in sections is recorded, and a
+ * histogram of section durations is kept for each kind of section.
+ *
+ * The longest interrupt masked section bounds the worst case latency seen by
+ * interrupts that have a priority at or below
+ * configMAX_API_CALL_INTERRUPT_PRIORITY.
+ *
+ * A section that is open when a task yields from within a critical section is
+ * closed when the task is switched out, as the task being switched in restores
+ * its own interrupt mask.
+ */
+
+/* The kinds of section that are profiled. */
+typedef enum
+{
+	eCriticalProfileInterruptMask = 0,	/* Interrupts at or below configMAX_API_CALL_INTERRUPT_PRIORITY are masked. */
+	eCriticalProfileSchedulerSuspended,	/* The scheduler is suspended, but interrupts are not masked. */
+	eCriticalProfileNumKinds
+} eCriticalProfileKind;
+
+/* The histogram has one bucket per power of two cycles.  Bucket n counts the
+sections that lasted from 2^n up to (2^(n+1))-1 cycles, with sections of zero
+cycles counted in bucket 0. */
+#define criticalprofileHISTOGRAM_BUCKETS	32
+
+/* Used with uxCriticalProfileGetSites() to obtain the statistics recorded for
+each call site. */
+typedef struct xCRITICAL_PROFILE_SITE
+{
+	void *pvCallSite;				/* The return address of the function that opened the section.  NULL collects the sections that did not fit in the call site table. */
+	eCriticalProfileKind eKind;		/* The kind of section opened at pvCallSite. */
+	uint32_t ulCount;				/* The number of sections opened at pvCallSite. */
+	uint32_t ulMaxCycles;			/* The duration of the longest section opened at pvCallSite. */
+	uint64_t ullTotalCycles;		/* The summed duration of all the sections opened at pvCallSite. */
+} CriticalProfileSite_t;
+
+/**
+ * critical_profile.h
+ * <pre>void vCriticalProfileReset( void );</pre>
+ *
+ * Clears all the recorded call sites and histograms.  Sections that are open
+ * at the time of the call are still recorded when they close.
+ */
+void vCriticalProfileReset( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * critical_profile.h
+ * <pre>UBaseType_t uxCriticalProfileGetSites( CriticalProfileSite_t *pxSiteArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * Copies the statistics recorded for each call site into pxSiteArray.
+ *
+ * @param pxSiteArray An array into which the statistics are written.
+ *
+ * @param uxArraySize The number of entries in pxSiteArray.  At most
+ * configCRITICAL_PROFILE_MAX_SITES entries are ever written.
+ *
+ * @return The number of entries written to pxSiteArray.
+ */
+UBaseType_t uxCriticalProfileGetSites( CriticalProfileSite_t *pxSiteArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * critical_profile.h
+ * <pre>void vCriticalProfileGetHistogram( eCriticalProfileKind eKind, uint32_t *pulBuckets );</pre>
+ *
+ * Copies the duration histogram recorded for sections of kind eKind into
+ * pulBuckets, which must have room for criticalprofileHISTOGRAM_BUCKETS
+ * entries.
+ */
+void vCriticalProfileGetHistogram( eCriticalProfileKind eKind, uint32_t *pulBuckets ) PRIVILEGED_FUNCTION;
+
+/**
+ * critical_profile.h
+ * <pre>uint32_t ulCriticalProfileGetMaxCycles( eCriticalProfileKind eKind );</pre>
+ *
+ * @return The duration, in cycles, of the longest section of kind eKind
+ * recorded since the last call to vCriticalProfileReset().
+ */
+uint32_t ulCriticalProfileGetMaxCycles( eCriticalProfileKind eKind ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+	/**
+	 * critical_profile.h
+	 * <pre>void vCriticalProfileList( char *pcWriteBuffer );</pre>
+	 *
+	 * Writes a human readable table of the recorded call sites, followed by
+	 * the non-zero histogram buckets, into pcWriteBuffer.  Each call site
+	 * needs approximately 50 bytes, and each histogram bucket approximately 20
+	 * bytes.
+	 *
+	 * As with vTaskList(), this function is provided for convenience only, has
+	 * a dependency on sprintf(), and production systems should call
+	 * uxCriticalProfileGetSites() directly.
+	 */
+	void vCriticalProfileList( char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------
+ * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+ *----------------------------------------------------------*/
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  They are called by
+ * the port layer and the scheduler, through the macros below, with interrupts
+ * masked or the scheduler suspended.
+ */
+void vCriticalProfileSectionStart( eCriticalProfileKind eKind, void *pvCallSite ) PRIVILEGED_FUNCTION;
+void vCriticalProfileSetCallSite( eCriticalProfileKind eKind, void *pvCallSite ) PRIVILEGED_FUNCTION;
+void vCriticalProfileSectionEnd( eCriticalProfileKind eKind ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+	#define criticalprofileSECTION_START( eKind, pvCallSite )	vCriticalProfileSectionStart( ( eKind ), ( pvCallSite ) )
+	#define criticalprofileSET_CALL_SITE( eKind, pvCallSite )	vCriticalProfileSetCallSite( ( eKind ), ( pvCallSite ) )
+	#define criticalprofileSECTION_END( eKind )					vCriticalProfileSectionEnd( ( eKind ) )
+#else
+	#define criticalprofileSECTION_START( eKind, pvCallSite )
+	#define criticalprofileSET_CALL_SITE( eKind, pvCallSite )
+	#define criticalprofileSECTION_END( eKind )
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRITICAL_PROFILE_H */
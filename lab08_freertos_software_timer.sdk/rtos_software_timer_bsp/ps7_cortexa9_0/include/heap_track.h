@@ -0,0 +1,209 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef HEAP_TRACK_H
+#define HEAP_TRACK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include heap_track.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Heap allocation tracking.
+ *
+ * When configUSE_HEAP_TRACKING is set to 1 in FreeRTOSConfig.h every block
+ * handed out by pvPortMalloc() (and pvPortMallocPlaced() when heap_tlsf.c is
+ * used) is entered into a side table together with the return address of the
+ * function that allocated it, the number of heap bytes it occupies, and the
+ * task that was running when it was allocated.  Blocks allocated by the kernel's
+ * create functions and by the newlib malloc() bridge are charged to the caller
+ * of the create function or of malloc(), rather than to the function that
+ * called pvPortMalloc().  The entry is removed again by
+ * vPortFree().  The blocks that are still live can then be grouped by call
+ * site with uxHeapTrackGetSites(), which makes a slow leak show up as a call
+ * site whose live bytes keep growing.
+ *
+ * The number of allocations made by each task is also counted over periods of
+ * configHEAP_TRACKING_RATE_PERIOD ticks, and a histogram of the per period
+ * counts is kept for each task.
+ *
+ * The side table is an open addressed hash table of
+ * configHEAP_TRACKING_MAX_BLOCKS entries, each four words, so recording an
+ * allocation or a free costs a hash and, usually, a single probe.  Blocks
+ * allocated while the table is full are not tracked, and are counted by
+ * ulHeapTrackGetUntracked().
+ *
+ * The recorded size is the size of the block taken from the heap, including
+ * the block header and any rounding, so the live bytes of all the call sites
+ * add up to the heap space in use.
+ *
+ * task.h must be included before this file.
+ */
+
+/* The rate histogram has one bucket per power of two allocations.  Bucket 0
+counts the periods in which the task made no allocations, bucket n the periods
+in which it made from 2^(n-1) up to (2^n)-1 allocations, with the last bucket
+also counting all the busier periods. */
+#define heaptrackRATE_BUCKETS	12
+
+/* Used with uxHeapTrackGetSites() to obtain the live blocks allocated at each
+call site. */
+typedef struct xHEAP_TRACK_SITE
+{
+	void *pvCallSite;				/* The return address of the pvPortMalloc() call, or of the call to the create function or malloc() that made it. */
+	UBaseType_t uxLiveBlocks;		/* The number of blocks allocated at pvCallSite that have not been freed. */
+	size_t xLiveBytes;				/* The heap bytes occupied by those blocks. */
+} HeapTrackSite_t;
+
+/* Used with uxHeapTrackGetTasks() to obtain the allocations made by each
+task. */
+typedef struct xHEAP_TRACK_TASK
+{
+	TaskHandle_t xTask;									/* The task.  NULL collects the allocations made before the scheduler was started, and by tasks that did not fit in the task table. */
+	uint32_t ulAllocations;								/* The number of allocations made by the task. */
+	UBaseType_t uxLiveBlocks;							/* The number of blocks allocated by the task that have not been freed. */
+	size_t xLiveBytes;									/* The heap bytes occupied by those blocks. */
+	uint32_t ulRateHistogram[ heaptrackRATE_BUCKETS ];	/* The number of allocations made in each completed period, binned as described above. */
+} HeapTrackTask_t;
+
+/**
+ * heap_track.h
+ * <pre>UBaseType_t uxHeapTrackGetSites( HeapTrackSite_t *pxSiteArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * Groups the live blocks by the call site that allocated them, and writes one
+ * entry per call site into pxSiteArray, sorted so the call site holding the
+ * most bytes comes first.
+ *
+ * @param pxSiteArray An array into which the call sites are written.
+ *
+ * @param uxArraySize The number of entries in pxSiteArray.  The last entry is
+ * reserved: if the call sites do not all fit in the entries before it, it is
+ * written with a pvCallSite of NULL, collects the blocks of the call sites that
+ * did not fit, and is left at the end rather than sorted.
+ *
+ * @return The number of entries written to pxSiteArray.
+ */
+UBaseType_t uxHeapTrackGetSites( HeapTrackSite_t *pxSiteArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_track.h
+ * <pre>UBaseType_t uxHeapTrackGetTasks( HeapTrackTask_t *pxTaskArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * Writes the allocation statistics of each task that has allocated from the
+ * heap into pxTaskArray.  The periods that ended since the task last allocated
+ * are added to its histogram first.
+ *
+ * @param pxTaskArray An array into which the statistics are written.
+ *
+ * @param uxArraySize The number of entries in pxTaskArray.  At most
+ * configHEAP_TRACKING_MAX_TASKS + 1 entries are ever written.
+ *
+ * @return The number of entries written to pxTaskArray.
+ */
+UBaseType_t uxHeapTrackGetTasks( HeapTrackTask_t *pxTaskArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_track.h
+ * <pre>uint32_t ulHeapTrackGetUntracked( void );</pre>
+ *
+ * @return The number of allocations that were not entered into the side table
+ * because it was full.  If this is not zero configHEAP_TRACKING_MAX_BLOCKS
+ * should be increased, as the live bytes reported by uxHeapTrackGetSites() are
+ * then incomplete.
+ */
+uint32_t ulHeapTrackGetUntracked( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_track.h
+ * <pre>void vHeapTrackResetRates( void );</pre>
+ *
+ * Clears the allocation counts and histograms of all the tasks.  The live
+ * blocks are not affected.
+ */
+void vHeapTrackResetRates( void ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+	/**
+	 * heap_track.h
+	 * <pre>void vHeapTrackList( char *pcWriteBuffer );</pre>
+	 *
+	 * Writes a human readable table of the call sites holding live blocks,
+	 * followed by a line per task giving its allocation count, live bytes and
+	 * rate histogram, into pcWriteBuffer.  Each call site needs approximately
+	 * 30 bytes, and each task approximately 120 bytes.
+	 *
+	 * As with vTaskList(), this function is provided for convenience only, has
+	 * a dependency on sprintf(), and production systems should call
+	 * uxHeapTrackGetSites() and uxHeapTrackGetTasks() directly.
+	 */
+	void vHeapTrackList( char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------
+ * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+ *----------------------------------------------------------*/
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  They are called by
+ * the heap implementations and the scheduler, through the macros below, with
+ * the scheduler suspended.  The exception is
+ * vHeapTrackSetCallSite(), which suspends the scheduler itself.  It is called
+ * by the functions that allocate on behalf of their caller, such as
+ * xTaskCreate() and malloc(), to charge the block they have just allocated to
+ * that caller.
+ */
+void vHeapTrackMalloc( void *pv, size_t xBlockSize, void *pvCallSite ) PRIVILEGED_FUNCTION;
+void vHeapTrackFree( void *pv ) PRIVILEGED_FUNCTION;
+void vHeapTrackSetCallSite( void *pv, void *pvCallSite ) PRIVILEGED_FUNCTION;
+void vHeapTrackTaskDeleted( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_HEAP_TRACKING == 1 )
+	#define heaptrackCALL_SITE()							__builtin_return_address( 0 )
+	#define heaptrackMALLOC( pv, xBlockSize, pvCallSite )	vHeapTrackMalloc( ( pv ), ( xBlockSize ), ( pvCallSite ) )
+	#define heaptrackFREE( pv )								vHeapTrackFree( ( pv ) )
+	#define heaptrackSET_CALL_SITE( pv, pvCallSite )		vHeapTrackSetCallSite( ( pv ), ( pvCallSite ) )
+	#define heaptrackTASK_DELETE( xTask )					vHeapTrackTaskDeleted( ( xTask ) )
+#else
+	#define heaptrackCALL_SITE()							NULL
+	#define heaptrackMALLOC( pv, xBlockSize, pvCallSite )
+	#define heaptrackFREE( pv )
+	#define heaptrackSET_CALL_SITE( pv, pvCallSite )
+	#define heaptrackTASK_DELETE( xTask )
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_TRACK_H */
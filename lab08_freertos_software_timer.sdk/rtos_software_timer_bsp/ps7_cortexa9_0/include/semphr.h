@@ -1135,6 +1135,28 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define uxSemaphoreGetCount( xSemaphore ) uxQueueMessagesWaiting( ( QueueHandle_t ) ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>void vSemaphoreGetMutexMetrics( SemaphoreHandle_t xMutex, MutexMetrics_t *pxMetrics );</pre>
+ *
+ * Only available when configUSE_MUTEX_METRICS is set to 1 in FreeRTOSConfig.h.
+ *
+ * Copies the contention statistics of a mutex or recursive mutex into
+ * *pxMetrics: the number of times it has been taken, how many of those takes
+ * had to wait for another task to give it, and the longest time, in CPU
+ * cycles, it has been held and that a task has waited to take it.  See
+ * MutexMetrics_t in queue.h.
+ *
+ * @param xMutex The mutex to query.  Must not be a binary or counting
+ * semaphore.
+ *
+ * @param pxMetrics The structure into which the statistics are copied.
+ *
+ * \defgroup vSemaphoreGetMutexMetrics vSemaphoreGetMutexMetrics
+ * \ingroup Semaphores
+ */
+#define vSemaphoreGetMutexMetrics( xSemaphore, pxMetrics ) vQueueGetMutexMetrics( ( QueueHandle_t ) ( xSemaphore ), ( pxMetrics ) )
+
 #endif /* SEMAPHORE_H */
 
 
@@ -0,0 +1,118 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+#ifndef SPIN_LOCK_H
+#define SPIN_LOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include spin_lock.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Spin then block locks.
+ *
+ * When configUSE_SPIN_LOCKS is set to 1 in FreeRTOSConfig.h a spin lock can
+ * be used in place of a mutex to guard a short region of code.  A lock that
+ * is free is taken and given with one exclusive load and store each, without
+ * a critical section or a context switch.
+ *
+ * A task that finds the lock held by a task of another core spins, waiting
+ * for the event the holder sends when it gives the lock, for up to
+ * configSPIN_LOCK_SPIN_COUNT attempts.  A task that finds the lock held by a
+ * task of its own core does not spin, as the holder cannot run until the
+ * waiting task blocks.  Once it stops spinning a task records itself in the
+ * lock and blocks on its direct to task notification at index
+ * configSPIN_LOCK_NOTIFY_INDEX, which the holder gives as it gives the lock.
+ * Blocked tasks are woken in priority order.  A notification can be left
+ * pending at that index after the wait, so it must not be used for any other
+ * purpose, including by the stream buffers and SPSC rings, which is why
+ * configSPIN_LOCK_NOTIFY_INDEX should be kept apart from index 0 and from
+ * configSPSC_RING_NOTIFY_INDEX.
+ *
+ * Unlike a mutex, a spin lock has no priority inheritance and no holder task,
+ * and is not recursive.  Spin locks must not be used from an interrupt.
+ *
+ * NOTE:  The lock word, the exclusive monitors and the events work across
+ * cores, but blocking relies on the scheduler of the core that gives the lock
+ * waking the blocked task, so tasks of only one core may block on a lock.
+ */
+
+struct SpinLockDefinition;
+typedef struct SpinLockDefinition * SpinLockHandle_t;
+
+/**
+ * spin_lock.h
+ * <pre>SpinLockHandle_t xSpinLockCreate( void );</pre>
+ *
+ * Creates a spin lock that is not held.
+ *
+ * @return The handle of the lock, or NULL if it could not be allocated.
+ */
+SpinLockHandle_t xSpinLockCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * spin_lock.h
+ * <pre>void vSpinLockDelete( SpinLockHandle_t xLock );</pre>
+ *
+ * Frees a spin lock.  The lock must not be held.
+ */
+void vSpinLockDelete( SpinLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * spin_lock.h
+ * <pre>BaseType_t xSpinLockTake( SpinLockHandle_t xLock, TickType_t xTicksToWait );</pre>
+ *
+ * Takes a spin lock.  If the lock is held, spins as described above and then
+ * waits up to xTicksToWait ticks for it to be given.  With an xTicksToWait of
+ * zero the call only spins.
+ *
+ * @return pdPASS if the lock was taken, otherwise pdFAIL.
+ */
+BaseType_t xSpinLockTake( SpinLockHandle_t xLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spin_lock.h
+ * <pre>void vSpinLockGive( SpinLockHandle_t xLock );</pre>
+ *
+ * Gives a spin lock taken by xSpinLockTake(), waking the highest priority task
+ * that is blocked on it, if any.  Must be called by a task of the core that
+ * took the lock.
+ */
+void vSpinLockGive( SpinLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPIN_LOCK_H */
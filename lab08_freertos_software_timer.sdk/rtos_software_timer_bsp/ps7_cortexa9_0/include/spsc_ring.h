@@ -0,0 +1,159 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include spsc_ring.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Single producer, single consumer rings.
+ *
+ * When configUSE_SPSC_RINGS is set to 1 in FreeRTOSConfig.h a ring can be
+ * used in place of a queue that has exactly one sending task or interrupt and
+ * exactly one receiving task or interrupt.  Each side only writes its own
+ * index, so items are passed without a critical section, without masking
+ * interrupts and without touching an event list: a send or receive that does
+ * not have to wait copies the item and publishes the new index behind a data
+ * memory barrier.
+ *
+ * A task only blocks when the ring is full (sending) or empty (receiving).  It
+ * then records its handle in the ring and waits on its direct to task
+ * notification at index configSPSC_RING_NOTIFY_INDEX, which the other side
+ * gives once it has published an item or a free slot.  A notification can be
+ * left pending at that index after the wait, so tasks that block on a ring
+ * must not use that index for any other purpose.  The default is the last
+ * index, so with configTASK_NOTIFICATION_ARRAY_ENTRIES above 1 it is not the
+ * one the kernel, stream buffers and the notification functions without an
+ * index use.  Functions that end in "FromISR" never block, but can unblock a
+ * waiting task.
+ *
+ * NOTE:  Having exactly one sender and one receiver is not checked.  Two
+ * senders or two receivers corrupt the ring.
+ */
+
+struct SPSCRingDefinition;
+typedef struct SPSCRingDefinition * SPSCRingHandle_t;
+
+/**
+ * spsc_ring.h
+ * <pre>SPSCRingHandle_t xSPSCRingCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );</pre>
+ *
+ * Creates a ring that holds up to uxLength items of uxItemSize bytes each.
+ *
+ * @param uxLength The number of items the ring can hold.  Must be a power of
+ * two, so the indexes can wrap with a mask.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return The handle of the ring, or NULL if it could not be allocated.
+ */
+SPSCRingHandle_t xSPSCRingCreate( UBaseType_t uxLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ * <pre>void vSPSCRingDelete( SPSCRingHandle_t xRing );</pre>
+ *
+ * Frees a ring.  Neither side may be blocked on the ring.
+ */
+void vSPSCRingDelete( SPSCRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ * <pre>BaseType_t xSPSCRingSend( SPSCRingHandle_t xRing, const void *pvItem, TickType_t xTicksToWait );</pre>
+ *
+ * Copies an item into a ring, waiting up to xTicksToWait ticks for a free
+ * slot if the ring is full.  Must only be called by the producer task.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ */
+BaseType_t xSPSCRingSend( SPSCRingHandle_t xRing, const void *pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ * <pre>BaseType_t xSPSCRingSendFromISR( SPSCRingHandle_t xRing, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xSPSCRingSend() that can be called by a producer interrupt.
+ * It does not mask interrupts.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a consumer task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ */
+BaseType_t xSPSCRingSendFromISR( SPSCRingHandle_t xRing, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ * <pre>BaseType_t xSPSCRingReceive( SPSCRingHandle_t xRing, void *pvItem, TickType_t xTicksToWait );</pre>
+ *
+ * Copies the oldest item out of a ring, waiting up to xTicksToWait ticks for
+ * an item if the ring is empty.  Must only be called by the consumer task.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ */
+BaseType_t xSPSCRingReceive( SPSCRingHandle_t xRing, void *pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ * <pre>BaseType_t xSPSCRingReceiveFromISR( SPSCRingHandle_t xRing, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken );</pre>
+ *
+ * A version of xSPSCRingReceive() that can be called by a consumer interrupt.
+ * It does not mask interrupts.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item
+ * unblocked a producer task that has a priority above the interrupted task.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ */
+BaseType_t xSPSCRingReceiveFromISR( SPSCRingHandle_t xRing, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ * <pre>UBaseType_t uxSPSCRingItemsWaiting( SPSCRingHandle_t xRing );</pre>
+ *
+ * @return The number of items in the ring.  The value can be out of date as
+ * soon as it is returned, unless called by the consumer when the ring is not
+ * empty, or by the producer when the ring is not full.
+ */
+UBaseType_t uxSPSCRingItemsWaiting( SPSCRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSC_RING_H */
@@ -0,0 +1,174 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+/* This header is included from FreeRTOSConfig.h, so the trace macros it
+defines take the place of the empty defaults in FreeRTOS.h.  It must therefore
+not depend on any FreeRTOS type. */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Scheduler trace recorder.
+ *
+ * When configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h the trace
+ * macros of the kernel record, from boot, a compact binary event for every
+ * task creation, deletion, switch in, move to the Ready state, block, suspend
+ * and priority change, every tick, and every queue send and receive.  Events
+ * are timestamped with the cycle counter and kept in a RAM buffer of
+ * configTRACE_RECORDER_BUFFER_EVENTS events.  Recording stops when the buffer
+ * is full, so the buffer always holds the start of the run that a replay
+ * needs; vTraceRecorderStart() empties it and records again.
+ *
+ * vTraceRecorderDump() prints the buffer in a text form that the trace_replay
+ * tool of the host simulation build reads.  The tool rebuilds the jobs each
+ * task ran, replays them on the simulated kernel, optionally with different
+ * task priorities, and reports the response times of each task.
+ *
+ * configUSE_TRACE_FACILITY must be 1, as tasks and queues are identified by
+ * their trace numbers.  The recorder numbers tasks 1 to 255, in the order they
+ * are created, with vTaskSetTaskNumber(); queues keep the number given to them
+ * with vQueueSetQueueNumber(), which is 0 by default.
+ */
+
+/* Event codes. */
+#define tracerecorderTASK_CREATE		1	/* Parameter: the priority of the task. */
+#define tracerecorderTASK_DELETE		2
+#define tracerecorderTASK_SWITCHED_IN	3
+#define tracerecorderTASK_READY			4	/* The task was moved to the Ready state. */
+#define tracerecorderTASK_BLOCKED		5	/* The running task is about to block. */
+#define tracerecorderTASK_SUSPENDED		6
+#define tracerecorderTASK_PRIORITY_SET	7	/* Parameter: the new priority, set or inherited. */
+#define tracerecorderTICK				8	/* Parameter: the tick count before the increment. */
+#define tracerecorderQUEUE_SEND			9	/* Parameter: the number of the queue. */
+#define tracerecorderQUEUE_RECEIVE		10	/* Parameter: the number of the queue. */
+
+/* The task number recorded for events raised by an interrupt. */
+#define tracerecorderNO_TASK			0
+
+/* One recorded event. */
+typedef struct xTRACE_RECORDER_EVENT
+{
+	uint32_t ulTimestamp;	/* The cycle counter when the event was recorded. */
+	uint8_t ucEvent;		/* One of the tracerecorder event codes. */
+	uint8_t ucTask;			/* The number of the task the event is about, as returned by uxTaskGetTaskNumber(). */
+	uint16_t usParameter;	/* Depends on ucEvent. */
+} TraceRecorderEvent_t;
+
+/**
+ * trace_recorder.h
+ * <pre>void vTraceRecorderStart( void );</pre>
+ *
+ * Empties the event buffer and starts recording.  The recorder is started at
+ * boot, so this is only needed to record again after the buffer has filled or
+ * vTraceRecorderStop() has been called.
+ */
+void vTraceRecorderStart( void );
+
+/**
+ * trace_recorder.h
+ * <pre>void vTraceRecorderStop( void );</pre>
+ *
+ * Stops recording.  The events already recorded are kept.
+ */
+void vTraceRecorderStop( void );
+
+/**
+ * trace_recorder.h
+ * <pre>uint32_t ulTraceRecorderGetEvents( const TraceRecorderEvent_t **ppxEvents );</pre>
+ *
+ * @param ppxEvents Set to the start of the event buffer.
+ *
+ * @return The number of events in the buffer.
+ */
+uint32_t ulTraceRecorderGetEvents( const TraceRecorderEvent_t **ppxEvents );
+
+/**
+ * trace_recorder.h
+ * <pre>void vTraceRecorderDump( void );</pre>
+ *
+ * Prints the recorded events, and the name and creation priority of each task
+ * they refer to, to the standard output:
+ *
+ *	TRACE_BEGIN,<cycle counter frequency in Hz>,<events>,<events dropped>
+ *	TRACE_TASK,<task number>,<name>,<priority>		(one per task)
+ *	TRACE,<timestamp in hex>,<event>,<task number>,<parameter>	(one per event)
+ *	TRACE_END
+ *
+ * Recording is stopped while the events are printed.  This function is
+ * intended for use once the run of interest is over, as it takes a long time
+ * to print a full buffer.
+ */
+void vTraceRecorderDump( void );
+
+/* Used by the trace macros only. */
+void vTraceRecorderTaskEvent( uint8_t ucEvent, void *pvTask, uint32_t ulParameter );
+void vTraceRecorderCurrentTaskEvent( uint8_t ucEvent, uint32_t ulParameter );
+void vTraceRecorderInterruptEvent( uint8_t ucEvent, uint32_t ulParameter );
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+	#define traceTASK_CREATE( pxNewTCB )							vTraceRecorderTaskEvent( tracerecorderTASK_CREATE, ( void * ) ( pxNewTCB ), ( uint32_t ) ( pxNewTCB )->uxPriority )
+	#define traceTASK_DELETE( pxTCB )								vTraceRecorderTaskEvent( tracerecorderTASK_DELETE, ( void * ) ( pxTCB ), 0 )
+	#define traceTASK_SWITCHED_IN()									vTraceRecorderCurrentTaskEvent( tracerecorderTASK_SWITCHED_IN, 0 )
+	#define traceMOVED_TASK_TO_READY_STATE( pxTCB )					vTraceRecorderTaskEvent( tracerecorderTASK_READY, ( void * ) ( pxTCB ), 0 )
+	#define traceTASK_SUSPEND( pxTCB )								vTraceRecorderTaskEvent( tracerecorderTASK_SUSPENDED, ( void * ) ( pxTCB ), 0 )
+	#define traceTASK_PRIORITY_SET( pxTCB, uxNewPriority )			vTraceRecorderTaskEvent( tracerecorderTASK_PRIORITY_SET, ( void * ) ( pxTCB ), ( uint32_t ) ( uxNewPriority ) )
+	#define traceTASK_PRIORITY_INHERIT( pxTCB, uxPriority )			vTraceRecorderTaskEvent( tracerecorderTASK_PRIORITY_SET, ( void * ) ( pxTCB ), ( uint32_t ) ( uxPriority ) )
+	#define traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriority )		vTraceRecorderTaskEvent( tracerecorderTASK_PRIORITY_SET, ( void * ) ( pxTCB ), ( uint32_t ) ( uxPriority ) )
+	#define traceTASK_INCREMENT_TICK( xTickCount )					vTraceRecorderInterruptEvent( tracerecorderTICK, ( uint32_t ) ( xTickCount ) )
+
+	/* Every way in which the running task can block. */
+	#define traceTASK_DELAY()										vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceTASK_DELAY_UNTIL( xTimeToWake )					vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )					vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )				vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )					vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceTASK_NOTIFY_TAKE_BLOCK()							vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceTASK_NOTIFY_WAIT_BLOCK()							vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )	vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )			vTraceRecorderCurrentTaskEvent( tracerecorderTASK_BLOCKED, 0 )
+
+	#define traceQUEUE_SEND( pxQueue )								vTraceRecorderCurrentTaskEvent( tracerecorderQUEUE_SEND, ( uint32_t ) ( pxQueue )->uxQueueNumber )
+	#define traceQUEUE_RECEIVE( pxQueue )							vTraceRecorderCurrentTaskEvent( tracerecorderQUEUE_RECEIVE, ( uint32_t ) ( pxQueue )->uxQueueNumber )
+	#define traceQUEUE_SEND_FROM_ISR( pxQueue )						vTraceRecorderInterruptEvent( tracerecorderQUEUE_SEND, ( uint32_t ) ( pxQueue )->uxQueueNumber )
+	#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )					vTraceRecorderInterruptEvent( tracerecorderQUEUE_RECEIVE, ( uint32_t ) ( pxQueue )->uxQueueNumber )
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
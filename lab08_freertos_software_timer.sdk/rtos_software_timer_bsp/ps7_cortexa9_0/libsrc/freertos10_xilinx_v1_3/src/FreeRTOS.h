@@ -288,6 +288,59 @@ extern "C" {
 	#define portPOINTER_SIZE_TYPE uint32_t
 #endif
 
+#ifndef portCACHE_LINE_SIZE
+	/* Storage that is shared with a DMA engine is aligned to, and sized in
+	multiples of, this many bytes so cache maintenance on it cannot touch any
+	other data. */
+	#define portCACHE_LINE_SIZE portBYTE_ALIGNMENT
+#endif
+
+#ifndef portCONTROL_BLOCK_ALIGNMENT
+	/* The alignment of the TCBs and queues, which a port can raise to the
+	cache line size so the members used together by a context switch or a
+	send or receive share as few lines as possible.  When it is above
+	portBYTE_ALIGNMENT, portCONTROL_BLOCK_ALIGNED must apply it. */
+	#define portCONTROL_BLOCK_ALIGNMENT portBYTE_ALIGNMENT
+#endif
+
+#ifndef portCONTROL_BLOCK_ALIGNED
+	#define portCONTROL_BLOCK_ALIGNED
+#endif
+
+#ifndef portFAST_DATA
+	/* Placed on the kernel data that every tick and context switch touches, so
+	a port can link it into faster memory than the rest of the application. */
+	#define portFAST_DATA
+#endif
+
+#ifndef portFAST_BSS
+	/* As portFAST_DATA, for data with no initialiser, so it need not be loaded
+	with the image. */
+	#define portFAST_BSS
+#endif
+
+#ifndef portFAST_HEAP
+	/* Placed on the ucHeap array the heap allocates from. */
+	#define portFAST_HEAP
+#endif
+
+#ifndef portDMA_HEAP
+	/* Placed on the array the heap's DMA region is allocated from. */
+	#define portDMA_HEAP
+#endif
+
+#ifndef portCONFIGURE_DMA_REGION
+	/* Makes the heap's DMA region safe to share with a DMA engine without
+	cache maintenance, before the first block is allocated from it. */
+	#define portCONFIGURE_DMA_REGION( pvStart, xSize )
+#endif
+
+#ifndef portGET_MODE_STACKS
+	/* Ports that have processor mode stacks outside the task stacks report
+	them to the stack profiler, see stack_profile.h. */
+	#define portGET_MODE_STACKS( pxRegions, uxMaxRegions ) ( ( UBaseType_t ) 0U )
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 	/* Used to perform any necessary initialisation - for example, open a file
@@ -837,6 +890,177 @@ extern "C" {
 	#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
 #endif
 
+#ifndef configUSE_CRITICAL_SECTION_PROFILING
+	#define configUSE_CRITICAL_SECTION_PROFILING 0
+#endif
+
+#ifndef configCRITICAL_PROFILE_MAX_SITES
+	/* The number of distinct call sites for which critical section statistics
+	are recorded when configUSE_CRITICAL_SECTION_PROFILING is 1. */
+	#define configCRITICAL_PROFILE_MAX_SITES 32
+#endif
+
+#ifndef configUSE_HEAP_TRACKING
+	#define configUSE_HEAP_TRACKING 0
+#endif
+
+#ifndef configHEAP_TRACKING_MAX_BLOCKS
+	/* The number of live heap blocks that can be tracked when
+	configUSE_HEAP_TRACKING is 1.  Each block takes four words. */
+	#define configHEAP_TRACKING_MAX_BLOCKS 256
+#endif
+
+#ifndef configHEAP_TRACKING_MAX_TASKS
+	/* The number of tasks whose allocation rates are recorded when
+	configUSE_HEAP_TRACKING is 1. */
+	#define configHEAP_TRACKING_MAX_TASKS 16
+#endif
+
+#ifndef configHEAP_TRACKING_RATE_PERIOD
+	/* The period, in ticks, over which allocations are counted for the
+	allocation rate histograms. */
+	#define configHEAP_TRACKING_RATE_PERIOD configTICK_RATE_HZ
+#endif
+
+#ifndef configUSE_STACK_PROFILER
+	#define configUSE_STACK_PROFILER 0
+#endif
+
+#ifndef configSTACK_PROFILE_MAX_ENTRIES
+	/* The number of stacks profiled when configUSE_STACK_PROFILER is 1, which
+	must be at least the number of tasks plus the number of processor mode
+	stacks. */
+	#define configSTACK_PROFILE_MAX_ENTRIES 24
+#endif
+
+#ifndef configSTACK_PROFILE_MARGIN_PERCENT
+	/* The safety margin the stack profiler adds to the peak use of a stack to
+	give its recommended size. */
+	#define configSTACK_PROFILE_MARGIN_PERCENT 25
+#endif
+
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#ifndef configTRACE_RECORDER_BUFFER_EVENTS
+	/* The number of events held by the trace recorder when
+	configUSE_TRACE_RECORDER is 1.  Each event takes 8 bytes. */
+	#define configTRACE_RECORDER_BUFFER_EVENTS 4096
+#endif
+
+#ifndef configUSE_ZERO_COPY_QUEUES
+	#define configUSE_ZERO_COPY_QUEUES 0
+#endif
+
+#ifndef configUSE_SPSC_RINGS
+	#define configUSE_SPSC_RINGS 0
+#endif
+
+#ifndef configSPSC_RING_NOTIFY_INDEX
+	/* The notification index a task blocked on an SPSC ring waits on.  It is
+	best kept for the rings alone, as the rings leave notifications pending
+	on it. */
+	#define configSPSC_RING_NOTIFY_INDEX ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#ifndef configUSE_EVENT_GROUP_INDEX
+	#define configUSE_EVENT_GROUP_INDEX 0
+#endif
+
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+	#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 0
+#endif
+
+#ifndef configUSE_MUTEX_METRICS
+	#define configUSE_MUTEX_METRICS 0
+#endif
+
+#ifndef configUSE_SPIN_LOCKS
+	#define configUSE_SPIN_LOCKS 0
+#endif
+
+#ifndef configSPIN_LOCK_SPIN_COUNT
+	/* The number of times a task retries a spin lock held by another core
+	before it blocks, when configUSE_SPIN_LOCKS is 1.  Each retry waits for the
+	event sent when the lock is given. */
+	#define configSPIN_LOCK_SPIN_COUNT 100
+#endif
+
+#ifndef configSPIN_LOCK_NOTIFY_INDEX
+	/* The notification index a task blocked on a spin lock waits on.  It is
+	best kept for the spin locks alone, as the locks leave notifications
+	pending on it. */
+	#define configSPIN_LOCK_NOTIFY_INDEX ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#ifndef configUSE_RCU
+	#define configUSE_RCU 0
+#endif
+
+#ifndef configUSE_QUEUE_SET_BITMAP
+	#define configUSE_QUEUE_SET_BITMAP 0
+#endif
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#ifndef configUSE_TLSF_HEAP
+	#define configUSE_TLSF_HEAP 0
+#endif
+
+#ifndef configTOTAL_BULK_HEAP_SIZE
+	#define configTOTAL_BULK_HEAP_SIZE 0
+#endif
+
+#ifndef configTOTAL_DMA_HEAP_SIZE
+	#define configTOTAL_DMA_HEAP_SIZE 0
+#endif
+
+#ifndef configHEAP_MAX_REGIONS
+	#define configHEAP_MAX_REGIONS 3
+#endif
+
+#ifndef configUSE_NEWLIB_MALLOC_BRIDGE
+	/* Set to 1 to route newlib's malloc() family into the FreeRTOS heap, see
+	newlib_malloc.c. */
+	#define configUSE_NEWLIB_MALLOC_BRIDGE 0
+#endif
+
+#ifndef configUSE_OBJECT_POOLS
+	#define configUSE_OBJECT_POOLS 0
+#endif
+
+/* The allocator of the TCBs and stacks created by xTaskCreate(), the queues
+created by xQueueCreate() and the timers created by xTimerCreate(), and the
+function that frees them.  See object_pool.h. */
+#ifndef configKERNEL_OBJECT_MALLOC
+	#if( configUSE_OBJECT_POOLS == 1 )
+		#define configKERNEL_OBJECT_MALLOC( xSize ) pvObjectPoolMalloc( xSize )
+	#elif( portCONTROL_BLOCK_ALIGNMENT > portBYTE_ALIGNMENT )
+		#define configKERNEL_OBJECT_MALLOC( xSize ) pvPortMallocPlaced( ( xSize ), eHeapFast, portCONTROL_BLOCK_ALIGNMENT )
+	#else
+		#define configKERNEL_OBJECT_MALLOC( xSize ) pvPortMalloc( xSize )
+	#endif
+#endif
+
+#ifndef configKERNEL_OBJECT_FREE
+	#if( configUSE_OBJECT_POOLS == 1 )
+		#define configKERNEL_OBJECT_FREE( pv ) vObjectPoolFree( pv )
+	#else
+		#define configKERNEL_OBJECT_FREE( pv ) vPortFree( pv )
+	#endif
+#endif
+
+#ifndef configUSE_ARENAS
+	#define configUSE_ARENAS 0
+#endif
+
+#ifndef configARENA_OVERRUN_CHECK
+	#define configARENA_OVERRUN_CHECK 0
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 	#if( INCLUDE_vTaskSuspend != 1 )
@@ -848,10 +1072,50 @@ extern "C" {
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( ( portCONTROL_BLOCK_ALIGNMENT > portBYTE_ALIGNMENT ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TLSF_HEAP != 1 ) )
+	#error configUSE_TLSF_HEAP must be set to 1 to allocate TCBs and queues aligned to portCONTROL_BLOCK_ALIGNMENT
+#endif
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+#endif
+
+#if( ( configUSE_MUTEX_METRICS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use mutex metrics
+#endif
+
+#if( ( ( configTOTAL_BULK_HEAP_SIZE > 0 ) || ( configTOTAL_DMA_HEAP_SIZE > 0 ) ) && ( configUSE_TLSF_HEAP != 1 ) )
+	#error configUSE_TLSF_HEAP must be set to 1 to use a bulk or DMA heap region
+#endif
+
+#if( configHEAP_MAX_REGIONS < ( 1 + ( configTOTAL_BULK_HEAP_SIZE > 0 ) + ( configTOTAL_DMA_HEAP_SIZE > 0 ) ) )
+	#error configHEAP_MAX_REGIONS must leave room for ucHeap and the bulk and DMA heap regions
+#endif
+
+#if( ( configUSE_RCU == 1 ) && ( INCLUDE_vTaskDelay != 1 ) )
+	#error INCLUDE_vTaskDelay must be set to 1 to use RCU
+#endif
+
+#if( ( configUSE_QUEUE_SET_BITMAP == 1 ) && ( configUSE_QUEUE_SETS != 1 ) )
+	#error configUSE_QUEUE_SETS must be set to 1 to use queue set bitmaps
+#endif
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+#if( ( configUSE_SPSC_RINGS == 1 ) && ( configSPSC_RING_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES ) )
+	#error configSPSC_RING_NOTIFY_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+#if( ( configUSE_SPIN_LOCKS == 1 ) && ( configSPIN_LOCK_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES ) )
+	#error configSPIN_LOCK_NOTIFY_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1002,9 +1266,31 @@ typedef struct xSTATIC_TCB
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 		xMPU_SETTINGS	xDummy2;
 	#endif
-	StaticListItem_t	xDummy3[ 2 ];
+	StaticListItem_t	xDummy3;
 	UBaseType_t			uxDummy5;
 	void				*pxDummy6;
+	StaticListItem_t	xDummy4;
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+	#if( INCLUDE_xTaskAbortDelay == 1 )
+		uint8_t ucDummy21;
+	#endif
+	#if ( configUSE_RCU == 1 )
+		UBaseType_t		uxDummy23[ 2 ];
+	#endif
+	#if ( configUSE_POSIX_ERRNO == 1 )
+		int				iDummy22;
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		UBaseType_t		uxDummy12[ 2 ];
+		#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+			void		*pvDummy13;
+		#endif
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
 	uint8_t				ucDummy7[ configMAX_TASK_NAME_LEN ];
 	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
 		void			*pxDummy8;
@@ -1015,9 +1301,6 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy10[ 2 ];
 	#endif
-	#if ( configUSE_MUTEXES == 1 )
-		UBaseType_t		uxDummy12[ 2 ];
-	#endif
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
@@ -1030,21 +1313,10 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
-	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
-	#endif
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t			uxDummy20;
 	#endif
-
-	#if( INCLUDE_xTaskAbortDelay == 1 )
-		uint8_t ucDummy21;
-	#endif
-	#if ( configUSE_POSIX_ERRNO == 1 )
-		int				iDummy22;
-	#endif
-} StaticTask_t;
+} portCONTROL_BLOCK_ALIGNED StaticTask_t;
 
 /*
  * In line with software engineering best practice, especially when supplying a
@@ -1062,15 +1334,7 @@ typedef struct xSTATIC_TCB
  */
 typedef struct xSTATIC_QUEUE
 {
-	void *pvDummy1[ 3 ];
-
-	union
-	{
-		void *pvDummy2;
-		UBaseType_t uxDummy2;
-	} u;
-
-	StaticList_t xDummy3[ 2 ];
+	void *pvDummy1[ 2 ];
 	UBaseType_t uxDummy4[ 3 ];
 	uint8_t ucDummy5[ 2 ];
 
@@ -1078,16 +1342,34 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy6;
 	#endif
 
+	union
+	{
+		void *pvDummy2[ 2 ];
+		struct
+		{
+			void *pvDummy2;
+			UBaseType_t uxDummy2;
+			#if ( configUSE_MUTEX_METRICS == 1 )
+				uint32_t ulDummy2[ 5 ];
+			#endif
+		} xDummy2;
+	} u;
+
 	#if ( configUSE_QUEUE_SETS == 1 )
 		void *pvDummy7;
+		#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+			UBaseType_t uxDummy7;
+		#endif
 	#endif
 
+	StaticList_t xDummy3[ 2 ];
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy8;
 		uint8_t ucDummy9;
 	#endif
 
-} StaticQueue_t;
+} portCONTROL_BLOCK_ALIGNED StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
 /*
@@ -1109,6 +1391,11 @@ typedef struct xSTATIC_EVENT_GROUP
 	TickType_t xDummy1;
 	StaticList_t xDummy2;
 
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		TickType_t xDummy5;
+		StaticList_t xDummy6[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
@@ -1178,6 +1465,30 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with the structures above, StaticArena_t is provided to allow the
+ * arena structure of arena.c to be allocated statically, and must match the
+ * Arena_t structure defined there.
+ */
+typedef struct xSTATIC_ARENA
+{
+	void *pvDummy1[ 3 ];
+	size_t xDummy2[ 2 ];
+	uint32_t ulDummy3[ 3 ];
+	uint8_t ucDummy4;
+} StaticArena_t;
+
+/*
+ * In line with the structures above, StaticRcu_t is provided to allow the RCU
+ * handle of rcu.c to be allocated statically, and must match the Rcu_t
+ * structure defined there.
+ */
+typedef struct xSTATIC_RCU
+{
+	void *pvDummy1[ 2 ];
+	uint8_t ucDummy2;
+} StaticRcu_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,7 +46,7 @@
 
 #define configUSE_IDLE_HOOK 0
 
-#define configUSE_TICK_HOOK 0
+#define configUSE_TICK_HOOK 1
 
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 
@@ -55,12 +55,15 @@
 #define configUSE_TRACE_FACILITY 1
 
 #define configUSE_NEWLIB_REENTRANT 0
+#define configUSE_NEWLIB_MALLOC_BRIDGE 1
 
-#define configSTREAM_BUFFER 0
+#define configSTREAM_BUFFER 1
 
-#define configMESSAGE_BUFFER 0
+#define configMESSAGE_BUFFER 1
 
-#define configSUPPORT_STATIC_ALLOCATION 0
+/* The application's tasks and timers, and the idle and timer tasks, are
+created in memory allocated at compile time rather than on the heap. */
+#define configSUPPORT_STATIC_ALLOCATION 1
 
 #define configUSE_16_BIT_TICKS 0
 
@@ -76,7 +79,25 @@
 
 #define configMINIMAL_STACK_SIZE ( ( unsigned short ) 200)
 
-#define configTOTAL_HEAP_SIZE ( ( size_t ) ( 65536 ) )
+#define configTOTAL_HEAP_SIZE ( ( size_t ) ( 32768 ) )
+
+#define configTOTAL_BULK_HEAP_SIZE ( 1048576 )
+
+#define configTOTAL_DMA_HEAP_SIZE ( 1048576 )
+
+#define configPLACE_KERNEL_IN_OCM 1
+
+#define configUSE_TLSF_HEAP 1
+
+#define configUSE_OBJECT_POOLS 1
+
+/* { block size, number of blocks } of each kernel object pool. */
+#define configOBJECT_POOL_CLASSES									\
+	{ sizeof( StaticTimer_t ), 4 },									\
+	{ sizeof( StaticTask_t ), 8 },									\
+	{ sizeof( StaticQueue_t ) + 64, 8 },							\
+	{ configMINIMAL_STACK_SIZE * sizeof( StackType_t ), 6 },		\
+	{ configMINIMAL_STACK_SIZE * 2 * sizeof( StackType_t ), 4 }
 
 #define configMAX_TASK_NAME_LEN 10
 
@@ -94,8 +115,31 @@
 
 #define configUSE_QUEUE_SETS 1
 
+#define configUSE_ZERO_COPY_QUEUES 1
+
+#define configUSE_SPSC_RINGS 1
+#define configSPSC_RING_NOTIFY_INDEX 1
+
+#define configUSE_ARENAS 1
+#define configARENA_OVERRUN_CHECK 1
+
+#define configUSE_EVENT_GROUP_INDEX 1
+
+#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 1
+
+#define configUSE_MUTEX_METRICS 1
+
+#define configUSE_SPIN_LOCKS 1
+#define configSPIN_LOCK_NOTIFY_INDEX 2
+
+#define configUSE_RCU 1
+
+#define configUSE_QUEUE_SET_BITMAP 1
+
 #define configUSE_TASK_NOTIFICATIONS 1
 
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
+
 #define configCHECK_FOR_STACK_OVERFLOW 2
 
 #define configUSE_TASK_FPU_SUPPORT 1
@@ -108,6 +152,13 @@
 
 #define configGENERATE_RUN_TIME_STATS 0
 
+#define configUSE_CRITICAL_SECTION_PROFILING 0
+#define configUSE_HEAP_TRACKING 0
+#define configUSE_STACK_PROFILER 1
+#define configRECORD_STACK_HIGH_ADDRESS 1
+
+#define configUSE_TRACE_RECORDER 0
+
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 
 #define portGET_RUN_TIME_COUNTER_VALUE()
@@ -147,5 +198,6 @@ void FreeRTOS_ClearTickInterrupt( void );
 #ifdef FREERTOS_ENABLE_TRACE
 #include "FreeRTOSSTMTrace.h"
 #endif /* FREERTOS_ENABLE_TRACE */
+#include "trace_recorder.h"
 
 #endif
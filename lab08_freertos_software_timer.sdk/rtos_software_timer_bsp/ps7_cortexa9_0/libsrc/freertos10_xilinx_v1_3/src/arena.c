@@ -0,0 +1,511 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+#include "heap_track.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include arena allocators.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_ARENAS == 1 )
+
+/* Bits of ucFlags. */
+#define arenaFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 )
+
+/* The value the guard bytes after each buffer are set to when
+configARENA_OVERRUN_CHECK is 1. */
+#define arenaGUARD_BYTE						( ( uint8_t ) 0xa5U )
+
+/* The guard bytes always include at least this many after the end of a buffer,
+the rest being the padding up to the next multiple of portBYTE_ALIGNMENT. */
+#define arenaMINIMUM_GUARD_BYTES			( ( size_t ) portBYTE_ALIGNMENT )
+
+/* When configARENA_OVERRUN_CHECK is 1 each buffer is preceded by one of these,
+which chains the buffers together so their guard bytes can be found again. */
+typedef struct ArenaGuard
+{
+	uint8_t *pucGuard;					/*< The first guard byte, just past the end of the buffer. */
+	uint8_t *pucNext;					/*< The end of the guard bytes, where the next buffer's ArenaGuard_t is. */
+} ArenaGuard_t;
+
+#if( configARENA_OVERRUN_CHECK == 1 )
+	#define arenaGUARD_HEADER_SIZE	( ( sizeof( ArenaGuard_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+#else
+	#define arenaGUARD_HEADER_SIZE	( ( size_t ) 0 )
+#endif
+
+/*
+ * The arena only ever moves pucNext up, from pucStart towards pucEnd, until it
+ * is reset.  pucNext is always a multiple of portBYTE_ALIGNMENT, so a buffer
+ * with the default alignment needs no padding.  The layout of this structure
+ * must be kept in step with StaticArena_t in FreeRTOS.h.
+ */
+typedef struct ArenaDefinition
+{
+	uint8_t *pucStart;					/*< The first byte the arena hands out. */
+	uint8_t *pucNext;					/*< The first byte not yet handed out. */
+	uint8_t *pucEnd;					/*< One past the last byte the arena hands out. */
+	size_t xHighWaterBytes;
+	size_t xLargestFailedBytes;
+	uint32_t ulAllocations;
+	uint32_t ulFailedAllocations;
+	uint32_t ulResets;
+	uint8_t ucFlags;
+} Arena_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Sets up the arena structure to hand out the xSizeBytes bytes at
+ * pucArenaStorage, after rounding the start up to portBYTE_ALIGNMENT.
+ */
+static void prvInitialiseNewArena( Arena_t * const pxArena, uint8_t *pucArenaStorage, size_t xSizeBytes, uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records a request of xSize bytes that did not fit, and returns NULL.
+ */
+static void *prvAllocFailed( Arena_t * const pxArena, size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	ArenaHandle_t xArenaCreate( size_t xSizeBytes )
+	{
+	Arena_t *pxArena;
+	size_t xHeaderSizeInBytes;
+
+		configASSERT( xSizeBytes > ( size_t ) 0 );
+
+		/* The storage area follows the arena structure, which is padded so the
+		storage area starts on an aligned boundary. */
+		xHeaderSizeInBytes = ( sizeof( Arena_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		if( xSizeBytes < ( ( ( size_t ) -1 ) - xHeaderSizeInBytes ) )
+		{
+			pxArena = ( Arena_t * ) pvPortMalloc( xHeaderSizeInBytes + xSizeBytes ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+		}
+		else
+		{
+			pxArena = NULL;
+		}
+
+		if( pxArena != NULL )
+		{
+			heaptrackSET_CALL_SITE( pxArena, heaptrackCALL_SITE() );
+
+			prvInitialiseNewArena( pxArena, ( ( uint8_t * ) pxArena ) + xHeaderSizeInBytes, xSizeBytes, ( uint8_t ) 0 ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxArena;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	ArenaHandle_t xArenaCreateStatic( size_t xSizeBytes, uint8_t *pucArenaStorage, StaticArena_t *pxStaticArena )
+	{
+	Arena_t * const pxArena = ( Arena_t * ) pxStaticArena; /*lint !e740 !e9087 Safe cast as StaticArena_t is opaque Arena_t. */
+	ArenaHandle_t xReturn;
+
+		configASSERT( pucArenaStorage );
+		configASSERT( pxStaticArena );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticArena_t equals the size of the real arena
+			structure. */
+			volatile size_t xSize = sizeof( StaticArena_t );
+			configASSERT( xSize == sizeof( Arena_t ) );
+		} /*lint !e529 xSize is referenced is configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucArenaStorage != NULL ) && ( pxStaticArena != NULL ) )
+		{
+			prvInitialiseNewArena( pxArena, pucArenaStorage, xSizeBytes, arenaFLAGS_IS_STATICALLY_ALLOCATED );
+			xReturn = pxArena;
+		}
+		else
+		{
+			xReturn = NULL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vArenaDelete( ArenaHandle_t xArena )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+
+	if( ( pxArena->ucFlags & arenaFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the storage area were allocated in one
+			go, so are freed in one go. */
+			vPortFree( ( void * ) pxArena );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt. */
+			configASSERT( xArena == ( ArenaHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and storage area belong to the application, so just
+		stop them being used through the old handle. */
+		( void ) memset( pxArena, 0x00, sizeof( Arena_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xSize )
+{
+void *pvReturn;
+
+	#if( configARENA_OVERRUN_CHECK == 1 )
+	{
+		/* The guard header and bytes are laid out by the general case. */
+		pvReturn = pvArenaAllocAligned( xArena, xSize, ( size_t ) portBYTE_ALIGNMENT );
+	}
+	#else
+	{
+	Arena_t * const pxArena = xArena;
+	size_t xAlignedSize;
+
+		configASSERT( pxArena );
+
+		/* pucNext is always aligned, so only the size has to be rounded up to
+		keep it aligned.  Comparing the unrounded size first stops the rounding
+		wrapping. */
+		if( xSize <= ( size_t ) ( pxArena->pucEnd - pxArena->pucNext ) )
+		{
+			xAlignedSize = ( xSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		}
+		else
+		{
+			xAlignedSize = ( size_t ) -1;
+		}
+
+		if( xAlignedSize <= ( size_t ) ( pxArena->pucEnd - pxArena->pucNext ) )
+		{
+			pvReturn = ( void * ) pxArena->pucNext;
+			pxArena->pucNext += xAlignedSize;
+			pxArena->ulAllocations++;
+
+			if( ( size_t ) ( pxArena->pucNext - pxArena->pucStart ) > pxArena->xHighWaterBytes )
+			{
+				pxArena->xHighWaterBytes = ( size_t ) ( pxArena->pucNext - pxArena->pucStart );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			pvReturn = prvAllocFailed( pxArena, xSize );
+		}
+	}
+	#endif /* configARENA_OVERRUN_CHECK */
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvArenaAllocAligned( ArenaHandle_t xArena, size_t xSize, size_t xAlignment )
+{
+Arena_t * const pxArena = xArena;
+uint8_t *pucReturn = NULL;
+size_t xPadding, xAlignedSize, xFree;
+
+	configASSERT( pxArena );
+
+	/* The alignment must be a power of two. */
+	configASSERT( ( xAlignment & ( xAlignment - ( size_t ) 1 ) ) == ( size_t ) 0 );
+
+	if( xAlignment < ( size_t ) portBYTE_ALIGNMENT )
+	{
+		xAlignment = ( size_t ) portBYTE_ALIGNMENT;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The padding that takes the buffer, which follows the guard header if
+	there is one, up to the requested alignment. */
+	xPadding = ( size_t ) ( ( portPOINTER_SIZE_TYPE ) ( pxArena->pucNext + arenaGUARD_HEADER_SIZE ) & ( portPOINTER_SIZE_TYPE ) ( xAlignment - ( size_t ) 1 ) );
+
+	if( xPadding != ( size_t ) 0 )
+	{
+		xPadding = xAlignment - xPadding;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFree = ( size_t ) ( pxArena->pucEnd - pxArena->pucNext );
+
+	/* Each step is checked against the space left before it is added, so
+	none of the sums can wrap. */
+	if( ( xSize <= xFree ) && ( xPadding <= ( xFree - xSize ) ) )
+	{
+		xAlignedSize = ( xSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		#if( configARENA_OVERRUN_CHECK == 1 )
+		{
+			xAlignedSize += arenaMINIMUM_GUARD_BYTES;
+		}
+		#endif
+
+		if( ( arenaGUARD_HEADER_SIZE + xPadding + xAlignedSize ) <= xFree )
+		{
+			pucReturn = pxArena->pucNext + arenaGUARD_HEADER_SIZE + xPadding;
+
+			#if( configARENA_OVERRUN_CHECK == 1 )
+			{
+			ArenaGuard_t * const pxGuard = ( ArenaGuard_t * ) pxArena->pucNext; /*lint !e9087 !e9079 pucNext is aligned for any type. */
+
+				pxGuard->pucGuard = pucReturn + xSize;
+				pxGuard->pucNext = pucReturn + xAlignedSize;
+				( void ) memset( pxGuard->pucGuard, ( int ) arenaGUARD_BYTE, ( size_t ) ( pxGuard->pucNext - pxGuard->pucGuard ) );
+			}
+			#endif
+
+			pxArena->pucNext = pucReturn + xAlignedSize;
+			pxArena->ulAllocations++;
+
+			if( ( size_t ) ( pxArena->pucNext - pxArena->pucStart ) > pxArena->xHighWaterBytes )
+			{
+				pxArena->xHighWaterBytes = ( size_t ) ( pxArena->pucNext - pxArena->pucStart );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pucReturn == NULL )
+	{
+		pucReturn = ( uint8_t * ) prvAllocFailed( pxArena, xSize );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( void * ) pucReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaReset( ArenaHandle_t xArena )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+
+	#if( configARENA_OVERRUN_CHECK == 1 )
+	{
+		/* A buffer was written past its end since the last reset. */
+		configASSERT( xArenaCheck( xArena ) == pdPASS );
+	}
+	#endif
+
+	pxArena->pucNext = pxArena->pucStart;
+	pxArena->ulResets++;
+}
+/*-----------------------------------------------------------*/
+
+size_t xArenaGetFreeSize( ArenaHandle_t xArena )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+
+	return ( size_t ) ( pxArena->pucEnd - pxArena->pucNext );
+}
+/*-----------------------------------------------------------*/
+
+void vArenaGetStats( ArenaHandle_t xArena, ArenaStats_t *pxStats )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+	configASSERT( pxStats );
+
+	pxStats->xSizeBytes = ( size_t ) ( pxArena->pucEnd - pxArena->pucStart );
+	pxStats->xUsedBytes = ( size_t ) ( pxArena->pucNext - pxArena->pucStart );
+	pxStats->xHighWaterBytes = pxArena->xHighWaterBytes;
+	pxStats->xLargestFailedBytes = pxArena->xLargestFailedBytes;
+	pxStats->ulAllocations = pxArena->ulAllocations;
+	pxStats->ulFailedAllocations = pxArena->ulFailedAllocations;
+	pxStats->ulResets = pxArena->ulResets;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xArenaCheck( ArenaHandle_t xArena )
+{
+Arena_t * const pxArena = xArena;
+BaseType_t xReturn = pdPASS;
+
+	configASSERT( pxArena );
+
+	#if( configARENA_OVERRUN_CHECK == 1 )
+	{
+	const ArenaGuard_t *pxGuard;
+	const uint8_t *pucHeader, *pucByte;
+
+		/* Walk the chain of buffers from the bottom of the arena.  A header
+		that does not point further up the arena was itself overwritten. */
+		for( pucHeader = pxArena->pucStart; ( pucHeader < pxArena->pucNext ) && ( xReturn == pdPASS ); pucHeader = pxGuard->pucNext )
+		{
+			pxGuard = ( const ArenaGuard_t * ) pucHeader; /*lint !e9087 !e9079 The headers are aligned for any type. */
+
+			if( ( pxGuard->pucGuard <= pucHeader ) || ( pxGuard->pucNext <= pxGuard->pucGuard ) || ( pxGuard->pucNext > pxArena->pucNext ) )
+			{
+				xReturn = pdFAIL;
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			for( pucByte = pxGuard->pucGuard; pucByte < pxGuard->pucNext; pucByte++ )
+			{
+				if( *pucByte != arenaGUARD_BYTE )
+				{
+					xReturn = pdFAIL;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+	#endif /* configARENA_OVERRUN_CHECK */
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewArena( Arena_t * const pxArena, uint8_t *pucArenaStorage, size_t xSizeBytes, uint8_t ucFlags )
+{
+size_t xPadding;
+
+	/* Storage provided by the application need not be aligned.  Drop the
+	bytes below the first aligned address, and any bytes left over at the
+	top, so pucNext stays aligned. */
+	xPadding = ( size_t ) ( ( portPOINTER_SIZE_TYPE ) pucArenaStorage & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+	if( xPadding != ( size_t ) 0 )
+	{
+		xPadding = ( size_t ) portBYTE_ALIGNMENT - xPadding;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xPadding > xSizeBytes )
+	{
+		xPadding = xSizeBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memset( pxArena, 0x00, sizeof( Arena_t ) );
+	pxArena->pucStart = pucArenaStorage + xPadding;
+	pxArena->pucNext = pxArena->pucStart;
+	pxArena->pucEnd = pxArena->pucStart + ( ( xSizeBytes - xPadding ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) );
+	pxArena->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocFailed( Arena_t * const pxArena, size_t xSize )
+{
+	pxArena->ulFailedAllocations++;
+
+	if( xSize > pxArena->xLargestFailedBytes )
+	{
+		pxArena->xLargestFailedBytes = xSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return NULL;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include arena allocators.  If you want to include arena allocators then
+ensure configUSE_ARENAS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ARENAS == 1 */
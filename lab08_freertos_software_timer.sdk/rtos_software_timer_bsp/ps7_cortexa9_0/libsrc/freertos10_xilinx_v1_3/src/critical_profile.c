@@ -0,0 +1,331 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "critical_profile.h"
+
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+	#include <stdio.h>
+#endif
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include critical section profiling.  This #if is closed at the very bottom
+of this file. */
+#if( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+/* Call sites are hashed on their address.  ARM instructions are word aligned,
+so the two least significant bits carry no information. */
+#define cpHASH_CALL_SITE( pvCallSite )	( ( ( ( uint32_t ) ( size_t ) ( pvCallSite ) ) >> 2UL ) % ( uint32_t ) configCRITICAL_PROFILE_MAX_SITES )
+
+/* The section, if any, that is currently open for each kind. */
+typedef struct xOPEN_SECTION
+{
+	uint32_t ulStartCycles;
+	void *pvCallSite;
+	BaseType_t xIsOpen;
+} OpenSection_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the table entry used to accumulate the statistics for pvCallSite,
+ * claiming a free entry if pvCallSite has not been seen before.  Returns the
+ * overflow entry if the table is full.
+ */
+static CriticalProfileSite_t *prvGetSite( eCriticalProfileKind eKind, void *pvCallSite ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the histogram bucket that counts sections lasting ulCycles.
+ */
+static UBaseType_t prvGetBucket( uint32_t ulCycles ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+PRIVILEGED_DATA static OpenSection_t xOpenSections[ eCriticalProfileNumKinds ];
+PRIVILEGED_DATA static CriticalProfileSite_t xSites[ configCRITICAL_PROFILE_MAX_SITES ];
+PRIVILEGED_DATA static CriticalProfileSite_t xOverflowSite;
+PRIVILEGED_DATA static uint32_t ulHistograms[ eCriticalProfileNumKinds ][ criticalprofileHISTOGRAM_BUCKETS ];
+PRIVILEGED_DATA static uint32_t ulMaxCycles[ eCriticalProfileNumKinds ];
+
+/*-----------------------------------------------------------*/
+
+void vCriticalProfileSectionStart( eCriticalProfileKind eKind, void *pvCallSite )
+{
+OpenSection_t * const pxOpen = &( xOpenSections[ eKind ] );
+
+	pxOpen->pvCallSite = pvCallSite;
+	pxOpen->xIsOpen = pdTRUE;
+
+	/* Read the timestamp last so the bookkeeping above is not counted. */
+	pxOpen->ulStartCycles = portGET_CYCLE_COUNT();
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfileSetCallSite( eCriticalProfileKind eKind, void *pvCallSite )
+{
+	if( xOpenSections[ eKind ].xIsOpen != pdFALSE )
+	{
+		xOpenSections[ eKind ].pvCallSite = pvCallSite;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfileSectionEnd( eCriticalProfileKind eKind )
+{
+/* Read the timestamp first so the bookkeeping below is not counted. */
+const uint32_t ulEndCycles = portGET_CYCLE_COUNT();
+OpenSection_t * const pxOpen = &( xOpenSections[ eKind ] );
+CriticalProfileSite_t *pxSite;
+uint32_t ulCycles;
+
+	if( pxOpen->xIsOpen != pdFALSE )
+	{
+		pxOpen->xIsOpen = pdFALSE;
+
+		/* Unsigned arithmetic handles the counter wrapping. */
+		ulCycles = ulEndCycles - pxOpen->ulStartCycles;
+
+		pxSite = prvGetSite( eKind, pxOpen->pvCallSite );
+		( pxSite->ulCount )++;
+		pxSite->ullTotalCycles += ulCycles;
+
+		if( ulCycles > pxSite->ulMaxCycles )
+		{
+			pxSite->ulMaxCycles = ulCycles;
+		}
+
+		if( ulCycles > ulMaxCycles[ eKind ] )
+		{
+			ulMaxCycles[ eKind ] = ulCycles;
+		}
+
+		( ulHistograms[ eKind ][ prvGetBucket( ulCycles ) ] )++;
+	}
+	else
+	{
+		/* The section was opened before a context switch, see the comments
+		in critical_profile.h. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static CriticalProfileSite_t *prvGetSite( eCriticalProfileKind eKind, void *pvCallSite )
+{
+UBaseType_t uxIndex, uxProbes;
+CriticalProfileSite_t *pxSite = &xOverflowSite;
+
+	/* Open addressing with linear probing.  Entries are never removed other
+	than by vCriticalProfileReset(), so the first unused entry ends the
+	search. */
+	uxIndex = ( UBaseType_t ) cpHASH_CALL_SITE( pvCallSite );
+
+	for( uxProbes = 0; uxProbes < ( UBaseType_t ) configCRITICAL_PROFILE_MAX_SITES; uxProbes++ )
+	{
+		if( xSites[ uxIndex ].pvCallSite == NULL )
+		{
+			xSites[ uxIndex ].pvCallSite = pvCallSite;
+			xSites[ uxIndex ].eKind = eKind;
+			pxSite = &( xSites[ uxIndex ] );
+			break;
+		}
+		else if( ( xSites[ uxIndex ].pvCallSite == pvCallSite ) && ( xSites[ uxIndex ].eKind == eKind ) )
+		{
+			pxSite = &( xSites[ uxIndex ] );
+			break;
+		}
+		else
+		{
+			uxIndex++;
+
+			if( uxIndex >= ( UBaseType_t ) configCRITICAL_PROFILE_MAX_SITES )
+			{
+				uxIndex = 0;
+			}
+		}
+	}
+
+	return pxSite;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetBucket( uint32_t ulCycles )
+{
+UBaseType_t uxBucket;
+
+	if( ulCycles == 0UL )
+	{
+		uxBucket = 0;
+	}
+	else
+	{
+		/* The index of the most significant set bit. */
+		uxBucket = ( UBaseType_t ) ( 31UL - ( uint32_t ) __builtin_clz( ulCycles ) );
+	}
+
+	return uxBucket;
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfileReset( void )
+{
+	taskENTER_CRITICAL();
+	{
+		memset( ( void * ) xSites, 0x00, sizeof( xSites ) );
+		memset( ( void * ) &xOverflowSite, 0x00, sizeof( xOverflowSite ) );
+		memset( ( void * ) ulHistograms, 0x00, sizeof( ulHistograms ) );
+		memset( ( void * ) ulMaxCycles, 0x00, sizeof( ulMaxCycles ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxCriticalProfileGetSites( CriticalProfileSite_t *pxSiteArray, const UBaseType_t uxArraySize )
+{
+UBaseType_t uxIndex, uxWritten = 0;
+
+	configASSERT( pxSiteArray );
+
+	taskENTER_CRITICAL();
+	{
+		for( uxIndex = 0; uxIndex < ( UBaseType_t ) configCRITICAL_PROFILE_MAX_SITES; uxIndex++ )
+		{
+			if( uxWritten >= uxArraySize )
+			{
+				break;
+			}
+			else if( xSites[ uxIndex ].pvCallSite != NULL )
+			{
+				pxSiteArray[ uxWritten ] = xSites[ uxIndex ];
+				uxWritten++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Report the sections that did not fit in the table, if any. */
+		if( ( xOverflowSite.ulCount > 0UL ) && ( uxWritten < uxArraySize ) )
+		{
+			pxSiteArray[ uxWritten ] = xOverflowSite;
+			uxWritten++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxWritten;
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfileGetHistogram( eCriticalProfileKind eKind, uint32_t *pulBuckets )
+{
+	configASSERT( eKind < eCriticalProfileNumKinds );
+	configASSERT( pulBuckets );
+
+	taskENTER_CRITICAL();
+	{
+		memcpy( ( void * ) pulBuckets, ( void * ) ulHistograms[ eKind ], sizeof( ulHistograms[ eKind ] ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulCriticalProfileGetMaxCycles( eCriticalProfileKind eKind )
+{
+	configASSERT( eKind < eCriticalProfileNumKinds );
+
+	/* A 32-bit read is atomic on this architecture. */
+	return ulMaxCycles[ eKind ];
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+	void vCriticalProfileList( char *pcWriteBuffer )
+	{
+	static CriticalProfileSite_t xSiteCopy[ configCRITICAL_PROFILE_MAX_SITES + 1 ];
+	static uint32_t ulBucketCopy[ criticalprofileHISTOGRAM_BUCKETS ];
+	static const char * const pcKindNames[ eCriticalProfileNumKinds ] = { "mask", "suspend" };
+	UBaseType_t uxSites, x;
+	BaseType_t xKind;
+	uint32_t ulAverage;
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Copy the data out first, so the formatting below is done with
+		interrupts unmasked.  The static copies avoid placing the table on the
+		calling task's stack, so this function is not reentrant. */
+		uxSites = uxCriticalProfileGetSites( xSiteCopy, ( UBaseType_t ) ( configCRITICAL_PROFILE_MAX_SITES + 1 ) );
+
+		for( x = 0; x < uxSites; x++ )
+		{
+			ulAverage = ( uint32_t ) ( xSiteCopy[ x ].ullTotalCycles / ( uint64_t ) xSiteCopy[ x ].ulCount );
+			sprintf( pcWriteBuffer, "%s\t0x%08x\t%u\t%u\t%u\r\n", pcKindNames[ xSiteCopy[ x ].eKind ], ( unsigned int ) ( size_t ) xSiteCopy[ x ].pvCallSite, ( unsigned int ) xSiteCopy[ x ].ulCount, ( unsigned int ) xSiteCopy[ x ].ulMaxCycles, ( unsigned int ) ulAverage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+			pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+		}
+
+		for( xKind = 0; xKind < ( BaseType_t ) eCriticalProfileNumKinds; xKind++ )
+		{
+			vCriticalProfileGetHistogram( ( eCriticalProfileKind ) xKind, ulBucketCopy );
+
+			for( x = 0; x < ( UBaseType_t ) criticalprofileHISTOGRAM_BUCKETS; x++ )
+			{
+				if( ulBucketCopy[ x ] != 0UL )
+				{
+					sprintf( pcWriteBuffer, "%s\t>=2^%u\t%u\r\n", pcKindNames[ xKind ], ( unsigned int ) x, ( unsigned int ) ulBucketCopy[ x ] ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+					pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
+
+/* This entire source file will be skipped if the application is not configured
+to include critical section profiling.  If you want to include critical section
+profiling then ensure configUSE_CRITICAL_SECTION_PROFILING is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_CRITICAL_SECTION_PROFILING == 1 */
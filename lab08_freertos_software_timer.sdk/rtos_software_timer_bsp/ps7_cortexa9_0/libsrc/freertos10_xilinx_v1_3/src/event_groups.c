@@ -38,6 +38,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "timers.h"
 #include "event_groups.h"
+#include "heap_track.h"
 
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -60,11 +61,35 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+/* The number of event bits, each of which has a bucket in the waiter index
+when configUSE_EVENT_GROUP_INDEX is 1. */
+#if configUSE_16_BIT_TICKS == 1
+	#define eventNUM_EVENT_BITS				8U
+#else
+	#define eventNUM_EVENT_BITS				24U
+#endif
+
+/* With the waiter index, interrupts set bits and unblock tasks directly, so
+task level accesses to the waiting tasks are made from a critical section as
+well as with the scheduler suspended. */
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+	#define eventENTER_WAITERS_CRITICAL()	taskENTER_CRITICAL()
+	#define eventEXIT_WAITERS_CRITICAL()	taskEXIT_CRITICAL()
+#else
+	#define eventENTER_WAITERS_CRITICAL()
+	#define eventEXIT_WAITERS_CRITICAL()
+#endif
+
 typedef struct EventGroupDef_t
 {
 	EventBits_t uxEventBits;
 	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
 
+	#if( configUSE_EVENT_GROUP_INDEX == 1 )
+		EventBits_t uxBitsWaitedFor;						/*< A superset of the bits waited for by the tasks in xTasksWaitingForBits, which then only holds tasks waiting for any one of several bits. */
+		List_t xTasksWaitingForBit[ eventNUM_EVENT_BITS ];	/*< The other waiting tasks, each in the bucket of one of its bits that is clear. */
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
 	#endif
@@ -86,6 +111,42 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	/*
+	 * Initialise the waiter index of a new event group.
+	 */
+	static void prvInitialiseWaiterIndex( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Block the calling task in the waiter index.  A task waiting for any one
+	 * of several bits is placed in xTasksWaitingForBits.  Any other task can
+	 * only be unblocked once all the bits it waits for are set, so it is
+	 * placed in the bucket of one of those bits that is clear.  Must be called
+	 * from a critical section with the scheduler suspended.
+	 */
+	static void prvPlaceOnWaiterIndex( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxControlBits, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Set uxBitsToSet and unblock the tasks whose wait condition is then met.
+	 * Only the buckets of the bits that change from clear to set are visited,
+	 * and xTasksWaitingForBits only if uxBitsToSet includes a bit waited for
+	 * in it.  A task that is visited but still waits for bits that are clear
+	 * is moved to the bucket of one of them.  Must be called with interrupts
+	 * masked, and from a task only with the scheduler suspended.  Returns
+	 * pdTRUE if a task with a priority above that of the interrupted task was
+	 * unblocked from an interrupt.
+	 */
+	static BaseType_t prvSetBitsInWaiterIndex( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the index of the most significant bit set in uxBits, which must
+	 * not be zero.
+	 */
+	static UBaseType_t prvGetHighestBit( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -115,6 +176,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+				prvInitialiseWaiterIndex( pxEventBits );
+			}
+			#endif
+
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note that
@@ -163,9 +230,17 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 
 		if( pxEventBits != NULL )
 		{
+			heaptrackSET_CALL_SITE( pxEventBits, heaptrackCALL_SITE() );
+
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+				prvInitialiseWaiterIndex( pxEventBits );
+			}
+			#endif
+
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note this
@@ -204,6 +279,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_WAITERS_CRITICAL();
 	{
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
@@ -229,7 +305,15 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				#if( configUSE_EVENT_GROUP_INDEX == 1 )
+				{
+					prvPlaceOnWaiterIndex( pxEventBits, uxBitsToWaitFor, ( eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				}
+				#else
+				{
+					vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				}
+				#endif
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -246,6 +330,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			}
 		}
 	}
+	eventEXIT_WAITERS_CRITICAL();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -327,6 +412,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	#endif
 
 	vTaskSuspendAll();
+	eventENTER_WAITERS_CRITICAL();
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -384,7 +470,15 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+				prvPlaceOnWaiterIndex( pxEventBits, uxBitsToWaitFor, uxControlBits, xTicksToWait );
+			}
+			#else
+			{
+				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			}
+			#endif
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -394,6 +488,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
 	}
+	eventEXIT_WAITERS_CRITICAL();
 	xAlreadyYielded = xTaskResumeAll();
 
 	if( xTicksToWait != ( TickType_t ) 0 )
@@ -485,7 +580,29 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* Clearing bits cannot unblock a task, so is done here rather than
+		being deferred to the timer task. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
@@ -516,6 +633,34 @@ EventBits_t uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
+{
+EventGroup_t *pxEventBits = xEventGroup;
+
+	/* Check the user is not attempting to set the bits used by the kernel
+	itself. */
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+	/* The scheduler is suspended so tasks unblocked here go straight to the
+	ready lists, and interrupts are masked as they also use the index. */
+	vTaskSuspendAll();
+	taskENTER_CRITICAL();
+	{
+		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+
+		( void ) prvSetBitsInWaiterIndex( pxEventBits, uxBitsToSet, pdFALSE );
+	}
+	taskEXIT_CRITICAL();
+	( void ) xTaskResumeAll();
+
+	return pxEventBits->uxEventBits;
+}
+
+#else /* configUSE_EVENT_GROUP_INDEX */
+
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
 ListItem_t *pxListItem, *pxNext;
@@ -608,6 +753,8 @@ BaseType_t xMatchFound = pdFALSE;
 
 	return pxEventBits->uxEventBits;
 }
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
 /*-----------------------------------------------------------*/
 
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
@@ -619,13 +766,34 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		eventENTER_WAITERS_CRITICAL();
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being deleted
+				and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+
+			#if( configUSE_EVENT_GROUP_INDEX == 1 )
+			{
+			UBaseType_t uxBit;
+
+				/* Likewise unblock the tasks in the buckets of the index. */
+				for( uxBit = 0; uxBit < eventNUM_EVENT_BITS; uxBit++ )
+				{
+					pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+					while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+					{
+						vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+			}
+			#endif /* configUSE_EVENT_GROUP_INDEX */
 		}
+		eventEXIT_WAITERS_CRITICAL();
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
@@ -703,7 +871,230 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	static void prvInitialiseWaiterIndex( EventGroup_t *pxEventBits )
+	{
+	UBaseType_t uxBit;
+
+		pxEventBits->uxBitsWaitedFor = 0;
+
+		for( uxBit = 0; uxBit < eventNUM_EVENT_BITS; uxBit++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvPlaceOnWaiterIndex( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxControlBits, const TickType_t xTicksToWait )
+	{
+	List_t *pxList;
+
+		if( ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 ) && ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - 1 ) ) != ( EventBits_t ) 0 ) )
+		{
+			/* Any one of several bits will do, so the task cannot be keyed on
+			a single bit. */
+			pxEventBits->uxBitsWaitedFor |= uxBitsToWaitFor;
+			pxList = &( pxEventBits->xTasksWaitingForBits );
+		}
+		else
+		{
+			/* The task is only blocking because at least one of its bits is
+			clear. */
+			pxList = &( pxEventBits->xTasksWaitingForBit[ prvGetHighestBit( uxBitsToWaitFor & ~( pxEventBits->uxEventBits ) ) ] );
+		}
+
+		vTaskPlaceOnUnorderedEventList( pxList, ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvSetBitsInWaiterIndex( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR )
+	{
+	ListItem_t *pxListItem, *pxNext;
+	ListItem_t const *pxListEnd;
+	List_t *pxList;
+	EventBits_t uxNewBits, uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxBitsStillClear, uxBitsStillWaitedFor;
+	UBaseType_t uxBit;
+	BaseType_t xMatchFound, xReturn = pdFALSE;
+
+		/* Only the buckets of bits that were clear can hold tasks, as a task is
+		always keyed on a bit that is clear. */
+		uxNewBits = uxBitsToSet & ~( pxEventBits->uxEventBits );
+		pxEventBits->uxEventBits |= uxBitsToSet;
+
+		while( uxNewBits != ( EventBits_t ) 0 )
+		{
+			uxBit = prvGetHighestBit( uxNewBits );
+			uxNewBits &= ~( ( EventBits_t ) 1 << uxBit );
+
+			pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+			pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+
+			while( pxListItem != pxListEnd )
+			{
+				pxNext = listGET_NEXT( pxListItem );
+				uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+				/* Split the bits waited for from the control bits. */
+				uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+				uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+				uxBitsStillClear = uxBitsWaitedFor & ~( pxEventBits->uxEventBits );
+
+				if( uxBitsStillClear == ( EventBits_t ) 0 )
+				{
+					if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+					{
+						uxBitsToClear |= uxBitsWaitedFor;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( xFromISR != pdFALSE )
+					{
+						xReturn |= xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+					else
+					{
+						vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+				else
+				{
+					/* Move the task to the bucket of a bit that is still clear.
+					That bucket is not visited again by this call. */
+					( void ) uxListRemove( pxListItem );
+					vListInsertEnd( &( pxEventBits->xTasksWaitingForBit[ prvGetHighestBit( uxBitsStillClear ) ] ), pxListItem );
+				}
+
+				pxListItem = pxNext;
+			}
+		}
+
+		if( ( uxBitsToSet & pxEventBits->uxBitsWaitedFor ) != ( EventBits_t ) 0 )
+		{
+			/* Tasks that timed out leave the list without updating
+			uxBitsWaitedFor, so it is rebuilt from the tasks that remain. */
+			uxBitsStillWaitedFor = 0;
+			pxList = &( pxEventBits->xTasksWaitingForBits );
+			pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			pxListItem = listGET_HEAD_ENTRY( pxList );
+
+			while( pxListItem != pxListEnd )
+			{
+				pxNext = listGET_NEXT( pxListItem );
+				uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+				uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+				uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+				xMatchFound = prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor, pdFALSE );
+
+				if( xMatchFound != pdFALSE )
+				{
+					if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+					{
+						uxBitsToClear |= uxBitsWaitedFor;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( xFromISR != pdFALSE )
+					{
+						xReturn |= xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+					else
+					{
+						vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+					}
+				}
+				else
+				{
+					uxBitsStillWaitedFor |= uxBitsWaitedFor;
+				}
+
+				pxListItem = pxNext;
+			}
+
+			pxEventBits->uxBitsWaitedFor = uxBitsStillWaitedFor;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+		bit was set in the control word. */
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvGetHighestBit( EventBits_t uxBits )
+	{
+	UBaseType_t uxBit;
+
+		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+		{
+			/* The port's ready priority lookup finds the most significant set
+			bit with a single instruction. */
+			portGET_HIGHEST_PRIORITY( uxBit, uxBits );
+		}
+		#else
+		{
+			uxBit = 0;
+
+			while( ( uxBits >>= 1 ) != ( EventBits_t ) 0 )
+			{
+				uxBit++;
+			}
+		}
+		#endif
+
+		return uxBit;
+	}
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xYieldRequired;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* The index bounds the work done here by the number of tasks that are
+		unblocked, or that wait for more than one bit, so the bits are set and
+		the tasks unblocked from the interrupt rather than by the timer task. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+			xYieldRequired = prvSetBitsInWaiterIndex( pxEventBits, uxBitsToSet, pdTRUE );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pdPASS;
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
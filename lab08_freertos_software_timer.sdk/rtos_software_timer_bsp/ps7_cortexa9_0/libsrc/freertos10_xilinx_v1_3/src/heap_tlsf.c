@@ -0,0 +1,979 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A two level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree() that can be used in place of heap_4.c, from the same ucHeap
+ * array.  Set configUSE_TLSF_HEAP to 1 in FreeRTOSConfig.h to build it instead
+ * of heap_4.c.
+ *
+ * heap_4.c keeps its free blocks in a single list in address order, so both
+ * pvPortMalloc() and vPortFree() walk the list, with the scheduler suspended,
+ * for a time that grows with the number of free blocks.  Here the free blocks
+ * are kept in an array of lists, one per size class.  The first level divides
+ * the sizes at the powers of two and the second level divides each power of
+ * two into heapSL_INDEX_COUNT equal ranges.  A bitmap per level records which
+ * lists are not empty, so the list holding a block large enough for a request
+ * is found with two bit scans, and pvPortMalloc() and vPortFree() take a
+ * bounded time whatever the state of the heap.  Freed blocks are merged with
+ * free neighbours at once, as in heap_4.c, which finds its neighbours through
+ * the address ordered list and here through a pointer to the previous block in
+ * memory kept in each block header.
+ *
+ * A request is rounded up to the start of the next size class before the
+ * search, so any block in the list found is large enough.  This wastes at most
+ * 1 / heapSL_INDEX_COUNT of a large block, which is split off and returned to
+ * the free lists when it is large enough to be a block of its own.
+ *
+ * The heap can span more than one region of memory, each with its own free
+ * lists.  ucHeap is always the first, and is placed with portFAST_HEAP, so on a
+ * port that links it into on-chip memory the kernel objects and everything
+ * else allocated while it has space are served from there.  A second, bulk
+ * region of configTOTAL_BULK_HEAP_SIZE bytes in ordinary memory is used once
+ * ucHeap cannot satisfy a request, and further regions can be added with
+ * vPortDefineHeapRegions().  Blocks are never merged across regions.
+ *
+ * pvPortMallocPlaced() takes a placement and an alignment.  eHeapBulk searches
+ * the bulk regions before ucHeap, so large buffers do not use up the fast
+ * memory, and eHeapDMA allocates only from a region of configTOTAL_DMA_HEAP_SIZE
+ * bytes that the port makes non-cacheable.  A block is aligned by freeing the
+ * space in front of the aligned address as a block of its own.
+ *
+ * See heap_4.c for the first fit implementation, and vPortGetHeapStats() for
+ * the fragmentation figures both keep.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_track.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to use the TLSF heap.  This #if is closed at the very bottom of this file. */
+#if( configUSE_TLSF_HEAP == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Each power of two is divided into 2 ^ heapSL_INDEX_COUNT_LOG2 size classes. */
+#define heapSL_INDEX_COUNT_LOG2		( 4 )
+#define heapSL_INDEX_COUNT			( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all kept in the first level
+list 0, divided into heapSL_INDEX_COUNT classes of 8 bytes each. */
+#define heapFL_INDEX_SHIFT			( heapSL_INDEX_COUNT_LOG2 + 3 )
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The largest block the lists can hold is a little under 2 ^ ( heapFL_INDEX_MAX
++ 1 ) bytes, far more than ucHeap.  Larger regions are trimmed to
+heapMAXIMUM_BLOCK_SIZE. */
+#define heapFL_INDEX_MAX			( 24 )
+#define heapFL_INDEX_COUNT			( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapMAXIMUM_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_MAX )
+
+/* Set in the xBlockSize member of a block that is in the free lists.  Block
+sizes are multiples of portBYTE_ALIGNMENT, so the bit is not part of the size. */
+#define heapBLOCK_FREE_BIT			( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )	( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )	( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+
+/* The block that follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )	( ( TLSFBlock_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] portFAST_HEAP;
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+#if( configTOTAL_BULK_HEAP_SIZE > 0 )
+	static uint8_t ucBulkHeap[ configTOTAL_BULK_HEAP_SIZE ];
+#endif
+
+#if( configTOTAL_DMA_HEAP_SIZE > 0 )
+	static uint8_t ucDMAHeap[ configTOTAL_DMA_HEAP_SIZE ] portDMA_HEAP;
+#endif
+
+/* The header at the start of every block.  Only the first two members are kept
+while the block is allocated, the free list links occupy the start of the space
+handed to the application. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPreviousPhysicalBlock;	/*<< The block before this one in memory, NULL for the first block. */
+	size_t xBlockSize;								/*<< The size of the block including this header, plus heapBLOCK_FREE_BIT. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;			/*<< The next block in the same free list. */
+	struct A_TLSF_BLOCK *pxPreviousFreeBlock;		/*<< The previous block in the same free list. */
+} TLSFBlock_t;
+
+/* The free lists of one region, and the bitmaps of the lists that are not
+empty: bit n of ulFirstLevelBitmap is set if any of the lists in row n is not
+empty, bit m of ulSecondLevelBitmap[ n ] if list [ n ][ m ] is not empty. */
+typedef struct A_TLSF_REGION
+{
+	uint32_t ulFirstLevelBitmap;
+	uint32_t ulSecondLevelBitmap[ heapFL_INDEX_COUNT ];
+	TLSFBlock_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+	TLSFBlock_t *pxStart;							/*<< The first block of the region. */
+	TLSFBlock_t *pxEnd;								/*<< Marks the end of the region.  It has a size of zero and is never free, so the last block is never merged with it. */
+	HeapPlacement_t ePlacement;						/*<< The allocations the region serves first. */
+} TLSFRegion_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Makes the xTotalRegionSize bytes at pucRegion the next region of the heap,
+ * as a single free block.
+ */
+static void prvAddRegion( uint8_t *pucRegion, size_t xTotalRegionSize, HeapPlacement_t ePlacement );
+
+/*
+ * The implementation of pvPortMalloc() and pvPortMallocPlaced().  xAlignment
+ * is a power of two, at least portBYTE_ALIGNMENT.  pvCallSite is the return
+ * address recorded by heap tracking.
+ */
+static void *prvMalloc( size_t xWantedSize, HeapPlacement_t ePlacement, size_t xAlignment, void *pvCallSite );
+
+/*
+ * Takes a block of xWantedSize bytes, which includes the block header, from
+ * pxRegion, with the memory after the header aligned to xAlignment.  Returns
+ * NULL if the region has no block large enough.
+ */
+static void *prvAllocateFromRegion( TLSFRegion_t *pxRegion, size_t xWantedSize, size_t xAlignment );
+
+/*
+ * Returns the region that holds pxBlock.
+ */
+static TLSFRegion_t *prvRegionOfBlock( const TLSFBlock_t *pxBlock );
+
+/*
+ * Finds the first and second level indexes of the list that holds blocks of
+ * xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Finds a free block of at least xWantedSize bytes, or returns NULL.  The block
+ * is not taken out of its list.
+ */
+static TLSFBlock_t *prvSearchSuitableBlock( TLSFRegion_t *pxRegion, size_t xWantedSize );
+
+/*
+ * Add a block to, or take a block out of, the free list of its size in
+ * pxRegion.
+ */
+static void prvInsertFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock );
+
+/*
+ * Return the position of the least or the most significant bit set in ulBits,
+ * which must not be zero.
+ */
+static UBaseType_t prvFindFirstSet( uint32_t ulBits );
+static UBaseType_t prvFindLastSet( uint32_t ulBits );
+
+/*-----------------------------------------------------------*/
+
+/* The header at the start of each allocated block, rounded up so the memory
+after it is correctly aligned. */
+static const size_t xHeapStructSize	= ( offsetof( TLSFBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must hold the whole of a TLSFBlock_t. */
+static const size_t xMinimumBlockSize = ( sizeof( TLSFBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The regions, searched in order by prvMalloc().  xRegions[ 0 ] is ucHeap, and
+no region is set up until the first call to pvPortMalloc() or
+vPortDefineHeapRegions(). */
+static TLSFRegion_t xRegions[ configHEAP_MAX_REGIONS ] portFAST_BSS;
+static UBaseType_t uxRegionCount = 0U;
+
+/* Keeps track of the number of free bytes remaining in all the regions, but
+says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0U;
+static size_t xNumberOfSuccessfulFrees = 0U;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+	return prvMalloc( xWantedSize, eHeapFast, portBYTE_ALIGNMENT, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocPlaced( size_t xWantedSize, HeapPlacement_t ePlacement, size_t xAlignment )
+{
+	/* The alignment must be a power of two. */
+	configASSERT( ( xAlignment & ( xAlignment - 1 ) ) == 0 );
+
+	if( xAlignment < portBYTE_ALIGNMENT )
+	{
+		xAlignment = portBYTE_ALIGNMENT;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return prvMalloc( xWantedSize, ePlacement, xAlignment, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvMalloc( size_t xWantedSize, HeapPlacement_t ePlacement, size_t xAlignment, void *pvCallSite )
+{
+TLSFRegion_t *pxRegion;
+UBaseType_t uxRegion;
+HeapPlacement_t eSearched;
+BaseType_t xPass, xPasses;
+void *pvReturn = NULL;
+
+	/* Only used when configUSE_HEAP_TRACKING is 1. */
+	( void ) pvCallSite;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( uxRegionCount == 0U )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Requests the free lists cannot hold are rejected before the header
+		and alignment are added, so the additions cannot wrap. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAXIMUM_BLOCK_SIZE ) && ( xAlignment < heapMAXIMUM_BLOCK_SIZE ) )
+		{
+			/* The wanted size is increased so it can contain the block header
+			in addition to the requested amount of bytes, and so that blocks
+			are always aligned to the required number of bytes. */
+			xWantedSize += xHeapStructSize;
+
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize < xMinimumBlockSize )
+			{
+				xWantedSize = xMinimumBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize <= xFreeBytesRemaining )
+			{
+				/* The regions of the placement asked for are searched first,
+				in the order they were added.  Fast and bulk allocations then
+				fall back to each other's regions, DMA allocations never leave
+				the DMA region. */
+				eSearched = ePlacement;
+				xPasses = ( ePlacement == eHeapDMA ) ? 1 : 2;
+
+				for( xPass = 0; ( xPass < xPasses ) && ( pvReturn == NULL ); xPass++ )
+				{
+					for( uxRegion = 0U; ( uxRegion < uxRegionCount ) && ( pvReturn == NULL ); uxRegion++ )
+					{
+						pxRegion = &( xRegions[ uxRegion ] );
+
+						if( pxRegion->ePlacement == eSearched )
+						{
+							pvReturn = prvAllocateFromRegion( pxRegion, xWantedSize, xAlignment );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					eSearched = ( ePlacement == eHeapFast ) ? eHeapBulk : eHeapFast;
+				}
+
+				if( pvReturn != NULL )
+				{
+					heaptrackMALLOC( pvReturn, heapBLOCK_SIZE( ( TLSFBlock_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) ), pvCallSite );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( xAlignment - 1 ) ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocateFromRegion( TLSFRegion_t *pxRegion, size_t xWantedSize, size_t xAlignment )
+{
+TLSFBlock_t *pxBlock, *pxNewBlockLink;
+size_t xSearchSize = xWantedSize, xGap;
+void *pvReturn = NULL;
+
+	if( xAlignment > portBYTE_ALIGNMENT )
+	{
+		/* Room to move the block up to the next aligned address that leaves
+		space for a free block in front of it. */
+		xSearchSize += xAlignment + xMinimumBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxBlock = prvSearchSuitableBlock( pxRegion, xSearchSize );
+
+	if( pxBlock != NULL )
+	{
+		/* This block is being returned for use so must be taken out of the
+		free lists. */
+		prvRemoveFreeBlock( pxRegion, pxBlock );
+
+		if( xAlignment > portBYTE_ALIGNMENT )
+		{
+			xGap = ( xAlignment - ( ( ( size_t ) pxBlock + xHeapStructSize ) & ( xAlignment - 1 ) ) ) & ( xAlignment - 1 );
+
+			if( xGap != 0 )
+			{
+				while( xGap < xMinimumBlockSize )
+				{
+					xGap += xAlignment;
+				}
+
+				/* The space in front of the aligned block becomes a free block.
+				The block before it in memory is in use, otherwise it would have
+				been merged with the block found. */
+				pxNewBlockLink = pxBlock;
+				pxBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlockLink ) + xGap );
+				pxBlock->xBlockSize = heapBLOCK_SIZE( pxNewBlockLink ) - xGap;
+				pxBlock->pxPreviousPhysicalBlock = pxNewBlockLink;
+				heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPreviousPhysicalBlock = pxBlock;
+				pxNewBlockLink->xBlockSize = xGap;
+				prvInsertFreeBlock( pxRegion, pxNewBlockLink );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* If the block is larger than required it can be split into two. */
+		if( ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) >= xMinimumBlockSize )
+		{
+			/* The remainder follows the bytes requested.  The void cast is used
+			to prevent byte alignment warnings from the compiler. */
+			pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+			configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+			pxNewBlockLink->xBlockSize = heapBLOCK_SIZE( pxBlock ) - xWantedSize;
+			pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+			heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+			pxBlock->xBlockSize = xWantedSize;
+
+			/* The block after the remainder was in use, otherwise it would
+			have been merged with the block split, so the remainder goes
+			straight into the free lists. */
+			prvInsertFreeBlock( pxRegion, pxNewBlockLink );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock );
+
+		if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+		{
+			xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xNumberOfSuccessfulAllocations++;
+
+		/* Return the memory space pointed to - jumping over the block header
+		at its start. */
+		pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+TLSFBlock_t *pxBlock, *pxNeighbour;
+TLSFRegion_t *pxRegion;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a block header immediately before
+		it.  The void cast is used to prevent compiler warnings. */
+		puc -= xHeapStructSize;
+		pxBlock = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+		configASSERT( heapBLOCK_SIZE( pxBlock ) >= xMinimumBlockSize );
+
+		if( ( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE ) && ( heapBLOCK_SIZE( pxBlock ) >= xMinimumBlockSize ) )
+		{
+			vTaskSuspendAll();
+			{
+				pxRegion = prvRegionOfBlock( pxBlock );
+				configASSERT( pxRegion != NULL );
+
+				xFreeBytesRemaining += pxBlock->xBlockSize;
+				xNumberOfSuccessfulFrees++;
+				traceFREE( pv, pxBlock->xBlockSize );
+				heaptrackFREE( pv );
+
+				/* Merge the block with the block before it in memory if that
+				block is free... */
+				pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+				if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+				{
+					prvRemoveFreeBlock( pxRegion, pxNeighbour );
+					pxNeighbour->xBlockSize = heapBLOCK_SIZE( pxNeighbour ) + pxBlock->xBlockSize;
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* ...and with the block after it. */
+				pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+				if( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+				{
+					prvRemoveFreeBlock( pxRegion, pxNeighbour );
+					pxBlock->xBlockSize = heapBLOCK_SIZE( pxBlock ) + heapBLOCK_SIZE( pxNeighbour );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPreviousPhysicalBlock = pxBlock;
+				prvInsertFreeBlock( pxRegion, pxBlock );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetAllocationSize( void *pv )
+{
+TLSFBlock_t *pxBlock;
+
+	configASSERT( pv );
+
+	/* Aligned blocks also have their header immediately before the memory, as
+	the gap in front of them is split off as a free block. */
+	pxBlock = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+	configASSERT( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+
+	return heapBLOCK_SIZE( pxBlock ) - xHeapStructSize;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+const HeapRegion_t *pxHeapRegion;
+
+	vTaskSuspendAll();
+	{
+		/* ucHeap stays the first region, so it is still preferred. */
+		if( uxRegionCount == 0U )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+		{
+			prvAddRegion( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes, eHeapBulk );
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+TLSFBlock_t *pxBlock;
+TLSFRegion_t *pxRegion;
+UBaseType_t uxRegion, uxFirstLevel, uxSecondLevel;
+size_t xMaxSize = 0, xMinSize = heapMAXIMUM_BLOCK_SIZE;
+
+	vTaskSuspendAll();
+	{
+		for( uxRegion = 0U; uxRegion < uxRegionCount; uxRegion++ )
+		{
+			pxRegion = &( xRegions[ uxRegion ] );
+
+			if( pxRegion->ulFirstLevelBitmap != 0UL )
+			{
+				/* The largest block is in the last list that is not empty,
+				and the smallest in the first, so only those two lists are
+				walked. */
+				uxFirstLevel = prvFindLastSet( pxRegion->ulFirstLevelBitmap );
+				uxSecondLevel = prvFindLastSet( pxRegion->ulSecondLevelBitmap[ uxFirstLevel ] );
+
+				for( pxBlock = pxRegion->pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+					{
+						xMaxSize = heapBLOCK_SIZE( pxBlock );
+					}
+				}
+
+				uxFirstLevel = prvFindFirstSet( pxRegion->ulFirstLevelBitmap );
+				uxSecondLevel = prvFindFirstSet( pxRegion->ulSecondLevelBitmap[ uxFirstLevel ] );
+
+				for( pxBlock = pxRegion->pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+					{
+						xMinSize = heapBLOCK_SIZE( pxBlock );
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( xMaxSize == 0 )
+		{
+			/* There are no free blocks. */
+			xMinSize = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+		pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+	/* The fast region comes first so it is searched first. */
+	prvAddRegion( ucHeap, configTOTAL_HEAP_SIZE, eHeapFast );
+
+	#if( configTOTAL_BULK_HEAP_SIZE > 0 )
+	{
+		prvAddRegion( ucBulkHeap, configTOTAL_BULK_HEAP_SIZE, eHeapBulk );
+	}
+	#endif
+
+	#if( configTOTAL_DMA_HEAP_SIZE > 0 )
+	{
+		portCONFIGURE_DMA_REGION( ucDMAHeap, configTOTAL_DMA_HEAP_SIZE );
+		prvAddRegion( ucDMAHeap, configTOTAL_DMA_HEAP_SIZE, eHeapDMA );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRegion( uint8_t *pucRegion, size_t xTotalRegionSize, HeapPlacement_t ePlacement )
+{
+TLSFRegion_t *pxRegion;
+TLSFBlock_t *pxFirstFreeBlock;
+uint8_t *pucAlignedRegion;
+size_t uxAddress;
+
+	configASSERT( uxRegionCount < ( UBaseType_t ) configHEAP_MAX_REGIONS );
+
+	if( uxRegionCount < ( UBaseType_t ) configHEAP_MAX_REGIONS )
+	{
+		/* Ensure the region starts on a correctly aligned boundary. */
+		uxAddress = ( size_t ) pucRegion;
+
+		if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			uxAddress += ( portBYTE_ALIGNMENT - 1 );
+			uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+			xTotalRegionSize -= uxAddress - ( size_t ) pucRegion;
+		}
+
+		pucAlignedRegion = ( uint8_t * ) uxAddress;
+
+		/* A block must be smaller than the free lists can hold, so the part of
+		a larger region beyond that is left unused. */
+		if( xTotalRegionSize >= heapMAXIMUM_BLOCK_SIZE )
+		{
+			xTotalRegionSize = heapMAXIMUM_BLOCK_SIZE - portBYTE_ALIGNMENT;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxRegion = &( xRegions[ uxRegionCount ] );
+
+		/* pxEnd is used to mark the end of the region and is placed at the end
+		of the region's space. */
+		uxAddress = ( ( size_t ) pucAlignedRegion ) + xTotalRegionSize;
+		uxAddress -= xHeapStructSize;
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		pxRegion->pxEnd = ( void * ) uxAddress;
+
+		/* To start with there is a single free block that is sized to take up
+		the entire region, minus the space taken by pxEnd. */
+		pxFirstFreeBlock = ( void * ) pucAlignedRegion;
+		pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+		pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+		pxRegion->pxStart = pxFirstFreeBlock;
+		pxRegion->ePlacement = ePlacement;
+
+		pxRegion->pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+		pxRegion->pxEnd->xBlockSize = 0;
+
+		xFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+		xMinimumEverFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+
+		prvInsertFreeBlock( pxRegion, pxFirstFreeBlock );
+		uxRegionCount++;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TLSFRegion_t *prvRegionOfBlock( const TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxRegion;
+TLSFRegion_t *pxReturn = NULL;
+
+	for( uxRegion = 0U; uxRegion < uxRegionCount; uxRegion++ )
+	{
+		if( ( pxBlock >= xRegions[ uxRegion ].pxStart ) && ( pxBlock < xRegions[ uxRegion ].pxEnd ) )
+		{
+			pxReturn = &( xRegions[ uxRegion ] );
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* The small blocks are divided linearly. */
+		uxFirstLevel = 0;
+		uxSecondLevel = ( UBaseType_t ) ( xBlockSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+	}
+	else
+	{
+		/* The bits below the most significant bit give the second level. */
+		uxFirstLevel = prvFindLastSet( ( uint32_t ) xBlockSize );
+		uxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxFirstLevel - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+		uxFirstLevel -= ( heapFL_INDEX_SHIFT - 1 );
+	}
+
+	*puxFirstLevel = uxFirstLevel;
+	*puxSecondLevel = uxSecondLevel;
+}
+/*-----------------------------------------------------------*/
+
+static TLSFBlock_t *prvSearchSuitableBlock( TLSFRegion_t *pxRegion, size_t xWantedSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+
+	/* Round the size up to the next size class, so every block in the list it
+	maps to is large enough and the first one can be taken. */
+	if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xWantedSize += ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel >= heapFL_INDEX_COUNT )
+	{
+		return NULL;
+	}
+
+	/* A list in the same row at or above the second level index... */
+	ulBitmap = pxRegion->ulSecondLevelBitmap[ uxFirstLevel ] & ( ~( uint32_t ) 0UL << uxSecondLevel );
+
+	if( ulBitmap == 0UL )
+	{
+		/* ...or the first list of a higher row. */
+		ulBitmap = pxRegion->ulFirstLevelBitmap & ( ~( uint32_t ) 0UL << ( uxFirstLevel + 1 ) );
+
+		if( ulBitmap == 0UL )
+		{
+			return NULL;
+		}
+
+		uxFirstLevel = prvFindFirstSet( ulBitmap );
+		ulBitmap = pxRegion->ulSecondLevelBitmap[ uxFirstLevel ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	uxSecondLevel = prvFindFirstSet( ulBitmap );
+
+	return pxRegion->pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+TLSFBlock_t *pxHead;
+
+	prvMappingInsert( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	pxHead = pxRegion->pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	pxBlock->pxNextFreeBlock = pxHead;
+	pxBlock->pxPreviousFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxRegion->pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	pxRegion->ulFirstLevelBitmap |= ( uint32_t ) 1UL << uxFirstLevel;
+	pxRegion->ulSecondLevelBitmap[ uxFirstLevel ] |= ( uint32_t ) 1UL << uxSecondLevel;
+
+	pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+	xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the head of its list.  Clear the bitmaps as the list,
+		and then the row, become empty. */
+		pxRegion->pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			pxRegion->ulSecondLevelBitmap[ uxFirstLevel ] &= ~( ( uint32_t ) 1UL << uxSecondLevel );
+
+			if( pxRegion->ulSecondLevelBitmap[ uxFirstLevel ] == 0UL )
+			{
+				pxRegion->ulFirstLevelBitmap &= ~( ( uint32_t ) 1UL << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+	xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( uint32_t ulBits )
+{
+	/* Isolate the least significant set bit, then find it as the most
+	significant. */
+	return prvFindLastSet( ulBits & ( ( ( uint32_t ) 0UL ) - ulBits ) );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulBits )
+{
+UBaseType_t uxBit;
+
+	#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+	{
+		/* The port's ready priority lookup finds the most significant set bit
+		with a single instruction. */
+		portGET_HIGHEST_PRIORITY( uxBit, ulBits );
+	}
+	#else
+	{
+		uxBit = 0;
+
+		while( ( ulBits >>= 1 ) != ( uint32_t ) 0UL )
+		{
+			uxBit++;
+		}
+	}
+	#endif
+
+	return uxBit;
+}
+
+#endif /* configUSE_TLSF_HEAP */
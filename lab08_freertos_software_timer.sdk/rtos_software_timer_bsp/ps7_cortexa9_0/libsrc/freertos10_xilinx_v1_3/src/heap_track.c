@@ -0,0 +1,697 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_track.h"
+#include "object_pool.h"
+
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+	#include <stdio.h>
+#endif
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include heap tracking.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_HEAP_TRACKING == 1 )
+
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error Heap tracking requires xTaskGetCurrentTaskHandle().  Set INCLUDE_xTaskGetCurrentTaskHandle to 1 in FreeRTOSConfig.h.
+#endif
+
+#if( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+	#error Heap tracking requires xTaskGetSchedulerState().  Set INCLUDE_xTaskGetSchedulerState to 1 in FreeRTOSConfig.h.
+#endif
+
+/* Blocks are hashed on their address.  Every block is aligned to at least
+eight bytes, so the three least significant bits carry no information. */
+#define htHASH_BLOCK( pv )	( ( UBaseType_t ) ( ( ( ( size_t ) ( pv ) ) >> 3U ) % ( size_t ) configHEAP_TRACKING_MAX_BLOCKS ) )
+
+/* The entry that collects the allocations made before the scheduler was
+started, and by the tasks that did not fit in the task table. */
+#define htUNKNOWN_TASK_INDEX	0
+
+/* The number of call sites vHeapTrackList() lists individually. */
+#define htLIST_SITES			32
+
+/* An entry in the side table.  pvBlock is NULL if the entry is not used. */
+typedef struct xTRACKED_BLOCK
+{
+	void *pvBlock;
+	void *pvCallSite;
+	TaskHandle_t xOwner;
+	uint32_t ulBlockSize;
+} TrackedBlock_t;
+
+/* The allocation rate of one task. */
+typedef struct xTRACKED_TASK
+{
+	TaskHandle_t xTask;
+	BaseType_t xInUse;
+	uint32_t ulAllocations;
+	uint32_t ulPeriodAllocations;	/* The allocations made since xPeriodStart. */
+	TickType_t xPeriodStart;		/* The tick count at which the current period started. */
+	uint32_t ulRateHistogram[ heaptrackRATE_BUCKETS ];
+} TrackedTask_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the task table entry of xTask, claiming a free entry if xTask has
+ * not allocated before.  Returns the entry for unknown tasks if xTask is NULL
+ * or the table is full.
+ */
+static TrackedTask_t *prvGetTask( TaskHandle_t xTask, TickType_t xNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the periods that have ended by xNow to the histogram of pxTask.
+ */
+static void prvClosePeriods( TrackedTask_t *pxTask, TickType_t xNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the histogram bucket that counts periods with ulAllocations
+ * allocations.
+ */
+static UBaseType_t prvGetBucket( uint32_t ulAllocations ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the side table entry of the block pv, or
+ * configHEAP_TRACKING_MAX_BLOCKS if the block is not tracked.
+ */
+static UBaseType_t prvFindBlock( const void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the entry at uxIndex from the side table, moving the entries that
+ * follow it back so that no search is cut short by the hole.
+ */
+static void prvRemoveBlock( UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+PRIVILEGED_DATA static TrackedBlock_t xBlocks[ configHEAP_TRACKING_MAX_BLOCKS ];
+PRIVILEGED_DATA static TrackedTask_t xTasks[ configHEAP_TRACKING_MAX_TASKS + 1 ];
+PRIVILEGED_DATA static UBaseType_t uxTrackedBlocks = 0U;
+PRIVILEGED_DATA static uint32_t ulUntrackedAllocations = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vHeapTrackMalloc( void *pv, size_t xBlockSize, void *pvCallSite )
+{
+TrackedTask_t *pxTask;
+TaskHandle_t xOwner = NULL;
+UBaseType_t uxIndex;
+TickType_t xNow;
+
+	/* Allocations made before the scheduler is started are made by the
+	application's start up code rather than by a task, even though there may
+	already be a current task. */
+	if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+	{
+		xOwner = xTaskGetCurrentTaskHandle();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xNow = xTaskGetTickCount();
+	pxTask = prvGetTask( xOwner, xNow );
+	prvClosePeriods( pxTask, xNow );
+	( pxTask->ulAllocations )++;
+	( pxTask->ulPeriodAllocations )++;
+
+	if( uxTrackedBlocks < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS )
+	{
+		/* Open addressing with linear probing.  The table is not full, so a
+		free entry will be found. */
+		uxIndex = htHASH_BLOCK( pv );
+
+		while( xBlocks[ uxIndex ].pvBlock != NULL )
+		{
+			uxIndex++;
+
+			if( uxIndex >= ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS )
+			{
+				uxIndex = 0;
+			}
+		}
+
+		xBlocks[ uxIndex ].pvBlock = pv;
+		xBlocks[ uxIndex ].pvCallSite = pvCallSite;
+		xBlocks[ uxIndex ].xOwner = pxTask->xTask;
+		xBlocks[ uxIndex ].ulBlockSize = ( uint32_t ) xBlockSize;
+		uxTrackedBlocks++;
+	}
+	else
+	{
+		ulUntrackedAllocations++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackFree( void *pv )
+{
+const UBaseType_t uxIndex = prvFindBlock( pv );
+
+	if( uxIndex < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS )
+	{
+		prvRemoveBlock( uxIndex );
+	}
+	else
+	{
+		/* The block was allocated while the table was full. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackSetCallSite( void *pv, void *pvCallSite )
+{
+UBaseType_t uxIndex;
+
+	/* A block taken from an object pool is not a block of the heap, and the
+	first block of a pool has the address of the heap block the pool was
+	carved from, which must stay charged to the pool. */
+	#if( configUSE_OBJECT_POOLS == 1 )
+	{
+		if( xObjectPoolIsPoolBlock( pv ) != pdFALSE )
+		{
+			pv = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	if( pv != NULL )
+	{
+		/* Unlike the other functions in this file this is called from outside
+		the heap, so it has to keep the heap from changing the table itself. */
+		vTaskSuspendAll();
+		{
+			uxIndex = prvFindBlock( pv );
+
+			if( uxIndex < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS )
+			{
+				xBlocks[ uxIndex ].pvCallSite = pvCallSite;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackTaskDeleted( TaskHandle_t xTask )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 1; uxIndex <= ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS; uxIndex++ )
+	{
+		if( ( xTasks[ uxIndex ].xInUse != pdFALSE ) && ( xTasks[ uxIndex ].xTask == xTask ) )
+		{
+			memset( ( void * ) &( xTasks[ uxIndex ] ), 0x00, sizeof( TrackedTask_t ) );
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* The handle may be given to a task created later, so the blocks the
+	deleted task did not free are moved to the unknown task. */
+	for( uxIndex = 0; uxIndex < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS; uxIndex++ )
+	{
+		if( ( xBlocks[ uxIndex ].pvBlock != NULL ) && ( xBlocks[ uxIndex ].xOwner == xTask ) )
+		{
+			xBlocks[ uxIndex ].xOwner = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TrackedTask_t *prvGetTask( TaskHandle_t xTask, TickType_t xNow )
+{
+UBaseType_t uxIndex;
+TrackedTask_t *pxTask = &( xTasks[ htUNKNOWN_TASK_INDEX ] ), *pxFree = NULL;
+
+	if( xTask != NULL )
+	{
+		for( uxIndex = 1; uxIndex <= ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS; uxIndex++ )
+		{
+			if( xTasks[ uxIndex ].xInUse == pdFALSE )
+			{
+				if( pxFree == NULL )
+				{
+					pxFree = &( xTasks[ uxIndex ] );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( xTasks[ uxIndex ].xTask == xTask )
+			{
+				pxFree = NULL;
+				pxTask = &( xTasks[ uxIndex ] );
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Entries are freed when their task is deleted, so the task may be
+		found after a free entry. */
+		if( pxFree != NULL )
+		{
+			pxFree->xTask = xTask;
+			pxFree->xInUse = pdTRUE;
+			pxFree->xPeriodStart = xNow;
+			pxTask = pxFree;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxTask;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindBlock( const void *pv )
+{
+UBaseType_t uxIndex, uxProbes, uxReturn = ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS;
+
+	uxIndex = htHASH_BLOCK( pv );
+
+	for( uxProbes = 0; uxProbes < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS; uxProbes++ )
+	{
+		if( xBlocks[ uxIndex ].pvBlock == pv )
+		{
+			uxReturn = uxIndex;
+			break;
+		}
+		else if( xBlocks[ uxIndex ].pvBlock == NULL )
+		{
+			break;
+		}
+		else
+		{
+			uxIndex++;
+
+			if( uxIndex >= ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS )
+			{
+				uxIndex = 0;
+			}
+		}
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvClosePeriods( TrackedTask_t *pxTask, TickType_t xNow )
+{
+/* Unsigned arithmetic handles the tick count wrapping. */
+const TickType_t xElapsed = xNow - pxTask->xPeriodStart;
+uint32_t ulPeriods;
+
+	if( xElapsed >= ( TickType_t ) configHEAP_TRACKING_RATE_PERIOD )
+	{
+		ulPeriods = ( uint32_t ) ( xElapsed / ( TickType_t ) configHEAP_TRACKING_RATE_PERIOD );
+
+		/* The period that was being counted, then the periods that ended
+		without an allocation. */
+		( pxTask->ulRateHistogram[ prvGetBucket( pxTask->ulPeriodAllocations ) ] )++;
+		pxTask->ulRateHistogram[ 0 ] += ulPeriods - 1UL;
+
+		pxTask->ulPeriodAllocations = 0UL;
+		pxTask->xPeriodStart += ( TickType_t ) ( ulPeriods * ( uint32_t ) configHEAP_TRACKING_RATE_PERIOD );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetBucket( uint32_t ulAllocations )
+{
+UBaseType_t uxBucket;
+
+	if( ulAllocations == 0UL )
+	{
+		uxBucket = 0;
+	}
+	else
+	{
+		/* One more than the index of the most significant set bit. */
+		uxBucket = ( UBaseType_t ) ( 32UL - ( uint32_t ) __builtin_clz( ulAllocations ) );
+
+		if( uxBucket >= ( UBaseType_t ) heaptrackRATE_BUCKETS )
+		{
+			uxBucket = ( UBaseType_t ) heaptrackRATE_BUCKETS - 1U;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxBucket;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlock( UBaseType_t uxIndex )
+{
+UBaseType_t uxNext = uxIndex, uxHome, uxProbes;
+
+	/* The search ends at the first unused entry, or after coming back round
+	to the hole if the table was full. */
+	for( uxProbes = 1; uxProbes < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS; uxProbes++ )
+	{
+		uxNext++;
+
+		if( uxNext >= ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS )
+		{
+			uxNext = 0;
+		}
+
+		if( xBlocks[ uxNext ].pvBlock == NULL )
+		{
+			break;
+		}
+
+		/* The entry at uxNext can fill the hole at uxIndex unless its home
+		slot lies cyclically after the hole, in which case moving it would put
+		it before its home and searches for it would fail. */
+		uxHome = htHASH_BLOCK( xBlocks[ uxNext ].pvBlock );
+
+		if( ( ( uxNext > uxIndex ) && ( ( uxHome <= uxIndex ) || ( uxHome > uxNext ) ) ) ||
+			( ( uxNext < uxIndex ) && ( uxHome <= uxIndex ) && ( uxHome > uxNext ) ) )
+		{
+			xBlocks[ uxIndex ] = xBlocks[ uxNext ];
+			uxIndex = uxNext;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	xBlocks[ uxIndex ].pvBlock = NULL;
+	uxTrackedBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTrackGetSites( HeapTrackSite_t *pxSiteArray, const UBaseType_t uxArraySize )
+{
+UBaseType_t uxIndex, x, uxWritten = 0, uxSorted;
+HeapTrackSite_t *pxSite, xSite;
+
+	configASSERT( pxSiteArray );
+
+	if( uxArraySize > 0U )
+	{
+		vTaskSuspendAll();
+		{
+			for( uxIndex = 0; uxIndex < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS; uxIndex++ )
+			{
+				if( xBlocks[ uxIndex ].pvBlock != NULL )
+				{
+					pxSite = NULL;
+
+					for( x = 0; x < uxWritten; x++ )
+					{
+						if( pxSiteArray[ x ].pvCallSite == xBlocks[ uxIndex ].pvCallSite )
+						{
+							pxSite = &( pxSiteArray[ x ] );
+							break;
+						}
+					}
+
+					if( pxSite == NULL )
+					{
+						if( uxWritten < ( uxArraySize - 1U ) )
+						{
+							pxSite = &( pxSiteArray[ uxWritten ] );
+							pxSite->pvCallSite = xBlocks[ uxIndex ].pvCallSite;
+						}
+						else
+						{
+							/* The last entry collects the blocks of the call
+							sites that do not fit. */
+							pxSite = &( pxSiteArray[ uxArraySize - 1U ] );
+							pxSite->pvCallSite = NULL;
+						}
+
+						/* The entry is new unless it is the last entry being
+						used again. */
+						if( uxWritten < uxArraySize )
+						{
+							pxSite->uxLiveBlocks = 0;
+							pxSite->xLiveBytes = 0;
+							uxWritten++;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					( pxSite->uxLiveBlocks )++;
+					pxSite->xLiveBytes += ( size_t ) xBlocks[ uxIndex ].ulBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		/* Insertion sort, largest first, leaving the overflow entry, if any,
+		at the end. */
+		uxSorted = uxWritten;
+
+		if( ( uxWritten > 0U ) && ( pxSiteArray[ uxWritten - 1U ].pvCallSite == NULL ) )
+		{
+			uxSorted--;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( uxIndex = 1; uxIndex < uxSorted; uxIndex++ )
+		{
+			xSite = pxSiteArray[ uxIndex ];
+
+			for( x = uxIndex; ( x > 0U ) && ( pxSiteArray[ x - 1U ].xLiveBytes < xSite.xLiveBytes ); x-- )
+			{
+				pxSiteArray[ x ] = pxSiteArray[ x - 1U ];
+			}
+
+			pxSiteArray[ x ] = xSite;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxWritten;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTrackGetTasks( HeapTrackTask_t *pxTaskArray, const UBaseType_t uxArraySize )
+{
+UBaseType_t uxIndex, x, uxWritten = 0;
+TickType_t xNow;
+
+	configASSERT( pxTaskArray );
+
+	vTaskSuspendAll();
+	{
+		xNow = xTaskGetTickCount();
+
+		for( uxIndex = 0; ( uxIndex <= ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS ) && ( uxWritten < uxArraySize ); uxIndex++ )
+		{
+			/* The entry for unknown tasks is always written. */
+			if( ( uxIndex == htUNKNOWN_TASK_INDEX ) || ( xTasks[ uxIndex ].xInUse != pdFALSE ) )
+			{
+				prvClosePeriods( &( xTasks[ uxIndex ] ), xNow );
+
+				pxTaskArray[ uxWritten ].xTask = xTasks[ uxIndex ].xTask;
+				pxTaskArray[ uxWritten ].ulAllocations = xTasks[ uxIndex ].ulAllocations;
+				pxTaskArray[ uxWritten ].uxLiveBlocks = 0;
+				pxTaskArray[ uxWritten ].xLiveBytes = 0;
+				memcpy( ( void * ) pxTaskArray[ uxWritten ].ulRateHistogram, ( void * ) xTasks[ uxIndex ].ulRateHistogram, sizeof( xTasks[ uxIndex ].ulRateHistogram ) );
+				uxWritten++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		for( uxIndex = 0; uxIndex < ( UBaseType_t ) configHEAP_TRACKING_MAX_BLOCKS; uxIndex++ )
+		{
+			if( xBlocks[ uxIndex ].pvBlock != NULL )
+			{
+				for( x = 0; x < uxWritten; x++ )
+				{
+					if( pxTaskArray[ x ].xTask == xBlocks[ uxIndex ].xOwner )
+					{
+						( pxTaskArray[ x ].uxLiveBlocks )++;
+						pxTaskArray[ x ].xLiveBytes += ( size_t ) xBlocks[ uxIndex ].ulBlockSize;
+						break;
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxWritten;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulHeapTrackGetUntracked( void )
+{
+	/* A 32-bit read is atomic on this architecture. */
+	return ulUntrackedAllocations;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackResetRates( void )
+{
+UBaseType_t uxIndex;
+const TickType_t xNow = xTaskGetTickCount();
+
+	vTaskSuspendAll();
+	{
+		for( uxIndex = 0; uxIndex <= ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS; uxIndex++ )
+		{
+			xTasks[ uxIndex ].ulAllocations = 0UL;
+			xTasks[ uxIndex ].ulPeriodAllocations = 0UL;
+			xTasks[ uxIndex ].xPeriodStart = xNow;
+			memset( ( void * ) xTasks[ uxIndex ].ulRateHistogram, 0x00, sizeof( xTasks[ uxIndex ].ulRateHistogram ) );
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+	void vHeapTrackList( char *pcWriteBuffer )
+	{
+	static HeapTrackSite_t xSiteCopy[ htLIST_SITES ];
+	static HeapTrackTask_t xTaskCopy[ configHEAP_TRACKING_MAX_TASKS + 1 ];
+	UBaseType_t uxSites, uxTasks, x, uxBucket;
+	const char *pcName;
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Copy the data out first, so the formatting below is done with the
+		scheduler running.  The static copies avoid placing the tables on the
+		calling task's stack, so this function is not reentrant. */
+		uxSites = uxHeapTrackGetSites( xSiteCopy, ( UBaseType_t ) htLIST_SITES );
+		uxTasks = uxHeapTrackGetTasks( xTaskCopy, ( UBaseType_t ) ( configHEAP_TRACKING_MAX_TASKS + 1 ) );
+
+		for( x = 0; x < uxSites; x++ )
+		{
+			sprintf( pcWriteBuffer, "0x%08x\t%u\t%u\r\n", ( unsigned int ) ( size_t ) xSiteCopy[ x ].pvCallSite, ( unsigned int ) xSiteCopy[ x ].uxLiveBlocks, ( unsigned int ) xSiteCopy[ x ].xLiveBytes ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+			pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+		}
+
+		for( x = 0; x < uxTasks; x++ )
+		{
+			pcName = ( xTaskCopy[ x ].xTask != NULL ) ? pcTaskGetName( xTaskCopy[ x ].xTask ) : "-";
+			sprintf( pcWriteBuffer, "%s\t%u\t%u", pcName, ( unsigned int ) xTaskCopy[ x ].ulAllocations, ( unsigned int ) xTaskCopy[ x ].xLiveBytes ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+			pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+
+			for( uxBucket = 0; uxBucket < ( UBaseType_t ) heaptrackRATE_BUCKETS; uxBucket++ )
+			{
+				sprintf( pcWriteBuffer, "\t%u", ( unsigned int ) xTaskCopy[ x ].ulRateHistogram[ uxBucket ] ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+			}
+
+			sprintf( pcWriteBuffer, "\r\n" ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+			pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+		}
+	}
+
+#endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
+
+/* This entire source file will be skipped if the application is not configured
+to include heap tracking.  If you want to include heap tracking then ensure
+configUSE_HEAP_TRACKING is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_HEAP_TRACKING == 1 */
@@ -0,0 +1,310 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Routes newlib's malloc() family into the FreeRTOS heap.
+ *
+ * Without this file newlib's malloc() takes its memory from the .heap section
+ * of lscript.ld through _sbrk(), separately from the FreeRTOS heap, and is not
+ * safe to call from more than one task as __malloc_lock() does nothing unless
+ * newlib was built with locking.  With configUSE_NEWLIB_MALLOC_BRIDGE set to 1
+ * in FreeRTOSConfig.h the functions below replace newlib's, both the standard
+ * functions and the reentrant _r versions newlib itself calls (from stdio, for
+ * example), so every allocation is made by pvPortMalloc() and is serialised by
+ * the heap's own scheduler suspension.  One heap then serves both, and the
+ * .heap section can be made empty.
+ *
+ * When the TLSF heap is used the allocations are placed in the bulk regions,
+ * so they only use the fast region once the bulk regions are full.
+ *
+ * As with newlib's malloc(), none of these functions may be called from an
+ * interrupt.  The rest of newlib's reentrancy is still governed by
+ * configUSE_NEWLIB_REENTRANT.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+#include <reent.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_track.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to route newlib's malloc() into the FreeRTOS heap.  This #if is closed at the
+very bottom of this file. */
+#if( configUSE_NEWLIB_MALLOC_BRIDGE == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error configUSE_NEWLIB_MALLOC_BRIDGE requires configSUPPORT_DYNAMIC_ALLOCATION to be 1
+#endif
+
+/*
+ * The implementations of the functions below.  Each public function passes its
+ * own return address as pvCallSite, so heap tracking charges the block to the
+ * caller of malloc() or _malloc_r() rather than to this file.
+ */
+static void *prvMallocFrom( size_t xSize, void *pvCallSite );
+static void *prvCallocFrom( size_t xCount, size_t xSize, void *pvCallSite );
+static void *prvReallocFrom( void *pv, size_t xSize, void *pvCallSite );
+static void *prvMemalignFrom( size_t xAlignment, size_t xSize, void *pvCallSite );
+
+/*
+ * Allocates xSize bytes aligned to xAlignment, a power of two, from the
+ * FreeRTOS heap.
+ */
+static void *prvMalloc( size_t xSize, size_t xAlignment, void *pvCallSite );
+
+/*-----------------------------------------------------------*/
+
+void *_malloc_r( struct _reent *pxReent, size_t xSize )
+{
+	( void ) pxReent;
+	return prvMallocFrom( xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void _free_r( struct _reent *pxReent, void *pv )
+{
+	( void ) pxReent;
+	vPortFree( pv );
+}
+/*-----------------------------------------------------------*/
+
+void *_calloc_r( struct _reent *pxReent, size_t xCount, size_t xSize )
+{
+	( void ) pxReent;
+	return prvCallocFrom( xCount, xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void *_realloc_r( struct _reent *pxReent, void *pv, size_t xSize )
+{
+	( void ) pxReent;
+	return prvReallocFrom( pv, xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void *_memalign_r( struct _reent *pxReent, size_t xAlignment, size_t xSize )
+{
+	( void ) pxReent;
+	return prvMemalignFrom( xAlignment, xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+size_t _malloc_usable_size_r( struct _reent *pxReent, void *pv )
+{
+	( void ) pxReent;
+
+	return ( pv != NULL ) ? xPortGetAllocationSize( pv ) : 0;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvMallocFrom( size_t xSize, void *pvCallSite )
+{
+	/* pvPortMalloc() returns NULL for zero bytes, where malloc() may return a
+	unique pointer. */
+	if( xSize == 0 )
+	{
+		xSize = 1;
+	}
+
+	return prvMalloc( xSize, portBYTE_ALIGNMENT, pvCallSite );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvCallocFrom( size_t xCount, size_t xSize, void *pvCallSite )
+{
+void *pvReturn = NULL;
+
+	/* Reject requests whose size does not fit in a size_t. */
+	if( ( xSize == 0 ) || ( xCount <= ( ( ( size_t ) -1 ) / xSize ) ) )
+	{
+		pvReturn = prvMallocFrom( xCount * xSize, pvCallSite );
+
+		if( pvReturn != NULL )
+		{
+			memset( pvReturn, 0x00, xCount * xSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvReallocFrom( void *pv, size_t xSize, void *pvCallSite )
+{
+void *pvReturn = NULL;
+size_t xOldSize;
+
+	if( pv == NULL )
+	{
+		pvReturn = prvMallocFrom( xSize, pvCallSite );
+	}
+	else if( xSize == 0 )
+	{
+		vPortFree( pv );
+	}
+	else
+	{
+		xOldSize = xPortGetAllocationSize( pv );
+
+		if( xSize <= xOldSize )
+		{
+			/* The block is not shrunk, as neither heap can split an
+			allocated block. */
+			pvReturn = pv;
+		}
+		else
+		{
+			pvReturn = prvMallocFrom( xSize, pvCallSite );
+
+			/* The old block is left as it is if the new one cannot be
+			allocated. */
+			if( pvReturn != NULL )
+			{
+				memcpy( pvReturn, pv, xOldSize );
+				vPortFree( pv );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvMemalignFrom( size_t xAlignment, size_t xSize, void *pvCallSite )
+{
+	if( xSize == 0 )
+	{
+		xSize = 1;
+	}
+
+	if( xAlignment < portBYTE_ALIGNMENT )
+	{
+		xAlignment = portBYTE_ALIGNMENT;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return prvMalloc( xSize, xAlignment, pvCallSite );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvMalloc( size_t xSize, size_t xAlignment, void *pvCallSite )
+{
+void *pvReturn;
+
+	#if( configUSE_TLSF_HEAP == 1 )
+	{
+		pvReturn = pvPortMallocPlaced( xSize, eHeapBulk, xAlignment );
+	}
+	#else
+	{
+		/* heap_4.c only aligns to portBYTE_ALIGNMENT. */
+		configASSERT( xAlignment <= portBYTE_ALIGNMENT );
+		( void ) xAlignment;
+		pvReturn = pvPortMalloc( xSize );
+	}
+	#endif
+
+	heaptrackSET_CALL_SITE( pvReturn, pvCallSite );
+
+	/* Only used when configUSE_HEAP_TRACKING is 1. */
+	( void ) pvCallSite;
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+/* The standard functions are defined here too, rather than left to newlib's
+wrappers, so no object from newlib's malloc implementation is ever linked in
+alongside the functions above. */
+
+void *malloc( size_t xSize )
+{
+	return prvMallocFrom( xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void free( void *pv )
+{
+	_free_r( _REENT, pv );
+}
+/*-----------------------------------------------------------*/
+
+void *calloc( size_t xCount, size_t xSize )
+{
+	return prvCallocFrom( xCount, xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void *realloc( void *pv, size_t xSize )
+{
+	return prvReallocFrom( pv, xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+void *memalign( size_t xAlignment, size_t xSize )
+{
+	return prvMemalignFrom( xAlignment, xSize, heaptrackCALL_SITE() );
+}
+/*-----------------------------------------------------------*/
+
+size_t malloc_usable_size( void *pv )
+{
+	return _malloc_usable_size_r( _REENT, pv );
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to route newlib's malloc() into the FreeRTOS heap.  If you want to route it
+then ensure configUSE_NEWLIB_MALLOC_BRIDGE is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_NEWLIB_MALLOC_BRIDGE == 1 */
@@ -0,0 +1,323 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "object_pool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include object pools.  This #if is closed at the very bottom of this file. */
+#if( configUSE_OBJECT_POOLS == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use object pools
+#endif
+
+#ifndef configOBJECT_POOL_CLASSES
+	#error configOBJECT_POOL_CLASSES must be defined in FreeRTOSConfig.h to use object pools
+#endif
+
+/* The blocks, and the requests the pools cannot serve, are aligned as the
+TCBs and queues that may be placed in them. */
+#if( portCONTROL_BLOCK_ALIGNMENT > portBYTE_ALIGNMENT )
+	#define poolHEAP_MALLOC( xSize )	pvPortMallocPlaced( ( xSize ), eHeapFast, portCONTROL_BLOCK_ALIGNMENT )
+#else
+	#define poolHEAP_MALLOC( xSize )	pvPortMalloc( xSize )
+#endif
+
+#define poolBLOCK_ALIGNMENT_MASK	( ( size_t ) portCONTROL_BLOCK_ALIGNMENT - ( size_t ) 1 )
+
+/* One entry of configOBJECT_POOL_CLASSES. */
+typedef struct ObjectPoolClass
+{
+	size_t xBlockSize;
+	UBaseType_t uxBlockCount;
+} ObjectPoolClass_t;
+
+/* A free block.  Lives in the block itself. */
+typedef struct ObjectPoolBlock
+{
+	struct ObjectPoolBlock *pxNext;
+} ObjectPoolBlock_t;
+
+typedef struct ObjectPool
+{
+	ObjectPoolBlock_t *pxFreeBlocks;	/* The free blocks, last freed first. */
+	uint8_t *pucStart;					/* The blocks of the pool, used to find the */
+	uint8_t *pucEnd;					/* pool a freed block belongs to. */
+	ObjectPoolStats_t xStats;
+} ObjectPool_t;
+
+static const ObjectPoolClass_t xPoolClasses[] = { configOBJECT_POOL_CLASSES };
+
+#define poolCOUNT	( sizeof( xPoolClasses ) / sizeof( xPoolClasses[ 0 ] ) )
+
+/* The pools, sorted by block size when they are carved. */
+static ObjectPool_t xPools[ poolCOUNT ];
+static BaseType_t xPoolsCarved = pdFALSE;
+
+/*
+ * Allocates the blocks of every pool from the heap and threads them onto the
+ * pools' free lists.  Called by the first allocation.
+ */
+static void prvCarvePools( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the pool that holds pv, or NULL if pv came from the heap.
+ */
+static ObjectPool_t *prvPoolOfBlock( const void *pv ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void *pvObjectPoolMalloc( size_t xSize )
+{
+ObjectPool_t *pxPool = NULL;
+ObjectPoolBlock_t *pxBlock = NULL;
+UBaseType_t uxPool;
+
+	if( xPoolsCarved == pdFALSE )
+	{
+		vTaskSuspendAll();
+		{
+			if( xPoolsCarved == pdFALSE )
+			{
+				prvCarvePools();
+				xPoolsCarved = pdTRUE;
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+	/* The pools are in increasing block size, so the first that is large
+	enough wastes the least. */
+	for( uxPool = 0; uxPool < ( UBaseType_t ) poolCOUNT; uxPool++ )
+	{
+		if( xPools[ uxPool ].xStats.xBlockSize >= xSize )
+		{
+			pxPool = &( xPools[ uxPool ] );
+			break;
+		}
+	}
+
+	if( pxPool != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxBlock = pxPool->pxFreeBlocks;
+
+			if( pxBlock != NULL )
+			{
+				pxPool->pxFreeBlocks = pxBlock->pxNext;
+				pxPool->xStats.uxBlocksFree--;
+				pxPool->xStats.ulAllocations++;
+
+				if( pxPool->xStats.uxBlocksFree < pxPool->xStats.uxMinimumEverBlocksFree )
+				{
+					pxPool->xStats.uxMinimumEverBlocksFree = pxPool->xStats.uxBlocksFree;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxPool->xStats.ulFallbacks++;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock == NULL )
+	{
+		return poolHEAP_MALLOC( xSize );
+	}
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vObjectPoolFree( void *pv )
+{
+ObjectPool_t *pxPool;
+ObjectPoolBlock_t *pxBlock;
+
+	pxPool = prvPoolOfBlock( pv );
+
+	if( pxPool != NULL )
+	{
+		/* The block must be the start of one of the pool's blocks. */
+		configASSERT( ( ( size_t ) ( ( uint8_t * ) pv - pxPool->pucStart ) % pxPool->xStats.xBlockSize ) == 0 );
+
+		pxBlock = ( ObjectPoolBlock_t * ) pv; /*lint !e9079 The blocks are aligned for any type. */
+
+		taskENTER_CRITICAL();
+		{
+			pxBlock->pxNext = pxPool->pxFreeBlocks;
+			pxPool->pxFreeBlocks = pxBlock;
+			pxPool->xStats.uxBlocksFree++;
+			configASSERT( pxPool->xStats.uxBlocksFree <= pxPool->xStats.uxBlockCount );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		vPortFree( pv );
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxObjectPoolGetCount( void )
+{
+	return ( UBaseType_t ) poolCOUNT;
+}
+/*-----------------------------------------------------------*/
+
+void vObjectPoolGetStats( UBaseType_t uxPool, ObjectPoolStats_t *pxStats )
+{
+	configASSERT( uxPool < ( UBaseType_t ) poolCOUNT );
+
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xPools[ uxPool ].xStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvCarvePools( void )
+{
+ObjectPool_t xPool;
+ObjectPoolBlock_t *pxBlock;
+UBaseType_t uxPool, uxOther, uxBlock;
+size_t xBlockSize;
+
+	for( uxPool = 0; uxPool < ( UBaseType_t ) poolCOUNT; uxPool++ )
+	{
+		/* Each block must hold the free list link, and must keep the blocks
+		after it aligned. */
+		xBlockSize = xPoolClasses[ uxPool ].xBlockSize;
+
+		if( xBlockSize < sizeof( ObjectPoolBlock_t ) )
+		{
+			xBlockSize = sizeof( ObjectPoolBlock_t );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xBlockSize & poolBLOCK_ALIGNMENT_MASK ) != 0x00 )
+		{
+			xBlockSize += ( ( size_t ) portCONTROL_BLOCK_ALIGNMENT - ( xBlockSize & poolBLOCK_ALIGNMENT_MASK ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xPools[ uxPool ].xStats.xBlockSize = xBlockSize;
+		xPools[ uxPool ].pucStart = ( uint8_t * ) poolHEAP_MALLOC( xBlockSize * ( size_t ) xPoolClasses[ uxPool ].uxBlockCount );
+
+		if( xPools[ uxPool ].pucStart != NULL )
+		{
+			xPools[ uxPool ].xStats.uxBlockCount = xPoolClasses[ uxPool ].uxBlockCount;
+			xPools[ uxPool ].pucEnd = xPools[ uxPool ].pucStart + ( xBlockSize * ( size_t ) xPoolClasses[ uxPool ].uxBlockCount );
+
+			/* Thread the blocks so the lowest is handed out first. */
+			for( uxBlock = xPoolClasses[ uxPool ].uxBlockCount; uxBlock > ( UBaseType_t ) 0; uxBlock-- )
+			{
+				pxBlock = ( ObjectPoolBlock_t * ) ( xPools[ uxPool ].pucStart + ( xBlockSize * ( size_t ) ( uxBlock - ( UBaseType_t ) 1 ) ) ); /*lint !e9079 The blocks are aligned for any type. */
+				pxBlock->pxNext = xPools[ uxPool ].pxFreeBlocks;
+				xPools[ uxPool ].pxFreeBlocks = pxBlock;
+			}
+		}
+		else
+		{
+			/* The pool stays empty and its requests fall back to the heap. */
+			xPools[ uxPool ].pucEnd = NULL;
+		}
+
+		xPools[ uxPool ].xStats.uxBlocksFree = xPools[ uxPool ].xStats.uxBlockCount;
+		xPools[ uxPool ].xStats.uxMinimumEverBlocksFree = xPools[ uxPool ].xStats.uxBlockCount;
+	}
+
+	/* Sort the pools by block size, so a request is served by the first pool
+	large enough.  There are only a few pools. */
+	for( uxPool = 1; uxPool < ( UBaseType_t ) poolCOUNT; uxPool++ )
+	{
+		xPool = xPools[ uxPool ];
+
+		for( uxOther = uxPool; ( uxOther > ( UBaseType_t ) 0 ) && ( xPools[ uxOther - ( UBaseType_t ) 1 ].xStats.xBlockSize > xPool.xStats.xBlockSize ); uxOther-- )
+		{
+			xPools[ uxOther ] = xPools[ uxOther - ( UBaseType_t ) 1 ];
+		}
+
+		xPools[ uxOther ] = xPool;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xObjectPoolIsPoolBlock( const void *pv )
+{
+	/* The pools do not change once they are carved, so no critical section
+	is needed. */
+	return ( prvPoolOfBlock( pv ) != NULL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static ObjectPool_t *prvPoolOfBlock( const void *pv )
+{
+const uint8_t *puc = ( const uint8_t * ) pv;
+UBaseType_t uxPool;
+
+	for( uxPool = 0; uxPool < ( UBaseType_t ) poolCOUNT; uxPool++ )
+	{
+		if( ( puc >= xPools[ uxPool ].pucStart ) && ( puc < xPools[ uxPool ].pucEnd ) )
+		{
+			return &( xPools[ uxPool ] );
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* configUSE_OBJECT_POOLS */
@@ -0,0 +1,133 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include object_pool.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Fixed size block pools for kernel objects.
+ *
+ * When configUSE_OBJECT_POOLS is set to 1 in FreeRTOSConfig.h the TCBs and
+ * stacks allocated by xTaskCreate(), the queues allocated by xQueueCreate()
+ * (and so the semaphores and mutexes) and the timers allocated by
+ * xTimerCreate() are taken from pools of fixed size blocks, through the
+ * configKERNEL_OBJECT_MALLOC() and configKERNEL_OBJECT_FREE() hooks.
+ *
+ * configOBJECT_POOL_CLASSES lists the pools as { block size, number of blocks }
+ * pairs, in any order, for example:
+ *
+ *	#define configOBJECT_POOL_CLASSES							\
+ *		{ sizeof( StaticTask_t ), 8 },							\
+ *		{ configMINIMAL_STACK_SIZE * sizeof( StackType_t ), 6 }
+ *
+ * The blocks of each pool are carved from the FreeRTOS heap in one piece the
+ * first time a kernel object is allocated, and kept on a free list of their
+ * own, so allocating and freeing an object is a pointer pop or push in a short
+ * critical section, and object churn does not fragment the heap.  A request
+ * is served by the pool with the smallest block that holds it.  If that pool
+ * is empty, or no block is large enough, the request falls back to
+ * pvPortMalloc(), and configKERNEL_OBJECT_FREE() returns the block to where it
+ * came from, found by its address.
+ *
+ * Every block, and every request that falls back to the heap, is aligned to
+ * portCONTROL_BLOCK_ALIGNMENT, as the TCBs and queues placed in them are.
+ */
+
+/* The statistics of one pool, returned by vObjectPoolGetStats(). */
+typedef struct xOBJECT_POOL_STATS
+{
+	size_t xBlockSize;					/* The size of each block, rounded up to portCONTROL_BLOCK_ALIGNMENT. */
+	UBaseType_t uxBlockCount;			/* The number of blocks carved for the pool, zero if the heap could not hold them. */
+	UBaseType_t uxBlocksFree;			/* The number of blocks free at the time of the call. */
+	UBaseType_t uxMinimumEverBlocksFree;	/* The lowest uxBlocksFree since the pool was carved. */
+	uint32_t ulAllocations;				/* The number of requests served by the pool. */
+	uint32_t ulFallbacks;				/* The number of requests for this pool served by pvPortMalloc() as the pool was empty. */
+} ObjectPoolStats_t;
+
+/**
+ * object_pool.h
+ * <pre>void *pvObjectPoolMalloc( size_t xSize );</pre>
+ *
+ * Allocates xSize bytes from the pool with the smallest block that holds them,
+ * or from the heap.  Used by the kernel through configKERNEL_OBJECT_MALLOC(),
+ * but can be called by the application for objects of the same sizes.
+ *
+ * @return The block, or NULL if neither the pool nor the heap could provide
+ * one.
+ */
+void *pvObjectPoolMalloc( size_t xSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * object_pool.h
+ * <pre>void vObjectPoolFree( void *pv );</pre>
+ *
+ * Frees a block returned by pvObjectPoolMalloc() or pvPortMalloc(), returning
+ * it to its pool if it came from one, otherwise to the heap.
+ */
+void vObjectPoolFree( void *pv ) PRIVILEGED_FUNCTION;
+
+/**
+ * object_pool.h
+ * <pre>UBaseType_t uxObjectPoolGetCount( void );</pre>
+ *
+ * @return The number of pools listed in configOBJECT_POOL_CLASSES.
+ */
+UBaseType_t uxObjectPoolGetCount( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * object_pool.h
+ * <pre>void vObjectPoolGetStats( UBaseType_t uxPool, ObjectPoolStats_t *pxStats );</pre>
+ *
+ * Fills pxStats with the statistics of a pool.  The pools are numbered from 0
+ * to uxObjectPoolGetCount() - 1 in increasing block size.  All zero until the
+ * pools are carved by the first allocation.
+ */
+void vObjectPoolGetStats( UBaseType_t uxPool, ObjectPoolStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Returns pdTRUE if pv is a block of one of the pools,
+ * pdFALSE if it came from the heap.
+ */
+BaseType_t xObjectPoolIsPoolBlock( const void *pv ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OBJECT_POOL_H */
+
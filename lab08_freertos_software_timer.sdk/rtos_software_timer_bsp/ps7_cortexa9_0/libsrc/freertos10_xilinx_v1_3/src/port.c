@@ -27,10 +27,12 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "critical_profile.h"
 
 /* Xilinx includes. */
 #include "xscugic.h"
@@ -92,10 +94,15 @@ this value. */
 /* Tasks are not created with a floating point context, but can be given a
 floating point context after they have been created.  A variable is stored as
 part of the tasks context that holds portNO_FLOATING_POINT_CONTEXT if the task
-does not have an FPU context, or any other value if the task does have an FPU
-context. */
+does not have an FPU context, or the address of the task's floating point
+register save area if the task does have an FPU context. */
 #define portNO_FLOATING_POINT_CONTEXT	( ( StackType_t ) 0 )
 
+/* The VFP enable bit in FPEXC.  The VFP is disabled while a task that does not
+own the registers it holds is running - see FreeRTOS_Undefined_Handler in
+portASM.S. */
+#define portFPEXC_EN					( 0x40000000UL )
+
 /* Constants required to setup the initial task context. */
 #define portINITIAL_SPSR				( ( StackType_t ) 0x1f ) /* System mode, ARM mode, IRQ enabled FIQ enabled. */
 #define portTHUMB_MODE_BIT				( ( StackType_t ) 0x20 )
@@ -150,10 +157,14 @@ debugger. */
 	#define portTASK_RETURN_ADDRESS	prvTaskExitError
 #endif
 
-/* The space on the stack required to hold the FPU registers.  This is 32 64-bit
-registers, plus a 32-bit status register. */
+/* The space required to hold the FPU registers.  This is 32 64-bit registers,
+plus a 32-bit status register, stored in that order. */
 #define portFPU_REGISTER_WORDS	( ( 32 * 2 ) + 1 )
 
+/* PMU register bits used to start the cycle counter. */
+#define portPMCR_ENABLE_BIT				( 0x01UL )
+#define portPMCNTENSET_CYCLE_COUNTER	( 0x80000000UL )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -204,6 +215,12 @@ extern XScuGic xInterruptController;
  */
 void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
 
+/*
+ * Called in undefined mode by FreeRTOS_Undefined_Handler in portASM.S with the
+ * address of an undefined instruction it cannot handle.  Does not return.
+ */
+void vPortUndefinedInstruction( uint32_t ulAddress );
+
 /*-----------------------------------------------------------*/
 
 /* A variable is used to keep track of the critical section nesting.  This
@@ -214,9 +231,19 @@ automatically be set to 0 when the first task is started. */
 volatile uint32_t ulCriticalNesting = 9999UL;
 
 /* Saved as part of the task context.  If ulPortTaskHasFPUContext is non-zero then
-a floating point context must be saved and restored for the task. */
+the task has a floating point context, and ulPortTaskHasFPUContext holds the
+address of the portFPU_REGISTER_WORDS words into which the context is saved
+when another task takes ownership of the VFP. */
 volatile uint32_t ulPortTaskHasFPUContext = pdFALSE;
 
+/* The save area of the task whose floating point registers are currently held
+in the VFP, or NULL if the registers do not belong to any task. */
+uint32_t * volatile pulPortFPUOwner = NULL;
+
+/* The address of the last undefined instruction FreeRTOS_Undefined_Handler
+could not handle, for the debugger. */
+volatile uint32_t ulPortUndefinedInstructionAddress = 0UL;
+
 /* Set to 1 to pend a context switch from an ISR. */
 volatile uint32_t ulPortYieldRequired = pdFALSE;
 
@@ -244,6 +271,18 @@ __attribute__(( used )) const uint32_t ulMaxAPIPriorityMask = ( configMAX_API_CA
  */
 StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
 {
+#if( configUSE_TASK_FPU_SUPPORT == 2 )
+StackType_t *pxFPUContext;
+
+	/* The floating point registers are switched lazily, so the save area of
+	the task must stay at a fixed address for the lifetime of the task.  Take
+	it from the top of the stack, and initialise the registers to 0.  The extra
+	word keeps the stack 8-byte aligned. */
+	pxFPUContext = pxTopOfStack - ( portFPU_REGISTER_WORDS - 1 );
+	memset( pxFPUContext, 0x00, portFPU_REGISTER_WORDS * sizeof( StackType_t ) );
+	pxTopOfStack -= ( portFPU_REGISTER_WORDS + 1 );
+#endif
+
 	/* Setup the initial stack of the task.  The stack is set exactly as
 	expected by the portRESTORE_CONTEXT() macro.
 
@@ -314,14 +353,10 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 	}
 	#elif( configUSE_TASK_FPU_SUPPORT == 2 )
 	{
-		/* The task will start with a floating point context.  Leave enough
-		space for the registers - and ensure they are initialised to 0. */
-		pxTopOfStack -= portFPU_REGISTER_WORDS;
-		memset( pxTopOfStack, 0x00, portFPU_REGISTER_WORDS * sizeof( StackType_t ) );
-
+		/* The task will start with a floating point context, the save area
+		of which was reserved at the top of the stack above. */
 		pxTopOfStack--;
-		*pxTopOfStack = pdTRUE;
-		ulPortTaskHasFPUContext = pdTRUE;
+		*pxTopOfStack = ( StackType_t ) pxFPUContext;
 	}
 	#else
 	{
@@ -504,6 +539,14 @@ uint32_t ulAPSR;
 			executing. */
 			portCPU_IRQ_DISABLE();
 
+			#if( ( configUSE_CRITICAL_SECTION_PROFILING == 1 ) || ( configUSE_TRACE_RECORDER == 1 ) )
+			{
+				/* Critical sections and trace events are timestamped with the
+				cycle counter. */
+				vPortEnableCycleCounter();
+			}
+			#endif
+
 			/* Start the timer that generates the tick ISR. */
 			configSETUP_TICK_INTERRUPT();
 
@@ -548,6 +591,10 @@ void vPortEnterCritical( void )
 	if( ulCriticalNesting == 1 )
 	{
 		configASSERT( ulPortInterruptNesting == 0 );
+
+		/* Attribute the section to the caller of taskENTER_CRITICAL() rather
+		than to this function. */
+		criticalprofileSET_CALL_SITE( eCriticalProfileInterruptMask, __builtin_return_address( 0 ) );
 	}
 }
 /*-----------------------------------------------------------*/
@@ -566,6 +613,7 @@ void vPortExitCritical( void )
 		{
 			/* Critical nesting has reached zero so all interrupt priorities
 			should be unmasked. */
+			criticalprofileSECTION_END( eCriticalProfileInterruptMask );
 			portCLEAR_INTERRUPT_MASK();
 		}
 	}
@@ -597,6 +645,7 @@ void FreeRTOS_Tick_Handler( void )
 	__asm volatile (	"dsb		\n"
 						"isb		\n" ::: "memory" );
 	portCPU_IRQ_ENABLE();
+	criticalprofileSECTION_START( eCriticalProfileInterruptMask, ( void * ) FreeRTOS_Tick_Handler );
 
 	/* Increment the RTOS tick. */
 	if( xTaskIncrementTick() != pdFALSE )
@@ -606,6 +655,7 @@ void FreeRTOS_Tick_Handler( void )
 	}
 
 	/* Ensure all interrupt priorities are active again. */
+	criticalprofileSECTION_END( eCriticalProfileInterruptMask );
 	portCLEAR_INTERRUPT_MASK();
 	configCLEAR_TICK_INTERRUPT();
 }
@@ -615,23 +665,80 @@ void FreeRTOS_Tick_Handler( void )
 
 	void vPortTaskUsesFPU( void )
 	{
-	uint32_t ulInitialFPSCR = 0;
-
-		/* A task is registering the fact that it needs an FPU context.  Set the
-		FPU flag (which is saved as part of the task context). */
-		ulPortTaskHasFPUContext = pdTRUE;
+	uint32_t *pulFPUContext;
+	uint32_t ulFPEXC;
 
-		/* Initialise the floating point status register. */
-		__asm volatile ( "FMXR 	FPSCR, %0" :: "r" (ulInitialFPSCR) : "memory" );
+		if( ulPortTaskHasFPUContext == pdFALSE )
+		{
+			/* A task is registering the fact that it needs an FPU context.
+			Allocate the area into which its registers are saved when another
+			task takes ownership of the VFP, and initialise the registers,
+			including the floating point status register, to 0.  The area is
+			freed by vPortCleanUpTCB() when the task is deleted. */
+			pulFPUContext = ( uint32_t * ) pvPortMalloc( portFPU_REGISTER_WORDS * sizeof( uint32_t ) );
+			configASSERT( pulFPUContext );
+
+			if( pulFPUContext != NULL )
+			{
+				memset( pulFPUContext, 0x00, portFPU_REGISTER_WORDS * sizeof( uint32_t ) );
+
+				portENTER_CRITICAL();
+				{
+					/* Set the FPU context (which is saved as part of the task
+					context), then disable the VFP so the first floating point
+					instruction the task executes loads the registers from the
+					area. */
+					ulPortTaskHasFPUContext = ( uint32_t ) pulFPUContext;
+
+					__asm volatile ( "VMRS	%0, FPEXC" : "=r" ( ulFPEXC ) :: "memory" );
+					ulFPEXC &= ~portFPEXC_EN;
+					__asm volatile ( "VMSR	FPEXC, %0" :: "r" ( ulFPEXC ) : "memory" );
+				}
+				portEXIT_CRITICAL();
+			}
+		}
 	}
 
 #endif /* configUSE_TASK_FPU_SUPPORT */
 /*-----------------------------------------------------------*/
 
+void vPortCleanUpTCB( void *pvTCB )
+{
+uint32_t *pulFPUContext;
+
+	/* The task being deleted is not running, so its context has been saved,
+	and the first member of the TCB points to the top of the saved context,
+	which is the task's ulPortTaskHasFPUContext value. */
+	pulFPUContext = ( uint32_t * ) **( ( StackType_t ** ) pvTCB );
+
+	if( pulFPUContext != NULL )
+	{
+		/* The registers in the VFP no longer belong to any task. */
+		portENTER_CRITICAL();
+		{
+			if( pulPortFPUOwner == pulFPUContext )
+			{
+				pulPortFPUOwner = NULL;
+			}
+		}
+		portEXIT_CRITICAL();
+
+		#if( configUSE_TASK_FPU_SUPPORT != 2 )
+		{
+			/* The area was allocated by vPortTaskUsesFPU().  When
+			configUSE_TASK_FPU_SUPPORT is 2 it is part of the task's stack. */
+			vPortFree( pulFPUContext );
+		}
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
 void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 {
 	if( ulNewMaskValue == pdFALSE )
 	{
+		criticalprofileSECTION_END( eCriticalProfileInterruptMask );
 		portCLEAR_INTERRUPT_MASK();
 	}
 }
@@ -655,6 +762,7 @@ uint32_t ulReturn;
 		portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
 		__asm volatile (	"dsb		\n"
 							"isb		\n" ::: "memory" );
+		criticalprofileSECTION_START( eCriticalProfileInterruptMask, __builtin_return_address( 0 ) );
 	}
 	portCPU_IRQ_ENABLE();
 
@@ -662,6 +770,19 @@ uint32_t ulReturn;
 }
 /*-----------------------------------------------------------*/
 
+void vPortEnableCycleCounter( void )
+{
+uint32_t ulPMCR;
+
+	/* Set the enable bit in PMCR without disturbing the event counter
+	configuration, then enable the cycle counter itself. */
+	ulPMCR = mfcp( XREG_CP15_PERF_MONITOR_CTRL );
+	mtcp( XREG_CP15_PERF_MONITOR_CTRL, ulPMCR | portPMCR_ENABLE_BIT );
+	mtcp( XREG_CP15_COUNT_ENABLE_SET, portPMCNTENSET_CYCLE_COUNTER );
+	__asm volatile ( "ISB" ::: "memory" );
+}
+/*-----------------------------------------------------------*/
+
 #if( configASSERT_DEFINED == 1 )
 
 	void vPortValidateInterruptPriority( void )
@@ -703,6 +824,17 @@ void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR )
 	( void ) ulICCIAR;
 	configASSERT( ( volatile void * ) NULL );
 }
+/*-----------------------------------------------------------*/
+
+void vPortUndefinedInstruction( uint32_t ulAddress )
+{
+	/* Either an instruction that is undefined, or a floating point
+	instruction executed outside of a task while the VFP was disabled. */
+	ulPortUndefinedInstructionAddress = ulAddress;
+	configASSERT( ( volatile void * ) NULL );
+
+	for( ;; );
+}
 
 #if( configGENERATE_RUN_TIME_STATS == 1 )
 /*
@@ -29,13 +29,18 @@
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "stack_profile.h"
 
 /* Xilinx includes. */
 #include "xscutimer.h"
 #include "xscugic.h"
+#include "xil_mmu.h"
 
 #define XSCUTIMER_CLOCK_HZ ( XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2UL )
 
+/* The size of the sections the first level translation table maps. */
+#define portMMU_SECTION_SIZE ( 0x100000UL )
+
 /*
  * Some FreeRTOSConfig.h settings require the application writer to provide the
  * implementation of a callback function that has a specific name, and a linker
@@ -51,6 +56,21 @@ void vApplicationTickHook( void ) __attribute__((weak));
 void vApplicationIdleHook( void ) __attribute__((weak));
 void vApplicationMallocFailedHook( void ) __attribute((weak));
 void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __attribute__((weak));
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize ) __attribute__((weak));
+	#if( configUSE_TIMERS == 1 )
+		void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize ) __attribute__((weak));
+	#endif
+#endif
+
+#if( configPLACE_KERNEL_IN_OCM == 1 )
+	/*
+	 * Copies .ocm_data from its load address in DDR into the on-chip memory,
+	 * and clears .ocm_bss.  It runs as a constructor, called by __libc_init_array() in xil-crt0.S, so
+	 * the data is in place before main() creates any kernel object.
+	 */
+	static void prvCopyOCMData( void ) __attribute__( ( constructor( 101 ) ) );
+#endif
 
 /* Timer used to generate the tick interrupt. */
 static XScuTimer xTimer;
@@ -126,6 +146,77 @@ void FreeRTOS_ClearTickInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortConfigureDMARegion( void *pvStart, size_t xSize )
+{
+uint32_t ulAddress;
+
+	/* Every section the region touches is remapped.  lscript.ld aligns and
+	pads .dma_heap to whole sections, so no other data shares them.
+	Xil_SetTlbAttributes() flushes the data cache before it changes a
+	section. */
+	for( ulAddress = ( uint32_t ) pvStart & ~( portMMU_SECTION_SIZE - 1UL ); ulAddress < ( uint32_t ) pvStart + xSize; ulAddress += portMMU_SECTION_SIZE )
+	{
+		Xil_SetTlbAttributes( ( INTPTR ) ulAddress, NORM_NONCACHE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetModeStacks( StackProfileRegion_t *pxRegions, UBaseType_t uxMaxRegions )
+{
+/* The bounds of each stack, as defined in lscript.ld. */
+extern uint8_t _irq_stack_end[], __irq_stack[];
+extern uint8_t _supervisor_stack_end[], __supervisor_stack[];
+extern uint8_t _abort_stack_end[], __abort_stack[];
+extern uint8_t _fiq_stack_end[], __fiq_stack[];
+extern uint8_t _undef_stack_end[], __undef_stack[];
+extern uint8_t _stack_end[], __stack[];
+const StackProfileRegion_t xModeStacks[] =
+{
+	{ "irq", _irq_stack_end, __irq_stack },
+	{ "svc", _supervisor_stack_end, __supervisor_stack },	/* Also used by the interrupt handlers, see FreeRTOS_IRQ_Handler. */
+	{ "abort", _abort_stack_end, __abort_stack },
+	{ "fiq", _fiq_stack_end, __fiq_stack },
+	{ "undef", _undef_stack_end, __undef_stack },
+	{ "sys", _stack_end, __stack }							/* Only used by main() before the scheduler starts. */
+};
+UBaseType_t x;
+
+	for( x = 0; ( x < uxMaxRegions ) && ( x < ( UBaseType_t ) ( sizeof( xModeStacks ) / sizeof( xModeStacks[ 0 ] ) ) ); x++ )
+	{
+		pxRegions[ x ] = xModeStacks[ x ];
+	}
+
+	return x;
+}
+/*-----------------------------------------------------------*/
+
+#if( configPLACE_KERNEL_IN_OCM == 1 )
+
+	static void prvCopyOCMData( void )
+	{
+	/* The bounds of .ocm_data and its load address, as defined in lscript.ld,
+	which loads it into DDR so that an FSBL running from ps7_ram_0 can load
+	the image. */
+	extern uint32_t __ocm_data_start[], __ocm_data_end[], __ocm_data_load_start[];
+	extern uint32_t __ocm_bss_start[], __ocm_bss_end[];
+	const uint32_t *pulSource = __ocm_data_load_start;
+	uint32_t *pulDestination;
+
+		for( pulDestination = __ocm_data_start; pulDestination < __ocm_data_end; pulDestination++ )
+		{
+			*pulDestination = *pulSource;
+			pulSource++;
+		}
+
+		for( pulDestination = __ocm_bss_start; pulDestination < __ocm_bss_end; pulDestination++ )
+		{
+			*pulDestination = 0UL;
+		}
+	}
+
+#endif /* configPLACE_KERNEL_IN_OCM */
+/*-----------------------------------------------------------*/
+
 void vApplicationIRQHandler( uint32_t ulICCIAR )
 {
 extern const XScuGic_Config XScuGic_ConfigTable[];
@@ -221,3 +312,39 @@ volatile char *pcOverflowingTaskName = pcTaskName;
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 }
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* These default versions of the callbacks that provide the memory of the
+	idle and timer tasks, when configSUPPORT_STATIC_ALLOCATION is 1, hand out
+	buffers sized from FreeRTOSConfig.h and linked, like the rest of the hot
+	kernel data, into the on-chip memory when configPLACE_KERNEL_IN_OCM is 1.
+	They are declared as weak symbols to allow the application writer to
+	override them. */
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+	{
+	static StaticTask_t xIdleTaskTCB portFAST_BSS;
+	static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ] portFAST_BSS;
+
+		*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+		*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+		*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if( configUSE_TIMERS == 1 )
+
+		void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+		{
+		static StaticTask_t xTimerTaskTCB portFAST_BSS;
+		static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ] portFAST_BSS;
+
+			*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+			*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+			*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+		}
+
+	#endif /* configUSE_TIMERS */
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
@@ -102,7 +102,7 @@ extern "C" {
 	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
-/* Used by heap_5.c. */
+/* Used by heap_5.c and heap_tlsf.c. */
 typedef struct HeapRegion
 {
 	uint8_t *pucStartAddress;
@@ -115,6 +115,9 @@ typedef struct HeapRegion
  * queue, semaphore, mutex, software timer, event group, etc. will result in
  * pvPortMalloc being called.
  *
+ * heap_tlsf.c adds the regions after ucHeap and its bulk and DMA regions, as
+ * bulk regions, and allows this function to be called at any time.
+ *
  * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
  * defines a region of memory that can be used as the heap.  The array is
  * terminated by a HeapRegions_t structure that has a size of 0.  The region
@@ -132,6 +135,50 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Returns the number of bytes the caller may use in the block pv points to,
+ * which can be more than were asked for as blocks are rounded up.  pv must have
+ * been returned by pvPortMalloc(), and not yet freed.
+ */
+size_t xPortGetAllocationSize( void *pv ) PRIVILEGED_FUNCTION;
+
+/* The memory pvPortMallocPlaced() allocates from. */
+typedef enum
+{
+	eHeapFast = 0,	/* ucHeap first, as pvPortMalloc(), then the bulk regions. */
+	eHeapBulk,		/* The bulk regions first, then ucHeap. */
+	eHeapDMA		/* Only the non-cacheable DMA region. */
+} HeapPlacement_t;
+
+/*
+ * Allocates xSize bytes from the memory ePlacement asks for, aligned to
+ * xAlignment bytes, which must be a power of two.  An alignment below
+ * portBYTE_ALIGNMENT is raised to it.  The block is freed with vPortFree().
+ * Only provided by heap_tlsf.c.
+ */
+void *pvPortMallocPlaced( size_t xSize, HeapPlacement_t ePlacement, size_t xAlignment ) PRIVILEGED_FUNCTION;
+
+/* Used to pass information about the heap out of vPortGetHeapStats(). */
+typedef struct xHeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;		/* The sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes;	/* The size of the largest free block at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes;	/* The size of the smallest free block at the time vPortGetHeapStats() is called. */
+	size_t xNumberOfFreeBlocks;				/* The number of free blocks at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;	/* The lowest xAvailableHeapSpaceInBytes since the system booted. */
+	size_t xNumberOfSuccessfulAllocations;	/* The number of calls to pvPortMalloc() that have returned a block. */
+	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that have freed a block. */
+} HeapStats_t;
+
+/*
+ * Fills pxHeapStats with the state of the heap, for heap_4.c and heap_tlsf.c.
+ * The fragmentation of the heap is the share of the free space that is not in
+ * the largest free block, i.e. 1 - ( xSizeOfLargestFreeBlockInBytes /
+ * xAvailableHeapSpaceInBytes ): zero when all the free space is in one block,
+ * and close to one when no request of more than a small part of it can be met.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -34,6 +34,7 @@
 
 /* BSP includes. */
 #include "xil_types.h"
+#include "xpseudo_asm.h"
 
 /*-----------------------------------------------------------
  * Port specific definitions.
@@ -67,6 +68,40 @@ typedef uint32_t TickType_t;
 #define portSTACK_GROWTH			( -1 )
 #define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT			8
+#define portCACHE_LINE_SIZE			32	/* L1 and L2 data cache line of the Cortex-A9 */
+
+/* The TCBs and queues start on a cache line, so the members a context switch
+or a send or receive uses are in as few lines as the layout allows.  Only
+heap_tlsf.c can allocate them aligned. */
+#if( configUSE_TLSF_HEAP == 1 )
+	#define portCONTROL_BLOCK_ALIGNMENT	portCACHE_LINE_SIZE
+	#define portCONTROL_BLOCK_ALIGNED	__attribute__( ( aligned( portCONTROL_BLOCK_ALIGNMENT ) ) )
+#endif
+
+/* With configPLACE_KERNEL_IN_OCM set to 1 the ready, delayed and timer lists,
+the scheduler state read on every tick and the FreeRTOS heap are linked into the
+on-chip memory instead of DDR.  The .ocm_data, .ocm_bss and .ocm_heap sections
+are defined in the application's lscript.ld, which loads .ocm_data into DDR, and
+portZynq7000.c copies .ocm_data into place and clears .ocm_bss before main() is
+called. */
+#if( configPLACE_KERNEL_IN_OCM == 1 )
+	#define portFAST_DATA				__attribute__( ( section( ".ocm_data" ) ) )
+	#define portFAST_BSS				__attribute__( ( section( ".ocm_bss" ) ) )
+	#define portFAST_HEAP				__attribute__( ( section( ".ocm_heap" ) ) )
+#endif
+
+/* The heap's DMA region is linked into .dma_heap, which lscript.ld aligns and
+pads to whole 1MB MMU sections, and vPortConfigureDMARegion() maps those
+sections non-cacheable. */
+#define portDMA_HEAP					__attribute__( ( section( ".dma_heap" ) ) )
+void vPortConfigureDMARegion( void *pvStart, size_t xSize );
+#define portCONFIGURE_DMA_REGION( pvStart, xSize ) vPortConfigureDMARegion( ( pvStart ), ( xSize ) )
+
+/* The processor mode stacks boot.S sets up from the symbols in lscript.ld,
+reported to the stack profiler. */
+struct xSTACK_PROFILE_REGION;
+UBaseType_t uxPortGetModeStacks( struct xSTACK_PROFILE_REGION *pxRegions, UBaseType_t uxMaxRegions );
+#define portGET_MODE_STACKS( pxRegions, uxMaxRegions ) uxPortGetModeStacks( ( pxRegions ), ( uxMaxRegions ) )
 
 /*-----------------------------------------------------------*/
 
@@ -181,6 +216,10 @@ by default. */
 #endif
 #define portTASK_USES_FLOATING_POINT() vPortTaskUsesFPU()
 
+/* Releases the floating point context of a task that is being deleted. */
+void vPortCleanUpTCB( void *pvTCB );
+#define portCLEAN_UP_TCB( pxTCB ) vPortCleanUpTCB( ( void * ) ( pxTCB ) )
+
 #define portLOWEST_INTERRUPT_PRIORITY ( ( ( uint32_t ) configUNIQUE_INTERRUPT_PRIORITIES ) - 1UL )
 #define portLOWEST_USABLE_INTERRUPT_PRIORITY ( portLOWEST_INTERRUPT_PRIORITY - 1UL )
 
@@ -206,9 +245,78 @@ by default. */
 	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID() 	vPortValidateInterruptPriority()
 #endif /* configASSERT */
 
+/* Cycle counter used to timestamp events for profiling.  The PMU cycle counter
+is not started by the BSP, so vPortEnableCycleCounter() must be called before
+the value is meaningful.  The event counters configured by Xpm_SetEvents() are
+not affected. */
+void vPortEnableCycleCounter( void );
+#define portGET_CYCLE_COUNT() ( ( uint32_t ) mfcp( XREG_CP15_PERF_CYCLE_COUNTER ) )
+
 #define portNOP() __asm volatile( "NOP" )
 #define portINLINE __inline
 
+/* Stops the compiler moving memory accesses across it, which is enough to
+order them against code that runs later on the same core, such as an
+interrupt or the task switched in next. */
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* Orders the memory accesses before it against those after it, as seen by
+other bus masters and by interrupts. */
+#define portDATA_MEMORY_BARRIER() __asm volatile( "dmb" ::: "memory" )
+
+/* Atomic operations through the exclusive monitors, usable on memory shared
+with the other core.  Neither implies a memory barrier.  The compare and swap
+stores ulExchange only if the word held ulComparand, and returns the value the
+word held.  When it did not, the reservation taken by LDREX is released with
+CLREX rather than left open for the next STREX of this core. */
+static portINLINE uint32_t ulPortCompareAndSwap( volatile uint32_t *pulDestination, uint32_t ulComparand, uint32_t ulExchange )
+{
+uint32_t ulValue, ulFailed;
+
+	do
+	{
+		__asm volatile(
+			"	ldrex	%0, [%2]		\n"
+			"	mov		%1, #0			\n"
+			"	cmp		%0, %3			\n"
+			"	strexeq	%1, %4, [%2]	\n"
+			"	beq		1f				\n"
+			"	clrex					\n"
+			"1:							\n"
+			: "=&r" ( ulValue ), "=&r" ( ulFailed )
+			: "r" ( pulDestination ), "r" ( ulComparand ), "r" ( ulExchange )
+			: "cc", "memory" );
+	} while( ulFailed != 0UL );
+
+	return ulValue;
+}
+
+static portINLINE uint32_t ulPortAtomicExchange( volatile uint32_t *pulDestination, uint32_t ulExchange )
+{
+uint32_t ulValue, ulFailed;
+
+	do
+	{
+		__asm volatile(
+			"	ldrex	%0, [%2]		\n"
+			"	strex	%1, %3, [%2]	\n"
+			: "=&r" ( ulValue ), "=&r" ( ulFailed )
+			: "r" ( pulDestination ), "r" ( ulExchange )
+			: "memory" );
+	} while( ulFailed != 0UL );
+
+	return ulValue;
+}
+
+/* Waits in low power for an event sent by the other core, or an interrupt.
+The event is sent after a barrier, so the other core sees the stores that led
+to it. */
+#define portWAIT_FOR_EVENT() __asm volatile( "wfe" ::: "memory" )
+#define portSEND_EVENT() __asm volatile( "dsb\n\tsev" ::: "memory" )
+
+/* The number of the core executing the caller, from MPIDR. */
+#define portGET_CORE_ID() ( ( uint32_t ) mfcp( XREG_CP15_MULTI_PROC_AFFINITY ) & 0x3UL )
+
 #ifdef __cplusplus
 	} /* extern C */
 #endif
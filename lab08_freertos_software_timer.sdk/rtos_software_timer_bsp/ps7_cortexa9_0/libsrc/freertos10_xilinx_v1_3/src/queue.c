@@ -36,6 +36,8 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "object_pool.h"
+#include "heap_track.h"
 
 #if ( configUSE_CO_ROUTINES == 1 )
 	#include "croutine.h"
@@ -74,6 +76,11 @@ typedef struct SemaphoreData
 {
 	TaskHandle_t xMutexHolder;		 /*< The handle of the task that holds the mutex. */
 	UBaseType_t uxRecursiveCallCount;/*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
+
+	#if( configUSE_MUTEX_METRICS == 1 )
+		uint32_t ulTakenAt;			 /*< The cycle count at which the mutex was last taken, used to time how long it is held. */
+		MutexMetrics_t xMetrics;	 /*< The contention statistics returned by vQueueGetMutexMetrics(). */
+	#endif
 } SemaphoreData_t;
 
 /* Semaphores do not actually store or copy data, so have an item size of
@@ -96,18 +103,14 @@ zero. */
  */
 typedef struct QueueDefinition /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
+	/* The members up to the union are used by every send and receive, and
+	for a queue the union holds the rest of the storage area pointers, so with
+	a 32 byte cache line copying an item in or out only touches the first line
+	of the structure.  The queue set members and the lists of blocked tasks,
+	which each send or receive checks for a task to unblock, follow. */
 	int8_t *pcHead;					/*< Points to the beginning of the queue storage area. */
 	int8_t *pcWriteTo;				/*< Points to the free next place in the storage area. */
 
-	union
-	{
-		QueuePointers_t xQueue;		/*< Data required exclusively when this structure is used as a queue. */
-		SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
-	} u;
-
-	List_t xTasksWaitingToSend;		/*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
-	List_t xTasksWaitingToReceive;	/*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
-
 	volatile UBaseType_t uxMessagesWaiting;/*< The number of items currently in the queue. */
 	UBaseType_t uxLength;			/*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
 	UBaseType_t uxItemSize;			/*< The size of each items that the queue will hold. */
@@ -119,21 +122,99 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
 	#endif
 
+	union
+	{
+		QueuePointers_t xQueue;		/*< Data required exclusively when this structure is used as a queue. */
+		SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
+	} u;
+
 	#if ( configUSE_QUEUE_SETS == 1 )
 		struct QueueDefinition *pxQueueSetContainer;
+		#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+			UBaseType_t uxQueueSetBit;	/*< The bit that represents the queue in the ready bitmap of pxQueueSetContainer. */
+		#endif
 	#endif
 
+	List_t xTasksWaitingToReceive;	/*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
+	List_t xTasksWaitingToSend;		/*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxQueueNumber;
 		uint8_t ucQueueType;
 	#endif
 
-} xQUEUE;
+} portCONTROL_BLOCK_ALIGNED xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
 name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	/*
+	 * The state of a zero copy queue.  The storage area of a zero copy queue
+	 * is followed by this structure, then by one byte per slot holding the
+	 * state of the slot.  The slots cycle through the storage area in order:
+	 * uxReleaseIndex up to uxBorrowIndex are borrowed, uxBorrowIndex up to
+	 * uxCommitIndex hold the uxMessagesWaiting committed items, uxCommitIndex up
+	 * to uxAcquireIndex are acquired, and the rest are free.  Slots committed or
+	 * released out of order are only marked in their state byte until the
+	 * index reaches them.
+	 */
+	typedef struct QueueZeroCopy
+	{
+		UBaseType_t uxAcquireIndex;		/*< The next slot to be acquired. */
+		UBaseType_t uxCommitIndex;		/*< The oldest acquired slot not yet available to consumers. */
+		UBaseType_t uxBorrowIndex;		/*< The next slot to be borrowed. */
+		UBaseType_t uxReleaseIndex;		/*< The oldest borrowed slot not yet free. */
+		UBaseType_t uxAcquired;			/*< The number of slots from uxCommitIndex to uxAcquireIndex. */
+		UBaseType_t uxBorrowed;			/*< The number of slots from uxReleaseIndex to uxBorrowIndex. */
+	} QueueZeroCopy_t;
+
+	/* Slot states. */
+	#define queueSLOT_FREE				( ( uint8_t ) 0U )
+	#define queueSLOT_ACQUIRED			( ( uint8_t ) 1U )
+	#define queueSLOT_COMMITTED			( ( uint8_t ) 2U )
+	#define queueSLOT_BORROWED			( ( uint8_t ) 3U )
+	#define queueSLOT_RELEASED			( ( uint8_t ) 4U )
+
+	#define queueZERO_COPY_ALIGN( xSize )	( ( ( size_t ) ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+	#define queueZERO_COPY( pxQueue )		( ( QueueZeroCopy_t * ) ( void * ) ( ( pxQueue )->pcHead + queueZERO_COPY_ALIGN( ( pxQueue )->uxLength * ( pxQueue )->uxItemSize ) ) )
+	#define queueZERO_COPY_STATES( pxZeroCopy )	( ( uint8_t * ) ( ( pxZeroCopy ) + 1 ) )
+	#define queueZERO_COPY_NEXT( pxQueue, uxIndex )	( ( ( ( uxIndex ) + ( UBaseType_t ) 1 ) == ( pxQueue )->uxLength ) ? ( UBaseType_t ) 0 : ( ( uxIndex ) + ( UBaseType_t ) 1 ) )
+
+	/* The zero copy functions can only check they were passed a zero copy
+	queue if the queue type is stored. */
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		#define queueASSERT_ZERO_COPY( pxQueue ) configASSERT( ( pxQueue )->ucQueueType == queueQUEUE_TYPE_ZERO_COPY )
+	#else
+		#define queueASSERT_ZERO_COPY( pxQueue )
+	#endif
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	/*
+	 * The state of a queue set, held in its storage area in place of a queue of
+	 * member handles.  A member sets its bit when it is posted to.  The bit is
+	 * only cleared by a select that finds the member empty again, so the
+	 * receive paths of the members are not changed.
+	 */
+	#define queueSET_MAX_MEMBERS	( ( UBaseType_t ) 32U )
+
+	typedef struct QueueSetBitmap
+	{
+		uint32_t ulReadyBits;						/*< Bit n is set while pxMembers[ n ] may contain data. */
+		UBaseType_t uxNextBit;						/*< The bit the next select starts from, so ready members are selected in turn. */
+		Queue_t *pxMembers[ queueSET_MAX_MEMBERS ];	/*< The members, NULL where a bit is not in use. */
+	} QueueSetBitmap_t;
+
+	#define queueSET_BITMAP( pxQueueSet )	( ( QueueSetBitmap_t * ) ( void * ) ( pxQueueSet )->pcHead )
+	#define queueSET_BIT( uxBit )			( ( ( uint32_t ) 1UL ) << ( uxBit ) )
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -198,6 +279,33 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxItemCount items to the back of a queue, or out of its front, with
+ * at most two calls to memcpy().  The caller has already checked that there is
+ * enough space, or enough items.  Must be called from a critical section.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const void *pvItemsToQueue, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, void * const pvBuffer, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks one task waiting to receive, or to send, for each of uxItemCount
+ * items sent to, or received from, the queue, as long as there are tasks
+ * waiting.  If the queue is a member of a queue set, the set is notified of
+ * each item sent instead.  Returns pdTRUE if an unblocked task has a priority
+ * above that of the running task, so the caller can make one decision to
+ * yield however many items were moved.  Must be called from a critical
+ * section, with the queue unlocked.
+ */
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds uxItemCount to a lock count of a locked queue, so the task that unlocks
+ * the queue unblocks one task for each item.  There can never be more tasks to
+ * unblock than the count can hold.
+ */
+static int8_t prvAddToLockCount( const int8_t cLockCount, const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -206,6 +314,48 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+	/*
+	 * Writes up to uxMaxMembers members of a queue set that contain data to
+	 * pxMembers, visiting each ready bit once, starting from the bit after the
+	 * member last selected.  Clears the bits of members found to be empty.
+	 * Must be called from a critical section.
+	 */
+	static UBaseType_t prvSelectReadyMembers( Queue_t * const pxQueueSet, QueueSetMemberHandle_t * const pxMembers, const UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Waits up to xTicksToWait ticks for a member of a queue set to contain
+	 * data, then selects up to uxMaxMembers members as prvSelectReadyMembers().
+	 */
+	static UBaseType_t prvSelectFromSet( Queue_t * const pxQueueSet, QueueSetMemberHandle_t * const pxMembers, const UBaseType_t uxMaxMembers, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Uses a critical section to determine if any bit of a queue set is set.
+	 */
+	static BaseType_t prvIsQueueSetEmpty( const Queue_t *pxQueueSet ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The index of the least significant bit set in ulBits, which must not be
+	 * zero.
+	 */
+	static UBaseType_t prvGetLowestBit( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	/*
+	 * The number of slots of a zero copy queue that can be acquired, if xSide
+	 * is queueZERO_COPY_PRODUCER, or borrowed, if xSide is
+	 * queueZERO_COPY_CONSUMER.  Must be called from a critical section.
+	 */
+	static UBaseType_t prvZeroCopySlotsAvailable( const Queue_t *pxQueue, const BaseType_t xSide ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Uses a critical section to determine if a zero copy queue has no slot
+	 * available to xSide.
+	 */
+	static BaseType_t prvIsZeroCopyQueueExhausted( const Queue_t *pxQueue, const BaseType_t xSide ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -231,6 +381,33 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+	/*
+	 * Passes the priority of the calling task on along a chain of tasks, each
+	 * of which holds a mutex and is blocked waiting for a mutex held by the
+	 * next, starting from the blocked holder xMutexHolder.
+	 */
+	static void prvInheritAlongChain( TaskHandle_t xMutexHolder ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Undoes prvInheritAlongChain() once a waiter times out, lowering each
+	 * holder along the chain after xMutexHolder to the greater of its base
+	 * priority and the priority of the highest priority task still waiting
+	 * for the mutex it holds.
+	 */
+	static void prvDisinheritAlongChain( TaskHandle_t xMutexHolder ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configUSE_MUTEX_METRICS == 1 )
+	/*
+	 * Update the metrics of a mutex as it is taken, having waited since
+	 * ulWaitStart if xWaited is pdTRUE, and as it is given back.  Both are
+	 * called from a critical section.
+	 */
+	static void prvRecordMutexTaken( Queue_t * const pxMutex, const BaseType_t xWaited, const uint32_t ulWaitStart ) PRIVILEGED_FUNCTION;
+	static void prvRecordMutexGiven( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -394,10 +571,15 @@ Queue_t * const pxQueue = xQueue;
 		are greater than or equal to the pointer to char requirements the cast
 		is safe.  In other cases alignment requirements are not strict (one or
 		two bytes). */
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+		pxNewQueue = ( Queue_t * ) configKERNEL_OBJECT_MALLOC( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
 
 		if( pxNewQueue != NULL )
 		{
+			/* Charge the queue to the caller of xQueueGenericCreate(), which
+			the xQueueCreate() and xSemaphoreCreate...() macros make the
+			application. */
+			heaptrackSET_CALL_SITE( pxNewQueue, heaptrackCALL_SITE() );
+
 			/* Jump past the queue structure to find the location of the queue
 			storage area. */
 			pucQueueStorage = ( uint8_t * ) pxNewQueue;
@@ -484,6 +666,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+			#if( configUSE_MUTEX_METRICS == 1 )
+			{
+				pxNewQueue->u.xSemaphore.ulTakenAt = 0;
+				( void ) memset( ( void * ) &( pxNewQueue->u.xSemaphore.xMetrics ), 0x00, sizeof( MutexMetrics_t ) );
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -506,6 +695,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
 
 		xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
+		heaptrackSET_CALL_SITE( xNewQueue, heaptrackCALL_SITE() );
 		prvInitialiseMutex( ( Queue_t * ) xNewQueue );
 
 		return xNewQueue;
@@ -591,6 +781,26 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_METRICS == 1 )
+
+	void vQueueGetMutexMetrics( QueueHandle_t xMutex, MutexMetrics_t * const pxMetrics )
+	{
+	Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMetrics );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			*pxMetrics = pxMutex->u.xSemaphore.xMetrics;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_METRICS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
 	BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
@@ -729,6 +939,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 
 		if( xHandle != NULL )
 		{
+			heaptrackSET_CALL_SITE( xHandle, heaptrackCALL_SITE() );
 			( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
 			traceCREATE_COUNTING_SEMAPHORE();
@@ -1105,6 +1316,192 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+UBaseType_t uxCount;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
+
+	/* Semaphores and mutexes have no items to send. */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* As xQueueGenericSend(), but all the items that fit are sent
+			in this one critical section. */
+			uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+			if( uxCount > ( UBaseType_t ) 0 )
+			{
+				if( uxCount > uxItemCount )
+				{
+					uxCount = uxItemCount;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceQUEUE_SEND( pxQueue );
+				prvCopyItemsToQueue( pxQueue, pvItemsToQueue, uxCount );
+
+				/* One decision to yield, however many tasks were unblocked.
+				Yes it is ok to do this from within the critical section - the
+				kernel takes care of that. */
+				if( prvUnblockReceivers( pxQueue, uxCount ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return uxCount;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was full and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return ( UBaseType_t ) 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return ( UBaseType_t ) 0;
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxCount;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItemsToQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comment in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+		if( uxCount > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			if( uxCount > uxItemCount )
+			{
+				uxCount = uxItemCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyItemsToQueue( pxQueue, pvItemsToQueue, uxCount );
+
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( ( prvUnblockReceivers( pxQueue, uxCount ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Increment the lock count so the task that unlocks the queue
+				knows that data was posted while it was locked. */
+				pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxCount );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
 {
 BaseType_t xReturn;
@@ -1411,19 +1808,152 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = xQueue;
+UBaseType_t uxCount;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* As xQueueReceive(), but all the items there are room for are
+			removed in this one critical section. */
+			uxCount = pxQueue->uxMessagesWaiting;
+
+			if( uxCount > ( UBaseType_t ) 0 )
+			{
+				if( uxCount > uxMaxItems )
+				{
+					uxCount = uxMaxItems;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvCopyItemsFromQueue( pxQueue, pvBuffer, uxCount );
+				traceQUEUE_RECEIVE( pxQueue );
+
+				if( prvUnblockSenders( pxQueue, uxCount ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return uxCount;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return ( UBaseType_t ) 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return ( UBaseType_t ) 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+
+#if( configUSE_MUTEXES == 1 )
+	BaseType_t xInheritanceOccurred = pdFALSE;
+#endif
+
+#if( configUSE_MUTEX_METRICS == 1 )
+	uint32_t ulWaitStart = 0;
+#endif
+
+	/* Check the queue pointer is not NULL. */
+	configASSERT( ( pxQueue ) );
 
-#if( configUSE_MUTEXES == 1 )
-	BaseType_t xInheritanceOccurred = pdFALSE;
-#endif
-
-	/* Check the queue pointer is not NULL. */
-	configASSERT( ( pxQueue ) );
-
 	/* Check this really is a semaphore, in which case the item size will be
 	0. */
 	configASSERT( pxQueue->uxItemSize == 0 );
@@ -1464,6 +1994,12 @@ Queue_t * const pxQueue = xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+						#if( configUSE_MUTEX_METRICS == 1 )
+						{
+							prvRecordMutexTaken( pxQueue, xEntryTimeSet, ulWaitStart );
+						}
+						#endif
 					}
 					else
 					{
@@ -1518,6 +2054,12 @@ Queue_t * const pxQueue = xQueue;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if( configUSE_MUTEX_METRICS == 1 )
+					{
+						ulWaitStart = portGET_CYCLE_COUNT();
+					}
+					#endif
 				}
 				else
 				{
@@ -1552,6 +2094,16 @@ Queue_t * const pxQueue = xQueue;
 						taskENTER_CRITICAL();
 						{
 							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+							#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+							{
+								/* If the holder is itself blocked on a mutex
+								then the priority has to reach the holder of
+								that mutex too, and so on down the chain. */
+								vTaskSetMutexBlockedOn( ( void * ) pxQueue );
+								prvInheritAlongChain( pxQueue->u.xSemaphore.xMutexHolder );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1572,6 +2124,13 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+				{
+					/* Running again, so no longer blocked on the mutex. */
+					vTaskSetMutexBlockedOn( NULL );
+				}
+				#endif
 			}
 			else
 			{
@@ -1611,6 +2170,14 @@ Queue_t * const pxQueue = xQueue;
 							task that is waiting for the same mutex. */
 							uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
 							vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+
+							#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+							{
+								/* Holders further along the chain may also
+								have inherited this task's priority. */
+								prvDisinheritAlongChain( pxQueue->u.xSemaphore.xMutexHolder );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1869,6 +2436,71 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxCount;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comment in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxCount = pxQueue->uxMessagesWaiting;
+
+		/* Cannot block in an ISR, so check there is data available. */
+		if( uxCount > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			if( uxCount > uxMaxItems )
+			{
+				uxCount = uxMaxItems;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyItemsFromQueue( pxQueue, pvBuffer, uxCount );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead update the lock count so the task that unlocks the queue
+			will know that an ISR has removed data while the queue was
+			locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( ( prvUnblockSenders( pxQueue, uxCount ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxCount );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
 {
 BaseType_t xReturn;
@@ -1985,7 +2617,7 @@ Queue_t * const pxQueue = xQueue;
 	{
 		/* The queue can only have been allocated dynamically - free it
 		again. */
-		vPortFree( pxQueue );
+		configKERNEL_OBJECT_FREE( pxQueue );
 	}
 	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 	{
@@ -1993,7 +2625,7 @@ Queue_t * const pxQueue = xQueue;
 		check before attempting to free the memory. */
 		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 		{
-			vPortFree( pxQueue );
+			configKERNEL_OBJECT_FREE( pxQueue );
 		}
 		else
 		{
@@ -2067,67 +2699,88 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
-{
-BaseType_t xReturn = pdFALSE;
-UBaseType_t uxMessagesWaiting;
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
 
-	/* This function is called from a critical section. */
+	static void prvInheritAlongChain( TaskHandle_t xMutexHolder )
+	{
+	const Queue_t *pxBlockedOn;
+	TaskHandle_t xNextHolder;
 
-	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+		/* Each holder along the chain that runs below the priority of the
+		calling task inherits it, and is moved to its new place in the list of
+		tasks waiting for the mutex it is blocked on.  The walk stops at the
+		first holder that is not raised, so it also ends if the chain loops
+		back on itself. */
+		pxBlockedOn = ( const Queue_t * ) pvTaskGetMutexBlockedOn( xMutexHolder );
 
-	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-	{
-		#if ( configUSE_MUTEXES == 1 )
+		while( pxBlockedOn != NULL )
 		{
-			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			xNextHolder = pxBlockedOn->u.xSemaphore.xMutexHolder;
+
+			if( xTaskPriorityInheritChained( xNextHolder ) != pdFALSE )
 			{
-				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-				pxQueue->u.xSemaphore.xMutexHolder = NULL;
+				pxBlockedOn = ( const Queue_t * ) pvTaskGetMutexBlockedOn( xNextHolder );
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				pxBlockedOn = NULL;
 			}
 		}
-		#endif /* configUSE_MUTEXES */
 	}
-	else if( xPosition == queueSEND_TO_BACK )
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvDisinheritAlongChain( TaskHandle_t xMutexHolder )
 	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
-		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-		{
-			pxQueue->pcWriteTo = pxQueue->pcHead;
-		}
-		else
+	const Queue_t *pxBlockedOn;
+	TaskHandle_t xNextHolder;
+
+		/* Each holder along the chain drops back to the highest priority
+		still waiting for the mutex it holds, which has to be read only after
+		the previous holder has been moved to its new place in that list.  The
+		walk stops at the first holder whose priority does not change. */
+		pxBlockedOn = ( const Queue_t * ) pvTaskGetMutexBlockedOn( xMutexHolder );
+
+		while( pxBlockedOn != NULL )
 		{
-			mtCOVERAGE_TEST_MARKER();
+			xNextHolder = pxBlockedOn->u.xSemaphore.xMutexHolder;
+
+			if( xTaskPriorityDisinheritChainedAfterTimeout( xNextHolder, prvGetDisinheritPriorityAfterTimeout( pxBlockedOn ) ) != pdFALSE )
+			{
+				pxBlockedOn = ( const Queue_t * ) pvTaskGetMutexBlockedOn( xNextHolder );
+			}
+			else
+			{
+				pxBlockedOn = NULL;
+			}
 		}
 	}
-	else
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_METRICS == 1 )
+
+	static void prvRecordMutexTaken( Queue_t * const pxMutex, const BaseType_t xWaited, const uint32_t ulWaitStart )
 	{
-		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
-		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
-		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-		{
-			pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+	MutexMetrics_t * const pxMetrics = &( pxMutex->u.xSemaphore.xMetrics );
+	const uint32_t ulNow = portGET_CYCLE_COUNT();
 
-		if( xPosition == queueOVERWRITE )
+		pxMutex->u.xSemaphore.ulTakenAt = ulNow;
+		( pxMetrics->ulAcquisitions )++;
+
+		/* The mutex was contended if it was held by another task when the
+		calling task first tried to take it. */
+		if( xWaited != pdFALSE )
 		{
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			( pxMetrics->ulContendedAcquisitions )++;
+
+			if( ( ulNow - ulWaitStart ) > pxMetrics->ulMaxWaitCycles )
 			{
-				/* An item is not being added but overwritten, so subtract
-				one from the recorded number of items in the queue so when
-				one is added again below the number of recorded items remains
-				correct. */
-				--uxMessagesWaiting;
+				pxMetrics->ulMaxWaitCycles = ulNow - ulWaitStart;
 			}
 			else
 			{
@@ -2140,9 +2793,121 @@ UBaseType_t uxMessagesWaiting;
 		}
 	}
 
-	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+#endif /* configUSE_MUTEX_METRICS */
+/*-----------------------------------------------------------*/
 
-	return xReturn;
+#if( configUSE_MUTEX_METRICS == 1 )
+
+	static void prvRecordMutexGiven( Queue_t * const pxMutex )
+	{
+	MutexMetrics_t * const pxMetrics = &( pxMutex->u.xSemaphore.xMetrics );
+	uint32_t ulHeld;
+
+		/* The give that makes a new mutex available has no holder to time. */
+		if( pxMutex->u.xSemaphore.xMutexHolder != NULL )
+		{
+			ulHeld = portGET_CYCLE_COUNT() - pxMutex->u.xSemaphore.ulTakenAt;
+
+			if( ulHeld > pxMetrics->ulMaxHoldCycles )
+			{
+				pxMetrics->ulMaxHoldCycles = ulHeld;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_METRICS */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
+{
+BaseType_t xReturn = pdFALSE;
+UBaseType_t uxMessagesWaiting;
+
+	/* This function is called from a critical section. */
+
+	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+	{
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				#if( configUSE_MUTEX_METRICS == 1 )
+				{
+					prvRecordMutexGiven( pxQueue );
+				}
+				#endif
+
+				/* The mutex is no longer being held. */
+				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+				pxQueue->u.xSemaphore.xMutexHolder = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_MUTEXES */
+	}
+	else if( xPosition == queueSEND_TO_BACK )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xPosition == queueOVERWRITE )
+		{
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				/* An item is not being added but overwritten, so subtract
+				one from the recorded number of items in the queue so when
+				one is added again below the number of recorded items remains
+				correct. */
+				--uxMessagesWaiting;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -2164,6 +2929,201 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const void *pvItemsToQueue, const UBaseType_t uxItemCount )
+{
+size_t xFirstBytes, xTotalBytes;
+
+	/* This function is called from a critical section. */
+
+	xTotalBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+
+	/* The items run from pcWriteTo up to the end of the storage area, then
+	wrap to its start. */
+	xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e9033 Pointer difference within the storage area. */
+	if( xFirstBytes > xTotalBytes )
+	{
+		xFirstBytes = xTotalBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemsToQueue, xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+	pxQueue->pcWriteTo += xFirstBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+	if( xTotalBytes > xFirstBytes )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( ( ( const uint8_t * ) pvItemsToQueue )[ xFirstBytes ] ), xTotalBytes - xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xTotalBytes - xFirstBytes ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	{
+		pxQueue->pcWriteTo = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxQueue->uxMessagesWaiting += uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, void * const pvBuffer, const UBaseType_t uxItemCount )
+{
+int8_t *pcReadFrom;
+size_t xFirstBytes, xTotalBytes;
+
+	/* This function is called from a critical section. */
+
+	xTotalBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+
+	/* pcReadFrom points to the item read last, so the first item to read is
+	the one after it. */
+	pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ); /*lint !e946 !e9033 Pointer difference within the storage area. */
+	if( xFirstBytes > xTotalBytes )
+	{
+		xFirstBytes = xTotalBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+
+	if( xTotalBytes > xFirstBytes )
+	{
+		( void ) memcpy( ( void * ) &( ( ( uint8_t * ) pvBuffer )[ xFirstBytes ] ), ( void * ) pxQueue->pcHead, xTotalBytes - xFirstBytes ); /*lint !e9087 Cast to void required by function signature. */
+		pcReadFrom = pxQueue->pcHead + ( xTotalBytes - xFirstBytes ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+	else
+	{
+		pcReadFrom += xFirstBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+
+	/* Leave pcReadFrom on the last item read, as prvCopyDataFromQueue()
+	does. */
+	pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+	pxQueue->uxMessagesWaiting -= uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxItemCount )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+			{
+				/* A single bit stands for any number of items. */
+				uxItemCount = ( UBaseType_t ) 1;
+			}
+			#endif
+
+			/* The set holds one entry per item in its member queues. */
+			for( ; uxItemCount > ( UBaseType_t ) 0; uxItemCount-- )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	/* Each waiting task receives at least one item, so unblock no more tasks
+	than there are items.  uxItemCount is 0 here if the queue set was notified
+	instead. */
+	while( ( uxItemCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxItemCount--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxItemCount )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	/* Each slot freed lets one waiting task send. */
+	while( ( uxItemCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxItemCount--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t prvAddToLockCount( const int8_t cLockCount, const UBaseType_t uxItemCount )
+{
+int8_t cReturn;
+
+	/* The count only decides how many waiting tasks prvUnlockQueue()
+	unblocks, so saturating it at its maximum loses nothing unless more tasks
+	than that are waiting. */
+	if( uxItemCount >= ( UBaseType_t ) ( INT8_MAX - cLockCount ) )
+	{
+		cReturn = INT8_MAX;
+	}
+	else
+	{
+		cReturn = ( int8_t ) ( cLockCount + ( int8_t ) uxItemCount );
+	}
+
+	return cReturn;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2770,7 +3730,30 @@ Queue_t * const pxQueue = xQueue;
 	{
 	QueueSetHandle_t pxQueue;
 
-		pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+		#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+		{
+			/* The set does not queue events, so its storage area holds a single
+			QueueSetBitmap_t whatever the length of its members. */
+			( void ) uxEventQueueLength;
+
+			pxQueue = xQueueGenericCreate( ( UBaseType_t ) 1, ( UBaseType_t ) sizeof( QueueSetBitmap_t ), queueQUEUE_TYPE_SET );
+
+			if( pxQueue != NULL )
+			{
+				( void ) memset( queueSET_BITMAP( ( Queue_t * ) pxQueue ), 0x00, sizeof( QueueSetBitmap_t ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+		}
+		#endif /* configUSE_QUEUE_SET_BITMAP */
+
+		heaptrackSET_CALL_SITE( pxQueue, heaptrackCALL_SITE() );
 
 		return pxQueue;
 	}
@@ -2799,8 +3782,43 @@ Queue_t * const pxQueue = xQueue;
 			}
 			else
 			{
-				( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
-				xReturn = pdPASS;
+				#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+				{
+				QueueSetBitmap_t * const pxSetBitmap = queueSET_BITMAP( ( Queue_t * ) xQueueSet );
+				UBaseType_t uxBit;
+
+					/* Give the member the first bit not in use. */
+					for( uxBit = ( UBaseType_t ) 0; uxBit < queueSET_MAX_MEMBERS; uxBit++ )
+					{
+						if( pxSetBitmap->pxMembers[ uxBit ] == NULL )
+						{
+							break;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					if( uxBit < queueSET_MAX_MEMBERS )
+					{
+						pxSetBitmap->pxMembers[ uxBit ] = ( Queue_t * ) xQueueOrSemaphore;
+						( ( Queue_t * ) xQueueOrSemaphore )->uxQueueSetBit = uxBit;
+						( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+						xReturn = pdPASS;
+					}
+					else
+					{
+						/* The set already has queueSET_MAX_MEMBERS members. */
+						xReturn = pdFAIL;
+					}
+				}
+				#else
+				{
+					( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+					xReturn = pdPASS;
+				}
+				#endif /* configUSE_QUEUE_SET_BITMAP */
 			}
 		}
 		taskEXIT_CRITICAL();
@@ -2834,6 +3852,17 @@ Queue_t * const pxQueue = xQueue;
 		{
 			taskENTER_CRITICAL();
 			{
+				#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+				{
+				QueueSetBitmap_t * const pxSetBitmap = queueSET_BITMAP( ( Queue_t * ) xQueueSet );
+
+					/* The bit may still be set if no select has found the queue
+					empty since it was last posted to. */
+					pxSetBitmap->ulReadyBits &= ~queueSET_BIT( pxQueueOrSemaphore->uxQueueSetBit );
+					pxSetBitmap->pxMembers[ pxQueueOrSemaphore->uxQueueSetBit ] = NULL;
+				}
+				#endif /* configUSE_QUEUE_SET_BITMAP */
+
 				/* The queue is no longer contained in the set. */
 				pxQueueOrSemaphore->pxQueueSetContainer = NULL;
 			}
@@ -2853,8 +3882,17 @@ Queue_t * const pxQueue = xQueue;
 	{
 	QueueSetMemberHandle_t xReturn = NULL;
 
-		( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
-		return xReturn;
+		#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+		{
+			( void ) prvSelectFromSet( ( Queue_t * ) xQueueSet, &xReturn, ( UBaseType_t ) 1, xTicksToWait );
+		}
+		#else
+		{
+			( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
+		}
+		#endif /* configUSE_QUEUE_SET_BITMAP */
+
+		return xReturn;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
@@ -2866,14 +3904,307 @@ Queue_t * const pxQueue = xQueue;
 	{
 	QueueSetMemberHandle_t xReturn = NULL;
 
-		( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
+		#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				( void ) prvSelectReadyMembers( ( Queue_t * ) xQueueSet, &xReturn, ( UBaseType_t ) 1 );
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#else
+		{
+			( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
+		}
+		#endif /* configUSE_QUEUE_SET_BITMAP */
+
 		return xReturn;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	UBaseType_t uxQueueSelectManyFromSet( QueueSetHandle_t xQueueSet, QueueSetMemberHandle_t * const pxMembers, const UBaseType_t uxMaxMembers, TickType_t const xTicksToWait )
+	{
+		return prvSelectFromSet( ( Queue_t * ) xQueueSet, pxMembers, uxMaxMembers, xTicksToWait );
+	}
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	static UBaseType_t prvSelectFromSet( Queue_t * const pxQueueSet, QueueSetMemberHandle_t * const pxMembers, const UBaseType_t uxMaxMembers, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	UBaseType_t uxSelected;
+
+		configASSERT( pxQueueSet );
+		configASSERT( pxMembers );
+		configASSERT( uxMaxMembers > ( UBaseType_t ) 0 );
+
+		/* Cannot block if the scheduler is suspended. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* This function follows the structure of xQueueReceive(), with the
+		ready bitmap of the set in place of its items. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				uxSelected = prvSelectReadyMembers( pxQueueSet, pxMembers, uxMaxMembers );
+
+				if( uxSelected > ( UBaseType_t ) 0 )
+				{
+					traceQUEUE_RECEIVE( pxQueueSet );
+					taskEXIT_CRITICAL();
+					return uxSelected;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* No member contains data and no block time is
+						specified (or the block time has expired). */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueueSet );
+						return ( UBaseType_t ) 0;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can post to the members now the
+			critical section has been exited.  A member posted to while the set
+			is locked sets its bit, and leaves the waking of this task to
+			prvUnlockQueue(). */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueueSet );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueSetEmpty( pxQueueSet ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueueSet );
+					vTaskPlaceOnEventList( &( pxQueueSet->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueueSet );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* A bit is set.  Loop back to select the member. */
+					prvUnlockQueue( pxQueueSet );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  If no bit is set exit, otherwise loop back to
+				select the member. */
+				prvUnlockQueue( pxQueueSet );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueSetEmpty( pxQueueSet ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueueSet );
+					return ( UBaseType_t ) 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	static UBaseType_t prvSelectReadyMembers( Queue_t * const pxQueueSet, QueueSetMemberHandle_t * const pxMembers, const UBaseType_t uxMaxMembers )
+	{
+	QueueSetBitmap_t * const pxSetBitmap = queueSET_BITMAP( pxQueueSet );
+	uint32_t ulUnvisited = pxSetBitmap->ulReadyBits, ulCandidates;
+	UBaseType_t uxBit, uxSelected = ( UBaseType_t ) 0;
+
+		while( ( uxSelected < uxMaxMembers ) && ( ulUnvisited != ( uint32_t ) 0UL ) )
+		{
+			/* Take the lowest unvisited bit at or above uxNextBit, wrapping to
+			the lowest unvisited bit if there is none, so a member that is
+			always ready cannot starve the members after it. */
+			ulCandidates = ulUnvisited & ~( queueSET_BIT( pxSetBitmap->uxNextBit ) - ( uint32_t ) 1UL );
+
+			if( ulCandidates == ( uint32_t ) 0UL )
+			{
+				ulCandidates = ulUnvisited;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxBit = prvGetLowestBit( ulCandidates );
+			ulUnvisited &= ~queueSET_BIT( uxBit );
+			pxSetBitmap->uxNextBit = ( uxBit + ( UBaseType_t ) 1 ) % queueSET_MAX_MEMBERS;
+
+			if( pxSetBitmap->pxMembers[ uxBit ]->uxMessagesWaiting != ( UBaseType_t ) 0 )
+			{
+				pxMembers[ uxSelected ] = ( QueueSetMemberHandle_t ) pxSetBitmap->pxMembers[ uxBit ];
+				uxSelected++;
+			}
+			else
+			{
+				/* The member has been emptied since it was posted to. */
+				pxSetBitmap->ulReadyBits &= ~queueSET_BIT( uxBit );
+			}
+		}
+
+		return uxSelected;
+	}
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	static BaseType_t prvIsQueueSetEmpty( const Queue_t *pxQueueSet )
+	{
+	BaseType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( queueSET_BITMAP( pxQueueSet )->ulReadyBits == ( uint32_t ) 0UL )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	static UBaseType_t prvGetLowestBit( uint32_t ulBits )
+	{
+	UBaseType_t uxBit;
+
+		/* Isolate the least significant set bit. */
+		ulBits &= ( ( uint32_t ) 0UL ) - ulBits;
+
+		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+		{
+			/* The port's ready priority lookup finds the most significant set
+			bit with a single instruction, and only one bit is now set. */
+			portGET_HIGHEST_PRIORITY( uxBit, ulBits );
+		}
+		#else
+		{
+			uxBit = 0;
+
+			while( ( ulBits >>= 1 ) != ( uint32_t ) 0UL )
+			{
+				uxBit++;
+			}
+		}
+		#endif
+
+		return uxBit;
+	}
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition )
+	{
+	Queue_t *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	int8_t cTxLock;
+	BaseType_t xReturn = pdFALSE;
+
+		/* This function must be called form a critical section. */
+
+		configASSERT( pxQueueSetContainer );
+
+		( void ) xCopyPosition;
+
+		cTxLock = pxQueueSetContainer->cTxLock;
+
+		traceQUEUE_SEND( pxQueueSetContainer );
+
+		/* Setting the bit of the queue replaces posting its handle to the
+		set. */
+		queueSET_BITMAP( pxQueueSetContainer )->ulReadyBits |= queueSET_BIT( pxQueue->uxQueueSetBit );
+
+		if( cTxLock == queueUNLOCKED )
+		{
+			if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					/* The task waiting has a higher priority. */
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* Unlike the queue of handles, the bitmap never fills, so every
+			send to a member while the set is locked reaches here.  Saturate
+			the count rather than let it wrap back to queueUNLOCKED. */
+			pxQueueSetContainer->cTxLock = prvAddToLockCount( cTxLock, ( UBaseType_t ) 1 );
+		}
+
+		return xReturn;
+	}
+
+#elif ( configUSE_QUEUE_SETS == 1 )
 
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition )
 	{
@@ -2927,4 +4258,361 @@ Queue_t * const pxQueue = xQueue;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateZeroCopy( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize )
+	{
+	Queue_t *pxNewQueue;
+	size_t xHeaderSizeInBytes, xQueueSizeInBytes, xStateSizeInBytes;
+	uint8_t *pucQueueStorage;
+	QueueZeroCopy_t *pxZeroCopy;
+
+		configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+		configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+		/* The slots are handed to the application, so the storage area starts
+		on an aligned address, as does the state that follows it.  The queue
+		structure is allocated like any other queue, on a
+		portCONTROL_BLOCK_ALIGNMENT boundary, and the storage area starts on
+		the next such boundary after it. */
+		xHeaderSizeInBytes = ( sizeof( Queue_t ) + ( size_t ) portCONTROL_BLOCK_ALIGNMENT - ( size_t ) 1 ) & ~( ( size_t ) portCONTROL_BLOCK_ALIGNMENT - ( size_t ) 1 );
+		xQueueSizeInBytes = queueZERO_COPY_ALIGN( uxQueueLength * uxItemSize );
+		xStateSizeInBytes = sizeof( QueueZeroCopy_t ) + ( size_t ) uxQueueLength;
+
+		pxNewQueue = ( Queue_t * ) configKERNEL_OBJECT_MALLOC( xHeaderSizeInBytes + xQueueSizeInBytes + xStateSizeInBytes ); /*lint !e9087 !e9079 see comment in xQueueGenericCreate(). */
+
+		if( pxNewQueue != NULL )
+		{
+			heaptrackSET_CALL_SITE( pxNewQueue, heaptrackCALL_SITE() );
+
+			pucQueueStorage = ( uint8_t * ) pxNewQueue;
+			pucQueueStorage += xHeaderSizeInBytes; /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxNewQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage, queueQUEUE_TYPE_ZERO_COPY, pxNewQueue );
+
+			/* All indexes start at the first slot, and all slots are free. */
+			pxZeroCopy = queueZERO_COPY( pxNewQueue );
+			( void ) memset( ( void * ) pxZeroCopy, 0x00, xStateSizeInBytes );
+		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_ZERO_COPY );
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static UBaseType_t prvZeroCopySlotsAvailable( const Queue_t *pxQueue, const BaseType_t xSide )
+	{
+	const QueueZeroCopy_t * const pxZeroCopy = queueZERO_COPY( pxQueue );
+	UBaseType_t uxReturn;
+
+		if( xSide == queueZERO_COPY_PRODUCER )
+		{
+			uxReturn = pxQueue->uxLength - ( pxZeroCopy->uxAcquired + pxQueue->uxMessagesWaiting + pxZeroCopy->uxBorrowed );
+		}
+		else
+		{
+			uxReturn = pxQueue->uxMessagesWaiting;
+		}
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static BaseType_t prvIsZeroCopyQueueExhausted( const Queue_t *pxQueue, const BaseType_t xSide )
+	{
+	BaseType_t xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( prvZeroCopySlotsAvailable( pxQueue, xSide ) == ( UBaseType_t ) 0 )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueGenericGetSlot( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xSide )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = xQueue;
+	QueueZeroCopy_t *pxZeroCopy;
+	uint8_t *pucStates;
+	UBaseType_t uxSlot;
+
+		configASSERT( pxQueue );
+		queueASSERT_ZERO_COPY( pxQueue );
+
+		/* Cannot block if the scheduler is suspended. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		pxZeroCopy = queueZERO_COPY( pxQueue );
+		pucStates = queueZERO_COPY_STATES( pxZeroCopy );
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* To be running the calling task must be the highest priority
+				task waiting for a slot, so it takes the next one. */
+				if( prvZeroCopySlotsAvailable( pxQueue, xSide ) > ( UBaseType_t ) 0 )
+				{
+					if( xSide == queueZERO_COPY_PRODUCER )
+					{
+						uxSlot = pxZeroCopy->uxAcquireIndex;
+						configASSERT( pucStates[ uxSlot ] == queueSLOT_FREE );
+						pucStates[ uxSlot ] = queueSLOT_ACQUIRED;
+						pxZeroCopy->uxAcquireIndex = queueZERO_COPY_NEXT( pxQueue, uxSlot );
+						( pxZeroCopy->uxAcquired )++;
+					}
+					else
+					{
+						uxSlot = pxZeroCopy->uxBorrowIndex;
+						configASSERT( pucStates[ uxSlot ] == queueSLOT_COMMITTED );
+						pucStates[ uxSlot ] = queueSLOT_BORROWED;
+						pxZeroCopy->uxBorrowIndex = queueZERO_COPY_NEXT( pxQueue, uxSlot );
+						( pxZeroCopy->uxBorrowed )++;
+						pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+						traceQUEUE_RECEIVE( pxQueue );
+					}
+
+					taskEXIT_CRITICAL();
+					return ( void * ) ( pxQueue->pcHead + ( uxSlot * pxQueue->uxItemSize ) ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* No slot and no block time is specified (or the block
+						time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+
+						if( xSide == queueZERO_COPY_PRODUCER )
+						{
+							traceQUEUE_SEND_FAILED( pxQueue );
+						}
+						else
+						{
+							traceQUEUE_RECEIVE_FAILED( pxQueue );
+						}
+
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* No slot and a block time was specified so configure
+						the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Other tasks can acquire, commit, borrow and release slots now the
+			critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsZeroCopyQueueExhausted( pxQueue, xSide ) != pdFALSE )
+				{
+					/* Producers wait with the tasks waiting to send, and
+					consumers with the tasks waiting to receive. */
+					if( xSide == queueZERO_COPY_PRODUCER )
+					{
+						traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+						vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					}
+					else
+					{
+						traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+						vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					}
+
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* A slot became available.  Loop back to take it. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  If there is still no slot exit, otherwise loop
+				back to take it. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsZeroCopyQueueExhausted( pxQueue, xSide ) != pdFALSE )
+				{
+					if( xSide == queueZERO_COPY_PRODUCER )
+					{
+						traceQUEUE_SEND_FAILED( pxQueue );
+					}
+					else
+					{
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+					}
+
+					return NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void vQueueGenericPutSlot( QueueHandle_t xQueue, void * const pvSlot, const BaseType_t xSide )
+	{
+	Queue_t * const pxQueue = xQueue;
+	QueueZeroCopy_t *pxZeroCopy;
+	uint8_t *pucStates;
+	List_t *pxWaitingList;
+	UBaseType_t uxSlot, uxMadeAvailable = 0;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		configASSERT( pxQueue );
+		queueASSERT_ZERO_COPY( pxQueue );
+
+		/* The slot must be one returned by pvQueueGenericGetSlot(). */
+		configASSERT( ( ( int8_t * ) pvSlot >= pxQueue->pcHead ) && ( ( int8_t * ) pvSlot < pxQueue->u.xQueue.pcTail ) );
+		uxSlot = ( UBaseType_t ) ( ( ( int8_t * ) pvSlot - pxQueue->pcHead ) ) / pxQueue->uxItemSize;
+		configASSERT( ( pxQueue->pcHead + ( uxSlot * pxQueue->uxItemSize ) ) == ( int8_t * ) pvSlot );
+
+		pxZeroCopy = queueZERO_COPY( pxQueue );
+		pucStates = queueZERO_COPY_STATES( pxZeroCopy );
+
+		taskENTER_CRITICAL();
+		{
+			if( xSide == queueZERO_COPY_PRODUCER )
+			{
+				configASSERT( pucStates[ uxSlot ] == queueSLOT_ACQUIRED );
+				pucStates[ uxSlot ] = queueSLOT_COMMITTED;
+
+				/* Consumers see the slots in the order they were acquired, so
+				this commit may also make later, already committed, slots
+				available. */
+				while( ( pxZeroCopy->uxAcquired > ( UBaseType_t ) 0 ) && ( pucStates[ pxZeroCopy->uxCommitIndex ] == queueSLOT_COMMITTED ) )
+				{
+					pxZeroCopy->uxCommitIndex = queueZERO_COPY_NEXT( pxQueue, pxZeroCopy->uxCommitIndex );
+					( pxZeroCopy->uxAcquired )--;
+					pxQueue->uxMessagesWaiting = pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1;
+					uxMadeAvailable++;
+					traceQUEUE_SEND( pxQueue );
+				}
+
+				pxWaitingList = &( pxQueue->xTasksWaitingToReceive );
+			}
+			else
+			{
+				configASSERT( pucStates[ uxSlot ] == queueSLOT_BORROWED );
+				pucStates[ uxSlot ] = queueSLOT_RELEASED;
+
+				/* Slots are acquired in order, so this release may also free
+				later, already released, slots. */
+				while( ( pxZeroCopy->uxBorrowed > ( UBaseType_t ) 0 ) && ( pucStates[ pxZeroCopy->uxReleaseIndex ] == queueSLOT_RELEASED ) )
+				{
+					pucStates[ pxZeroCopy->uxReleaseIndex ] = queueSLOT_FREE;
+					pxZeroCopy->uxReleaseIndex = queueZERO_COPY_NEXT( pxQueue, pxZeroCopy->uxReleaseIndex );
+					( pxZeroCopy->uxBorrowed )--;
+					uxMadeAvailable++;
+				}
+
+				pxWaitingList = &( pxQueue->xTasksWaitingToSend );
+			}
+
+			/* Unblock the highest priority waiting task for each slot made
+			available to the other side. */
+			while( ( uxMadeAvailable > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE ) )
+			{
+				if( xTaskRemoveFromEventList( pxWaitingList ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxMadeAvailable--;
+			}
+
+			if( xYieldRequired != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
 
+#endif /* configUSE_ZERO_COPY_QUEUES */
@@ -73,6 +73,11 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_ZERO_COPY			( ( uint8_t ) 5U )
+
+/* For internal use only.  The two sides of a zero copy queue. */
+#define queueZERO_COPY_PRODUCER		( ( BaseType_t ) 0 )
+#define queueZERO_COPY_CONSUMER		( ( BaseType_t ) 1 )
 
 /**
  * queue. h
@@ -1384,6 +1389,137 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultiple(
+									QueueHandle_t xQueue,
+									const void * const pvItemsToQueue,
+									const UBaseType_t uxItemCount,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue.  The items are copied
+ * in one critical section, and the tasks the items unblock lead to at most one
+ * context switch, where xQueueSend() would enter a critical section and decide
+ * whether to switch once per item.
+ *
+ * As many items are sent as there is space for.  The task only blocks while
+ * the queue is full, so fewer than uxItemCount items may be sent even if a
+ * block time is given.  Cannot be used with semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to uxItemCount items, one after another,
+ * each of the size the queue was created with.
+ *
+ * @param uxItemCount The number of items at pvItemsToQueue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.
+ *
+ * @return The number of items sent, from the start of pvItemsToQueue.  0 if
+ * the queue stayed full for the whole block time.
+ *
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultipleFromISR(
+										  QueueHandle_t xQueue,
+										  const void * const pvItemsToQueue,
+										  const UBaseType_t uxItemCount,
+										  BaseType_t *pxHigherPriorityTaskWoken
+									  );
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be used in an interrupt service
+ * routine.  It never blocks.
+ *
+ * Example usage, for an ISR that drains a FIFO of samples:
+   <pre>
+ void vSampleISR( void )
+ {
+ BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ uint16_t usSamples[ 32 ];
+ UBaseType_t uxCount;
+
+	uxCount = uxReadSampleFIFO( usSamples, 32 );
+
+	// One post, and at most one switch, for the whole burst.
+	xQueueSendMultipleFromISR( xSampleQueue, usSamples, uxCount, &xHigherPriorityTaskWoken );
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ }
+ </pre>
+ *
+ * @return The number of items sent.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultiple(
+									   QueueHandle_t xQueue,
+									   void * const pvBuffer,
+									   const UBaseType_t uxMaxItems,
+									   TickType_t xTicksToWait
+								   );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue, oldest first, in one critical
+ * section and with at most one context switch.  The task only blocks while the
+ * queue is empty, and then returns as soon as there is at least one item.
+ * Cannot be used with semaphores or mutexes.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item should the queue be empty.
+ *
+ * @return The number of items received.  0 if the queue stayed empty for the
+ * whole block time.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultipleFromISR(
+											 QueueHandle_t xQueue,
+											 void * const pvBuffer,
+											 const UBaseType_t uxMaxItems,
+											 BaseType_t *pxHigherPriorityTaskWoken
+										 );
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be used in an interrupt
+ * service routine.  It never blocks.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1639,6 +1775,151 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet, const Ti
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when configUSE_QUEUE_SET_BITMAP is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * With configUSE_QUEUE_SET_BITMAP set to 1 a queue set keeps one ready bit per
+ * member instead of a queue of member handles, so sending to a member sets a
+ * bit rather than also sending to the set, and a set holds at most 32 members
+ * whatever their lengths.  The uxEventQueueLength parameter of
+ * xQueueCreateSet() is then not used.  A member is selected while it contains
+ * data (or, for a semaphore, while it is available), rather than once per item
+ * posted, and ready members are selected in turn.  Note 4 of xQueueCreateSet()
+ * still applies.
+ *
+ * uxQueueSelectManyFromSet() is a version of xQueueSelectFromSet() that
+ * selects every ready member of the set at once, up to uxMaxMembers of them,
+ * so a task serving many queues can service all that are ready with one call.
+ *
+ * @param xQueueSet The queue set on which the task will (potentially) block.
+ *
+ * @param pxMembers An array of at least uxMaxMembers handles, to which the
+ * selected members are written.
+ *
+ * @param uxMaxMembers The maximum number of members to select.
+ *
+ * @param xTicksToWait The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state to wait for any member of the queue set to be
+ * ready for a successful queue read or semaphore take operation.
+ *
+ * @return The number of members written to pxMembers, or 0 if no member was
+ * ready before the block time expired.
+ */
+UBaseType_t uxQueueSelectManyFromSet( QueueSetHandle_t xQueueSet, QueueSetMemberHandle_t * const pxMembers, const UBaseType_t uxMaxMembers, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Zero copy queues.  configUSE_ZERO_COPY_QUEUES must be set to 1 in
+ * FreeRTOSConfig.h for these functions to be available.
+ *
+ * Items are normally queued by copy: xQueueSend() copies the item into the
+ * queue storage area and xQueueReceive() copies it out again.  A zero copy
+ * queue instead hands out the slots of its storage area.  A producer acquires
+ * a free slot, fills it in place and commits it.  A consumer borrows the oldest
+ * committed slot, uses it in place and releases it, after which the slot can be
+ * acquired again.  The cost of passing an item therefore does not depend on its
+ * size.
+ *
+ * Slots are borrowed in the order they were acquired.  A slot committed before
+ * an older one is held back until the older one is committed too.  Slots can
+ * be released in any order, but a slot is only acquired again once all older
+ * slots have been released.  Tasks blocked in pvQueueAcquireSlot() and
+ * pvQueueBorrowSlot() are unblocked in priority order, as with xQueueSend() and
+ * xQueueReceive().
+ *
+ * A zero copy queue must only be used with the functions below, so it must not
+ * be reset, added to a queue set, or used with the normal send and receive
+ * functions.  uxQueueMessagesWaiting() returns the number of committed slots
+ * that have not yet been borrowed.  The functions must not be called from an
+ * interrupt.
+ */
+
+/*
+ * Creates a zero copy queue of uxQueueLength slots of uxItemSize bytes each.
+ * The first slot is aligned to portBYTE_ALIGNMENT.  The other slots are also
+ * aligned if uxItemSize is a multiple of portBYTE_ALIGNMENT.  There is no
+ * statically allocated version.
+ *
+ * @return The handle of the queue, or NULL if the queue could not be allocated.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	QueueHandle_t xQueueCreateZeroCopy( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * void *pvQueueAcquireSlot( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ *
+ * Acquires a free slot of a zero copy queue, to be filled in place and then
+ * passed to vQueueCommitSlot().  If no slot is free, waits up to xTicksToWait
+ * ticks for a consumer to release one.
+ *
+ * @return A pointer to the slot, or NULL if no slot became free in time.
+ */
+#define pvQueueAcquireSlot( xQueue, xTicksToWait ) pvQueueGenericGetSlot( ( xQueue ), ( xTicksToWait ), queueZERO_COPY_PRODUCER )
+
+/*
+ * void vQueueCommitSlot( QueueHandle_t xQueue, void *pvSlot );
+ *
+ * Commits a slot returned by pvQueueAcquireSlot(), making it available to
+ * consumers.  The producer must not access the slot afterwards.
+ */
+#define vQueueCommitSlot( xQueue, pvSlot ) vQueueGenericPutSlot( ( xQueue ), ( pvSlot ), queueZERO_COPY_PRODUCER )
+
+/*
+ * void *pvQueueBorrowSlot( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ *
+ * Borrows the oldest committed slot of a zero copy queue, to be used in place
+ * and then passed to vQueueReleaseSlot().  If no slot is committed, waits up
+ * to xTicksToWait ticks for a producer to commit one.
+ *
+ * @return A pointer to the slot, or NULL if no slot was committed in time.
+ */
+#define pvQueueBorrowSlot( xQueue, xTicksToWait ) pvQueueGenericGetSlot( ( xQueue ), ( xTicksToWait ), queueZERO_COPY_CONSUMER )
+
+/*
+ * void vQueueReleaseSlot( QueueHandle_t xQueue, void *pvSlot );
+ *
+ * Releases a slot returned by pvQueueBorrowSlot(), so that producers can
+ * acquire it again.  The consumer must not access the slot afterwards.
+ */
+#define vQueueReleaseSlot( xQueue, pvSlot ) vQueueGenericPutSlot( ( xQueue ), ( pvSlot ), queueZERO_COPY_CONSUMER )
+
+/*
+ * The functions behind the zero copy queue macros.  Use the macros instead.
+ */
+void *pvQueueGenericGetSlot( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xSide ) PRIVILEGED_FUNCTION;
+void vQueueGenericPutSlot( QueueHandle_t xQueue, void * const pvSlot, const BaseType_t xSide ) PRIVILEGED_FUNCTION;
+
+/*
+ * Mutex metrics.  configUSE_MUTEX_METRICS must be set to 1 in FreeRTOSConfig.h
+ * for the following type and function to be available.
+ *
+ * Each mutex counts the number of times it has been taken, and how many of
+ * those takes found it held by another task and so had to wait.  It also keeps
+ * the longest time it has been held, from being taken to being given back, and
+ * the longest time a task has waited to take it.  A recursive mutex is held
+ * from its outermost take to its outermost give.  Times are measured with
+ * portGET_CYCLE_COUNT(), so are in CPU cycles and wrap once they exceed the
+ * range of the cycle counter.  Takes that time out are not counted.
+ */
+#if( configUSE_MUTEX_METRICS == 1 )
+
+	typedef struct xMUTEX_METRICS
+	{
+		uint32_t ulAcquisitions;			/*< The number of times the mutex has been taken. */
+		uint32_t ulContendedAcquisitions;	/*< The number of those takes that had to wait for another task to give the mutex. */
+		uint32_t ulMaxHoldCycles;			/*< The longest time the mutex has been held. */
+		uint32_t ulMaxWaitCycles;			/*< The longest time a task has waited to take the mutex. */
+	} MutexMetrics_t;
+
+	/*
+	 * For internal use only.  Use vSemaphoreGetMutexMetrics() instead of
+	 * calling this function directly.
+	 */
+	void vQueueGetMutexMetrics( QueueHandle_t xMutex, MutexMetrics_t * const pxMetrics ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MUTEX_METRICS */
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue, TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue ) PRIVILEGED_FUNCTION;
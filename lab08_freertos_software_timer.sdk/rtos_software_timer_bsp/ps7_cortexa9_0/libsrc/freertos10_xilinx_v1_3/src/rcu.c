@@ -0,0 +1,232 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rcu.h"
+#include "heap_track.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include RCU.  This #if is closed at the very bottom of this file. */
+#if( configUSE_RCU == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use RCU
+#endif
+
+/* Bits that can be set in Rcu_t.ucFlags. */
+#define rcuFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 1 ) /* Set if the handle was created by xRcuCreateStatic(). */
+
+typedef struct RcuDefinition
+{
+	void * volatile pvVersion;		/*< The current version.  Only replaced by vRcuPublish(). */
+	void *pvStaticVersion;			/*< The first version when it was not allocated by pvPortMalloc(), so is never freed.  NULL otherwise. */
+	uint8_t ucFlags;
+} Rcu_t;
+
+/*
+ * Frees pvVersion, unless it is the statically allocated first version of
+ * pxRcu.
+ */
+static void prvFreeVersion( Rcu_t * const pxRcu, void *pvVersion ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+RcuHandle_t xRcuCreate( void *pvVersion )
+{
+Rcu_t *pxRcu;
+
+	configASSERT( pvVersion );
+
+	pxRcu = ( Rcu_t * ) pvPortMalloc( sizeof( Rcu_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+	if( pxRcu != NULL )
+	{
+		heaptrackSET_CALL_SITE( pxRcu, heaptrackCALL_SITE() );
+
+		pxRcu->pvVersion = pvVersion;
+		pxRcu->pvStaticVersion = NULL;
+		pxRcu->ucFlags = ( uint8_t ) 0;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxRcu;
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	RcuHandle_t xRcuCreateStatic( void *pvVersion, StaticRcu_t *pxStaticRcu )
+	{
+	Rcu_t * const pxRcu = ( Rcu_t * ) pxStaticRcu; /*lint !e740 !e9087 Safe cast as StaticRcu_t is opaque Rcu_t. */
+	RcuHandle_t xReturn;
+
+		configASSERT( pvVersion );
+		configASSERT( pxStaticRcu );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticRcu_t equals the size of the real RCU
+			structure. */
+			volatile size_t xSize = sizeof( StaticRcu_t );
+			configASSERT( xSize == sizeof( Rcu_t ) );
+		} /*lint !e529 xSize is referenced is configASSERT() is defined. */
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pvVersion != NULL ) && ( pxStaticRcu != NULL ) )
+		{
+			pxRcu->pvVersion = pvVersion;
+			pxRcu->pvStaticVersion = pvVersion;
+			pxRcu->ucFlags = rcuFLAGS_IS_STATICALLY_ALLOCATED;
+			xReturn = pxRcu;
+		}
+		else
+		{
+			xReturn = NULL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vRcuDelete( RcuHandle_t xRcu )
+{
+Rcu_t * const pxRcu = xRcu;
+
+	configASSERT( pxRcu );
+
+	prvFreeVersion( pxRcu, pxRcu->pvVersion );
+
+	if( ( pxRcu->ucFlags & rcuFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+	{
+		vPortFree( pxRcu );
+	}
+	else
+	{
+		/* The handle was statically allocated, so only clear it. */
+		( void ) memset( pxRcu, 0x00, sizeof( Rcu_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+const void *pvRcuReadLock( RcuHandle_t xRcu )
+{
+Rcu_t * const pxRcu = xRcu;
+
+	configASSERT( pxRcu );
+
+	vTaskRcuReadLock();
+
+	return pxRcu->pvVersion;
+}
+/*-----------------------------------------------------------*/
+
+void vRcuReadUnlock( void )
+{
+	vTaskRcuReadUnlock();
+}
+/*-----------------------------------------------------------*/
+
+void *pvRcuCopy( RcuHandle_t xRcu, size_t xSize )
+{
+void *pvCopy;
+
+	configASSERT( xRcu );
+
+	pvCopy = pvPortMalloc( xSize );
+
+	if( pvCopy != NULL )
+	{
+		heaptrackSET_CALL_SITE( pvCopy, heaptrackCALL_SITE() );
+
+		( void ) memcpy( pvCopy, pvRcuReadLock( xRcu ), xSize );
+		vRcuReadUnlock();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvCopy;
+}
+/*-----------------------------------------------------------*/
+
+void vRcuPublish( RcuHandle_t xRcu, void *pvVersion )
+{
+Rcu_t * const pxRcu = xRcu;
+void *pvOldVersion;
+
+	configASSERT( pxRcu );
+	configASSERT( pvVersion );
+
+	/* The contents of the new version must be visible before the pointer to
+	it is. */
+	portDATA_MEMORY_BARRIER();
+
+	pvOldVersion = pxRcu->pvVersion;
+	pxRcu->pvVersion = pvVersion;
+
+	vTaskRcuSynchronize();
+
+	prvFreeVersion( pxRcu, pvOldVersion );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeVersion( Rcu_t * const pxRcu, void *pvVersion )
+{
+	if( pvVersion != pxRcu->pvStaticVersion )
+	{
+		vPortFree( pvVersion );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include RCU.  If you want to include it then ensure configUSE_RCU is set to
+1 in FreeRTOSConfig.h. */
+#endif /* configUSE_RCU == 1 */
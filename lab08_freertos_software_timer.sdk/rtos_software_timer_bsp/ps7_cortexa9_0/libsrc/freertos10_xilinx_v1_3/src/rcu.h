@@ -0,0 +1,165 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef RCU_H
+#define RCU_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include rcu.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Read-copy-update.
+ *
+ * When configUSE_RCU is set to 1 in FreeRTOSConfig.h data that is read often
+ * and written rarely, such as configuration, can be shared through an RCU
+ * handle instead of a mutex.  The handle holds a pointer to the current
+ * version of the data.  A reader enters a read section, which returns the
+ * current version, and leaves it again when it has finished with the data.
+ * Entering and leaving only update the calling task's own TCB, so readers
+ * never wait, and never contend with each other or with a writer.
+ *
+ * A writer never changes a published version.  It copies the current version,
+ * changes the copy, and publishes it.  Readers that enter a section after that
+ * see the new version, while readers already inside their section keep using
+ * the old one.  The old version is freed once every task that was inside a
+ * read section when it was replaced has left that section.  That grace period
+ * is detected through the scheduler: a task switched out inside a read section
+ * is counted as it is switched out, and uncounted as it leaves the section.
+ *
+ * Read sections can be nested, and a task can be preempted inside one, but a
+ * section should be short and should not block, as it delays the freeing of
+ * every version replaced while it is open.  Read sections must not be used
+ * from an interrupt.  A task deleted inside one leaves it.  Versions are
+ * allocated with pvPortMalloc(), apart from the first version of a handle
+ * created by xRcuCreateStatic().  Writers of the same handle must be
+ * serialised by the application, for example by having a single writer task.
+ *
+ * NOTE:  Grace periods rely on only one core running the scheduler, so that a
+ * reader is always switched out while a writer runs.
+ */
+
+struct RcuDefinition;
+typedef struct RcuDefinition * RcuHandle_t;
+
+/**
+ * rcu.h
+ * <pre>RcuHandle_t xRcuCreate( void *pvVersion );</pre>
+ *
+ * Creates an RCU handle that publishes pvVersion.
+ *
+ * @param pvVersion The first version of the data, allocated by pvPortMalloc().
+ * The handle takes ownership of it.
+ *
+ * @return The handle, or NULL if it could not be allocated.
+ */
+RcuHandle_t xRcuCreate( void *pvVersion ) PRIVILEGED_FUNCTION;
+
+/**
+ * rcu.h
+ * <pre>RcuHandle_t xRcuCreateStatic( void *pvVersion, StaticRcu_t *pxStaticRcu );</pre>
+ *
+ * Creates an RCU handle that publishes pvVersion, with pxStaticRcu holding the
+ * handle.  Neither the handle nor pvVersion is ever freed, so pvVersion can be
+ * a static variable.  Versions published after it are freed as usual.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 for xRcuCreateStatic() to
+ * be available.
+ *
+ * @return The handle, or NULL if pvVersion or pxStaticRcu is NULL.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	RcuHandle_t xRcuCreateStatic( void *pvVersion, StaticRcu_t *pxStaticRcu ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rcu.h
+ * <pre>void vRcuDelete( RcuHandle_t xRcu );</pre>
+ *
+ * Frees an RCU handle and its current version, other than a handle or first
+ * version given to xRcuCreateStatic().  No task may be inside a read section
+ * of the handle.
+ */
+void vRcuDelete( RcuHandle_t xRcu ) PRIVILEGED_FUNCTION;
+
+/**
+ * rcu.h
+ * <pre>const void *pvRcuReadLock( RcuHandle_t xRcu );</pre>
+ *
+ * Enters a read section and returns the current version of the data, which
+ * remains valid until the matching vRcuReadUnlock().  The version must not be
+ * written to.
+ */
+const void *pvRcuReadLock( RcuHandle_t xRcu ) PRIVILEGED_FUNCTION;
+
+/**
+ * rcu.h
+ * <pre>void vRcuReadUnlock( void );</pre>
+ *
+ * Leaves the read section entered by the most recent pvRcuReadLock() of the
+ * calling task.
+ */
+void vRcuReadUnlock( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * rcu.h
+ * <pre>void *pvRcuCopy( RcuHandle_t xRcu, size_t xSize );</pre>
+ *
+ * Allocates a new version of the data and initialises it with a copy of the
+ * xSize bytes of the current version, ready to be changed and then passed to
+ * vRcuPublish().
+ *
+ * @return The copy, or NULL if it could not be allocated.
+ */
+void *pvRcuCopy( RcuHandle_t xRcu, size_t xSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * rcu.h
+ * <pre>void vRcuPublish( RcuHandle_t xRcu, void *pvVersion );</pre>
+ *
+ * Makes pvVersion the current version of the data, then waits for the grace
+ * period of the version it replaces to end and frees that version.  The wait
+ * is only as long as the longest read section that was open when the call was
+ * made, and there is no wait at all if no task was inside a read section.
+ * Must not be called from inside a read section.
+ *
+ * @param pvVersion The new version, allocated by pvPortMalloc() or
+ * pvRcuCopy().  The handle takes ownership of it.
+ */
+void vRcuPublish( RcuHandle_t xRcu, void *pvVersion ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RCU_H */
@@ -0,0 +1,451 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spin_lock.h"
+#include "heap_track.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include spin locks.  This #if is closed at the very bottom of this file. */
+#if( configUSE_SPIN_LOCKS == 1 )
+
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 in FreeRTOSConfig.h to use spin locks
+#endif
+
+#if( INCLUDE_uxTaskPriorityGet != 1 )
+	#error INCLUDE_uxTaskPriorityGet must be set to 1 in FreeRTOSConfig.h to use spin locks
+#endif
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use spin locks
+#endif
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use spin locks
+#endif
+
+/*
+ * The lock word is spinlockFREE when the lock is not held, otherwise the
+ * number of the holder's core plus one, with spinlockWAITERS set once a task
+ * has blocked on the lock.  Holding the core in the lock word means a lock is
+ * taken, and its holder's core published, by a single compare and swap.
+ */
+#define spinlockFREE				( ( uint32_t ) 0UL )
+#define spinlockWAITERS				( ( uint32_t ) 0x80000000UL )
+#define spinlockHOLDER( ulLock )	( ( ulLock ) & ~spinlockWAITERS )
+
+/* A task blocked on a lock.  Lives on the stack of the task. */
+typedef struct SpinLockWaiter
+{
+	TaskHandle_t xTask;
+	UBaseType_t uxPriority;
+	struct SpinLockWaiter *pxNext;
+} SpinLockWaiter_t;
+
+typedef struct SpinLockDefinition
+{
+	volatile uint32_t ulLock;		/*< See spinlockFREE. */
+	SpinLockWaiter_t *pxWaiters;	/*< The blocked tasks, highest priority first.  Only accessed from a critical section. */
+} SpinLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Takes the lock if it is free, with a single compare and swap.
+ */
+static BaseType_t prvTryTake( SpinLock_t * const pxLock, const uint32_t ulHolder );
+
+/*
+ * Retries prvTryTake() while the lock is held by another core, waiting for an
+ * event between attempts, up to configSPIN_LOCK_SPIN_COUNT times.
+ */
+static BaseType_t prvSpin( SpinLock_t * const pxLock, const uint32_t ulHolder );
+
+/*
+ * Called from a critical section.  Takes the lock if it is free, marking it as
+ * having waiters if any task is still blocked on it.  Otherwise, if xMark is
+ * pdTRUE, marks the held lock as having waiters so its holder wakes one.
+ */
+static BaseType_t prvTakeOrMark( SpinLock_t * const pxLock, const uint32_t ulHolder, const BaseType_t xMark );
+
+/*
+ * Blocks the calling task on the lock until it is given or xTicksToWait
+ * expires, then takes it if possible.
+ */
+static BaseType_t prvWait( SpinLock_t * const pxLock, const uint32_t ulHolder, TickType_t xTicksToWait );
+
+/*
+ * Called from a critical section.  Removes pxWaiter from the blocked tasks, if
+ * it is still there.
+ */
+static void prvRemoveWaiter( SpinLock_t * const pxLock, const SpinLockWaiter_t * const pxWaiter );
+
+/*-----------------------------------------------------------*/
+
+SpinLockHandle_t xSpinLockCreate( void )
+{
+SpinLock_t *pxLock;
+
+	pxLock = ( SpinLock_t * ) pvPortMalloc( sizeof( SpinLock_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+	if( pxLock != NULL )
+	{
+		heaptrackSET_CALL_SITE( pxLock, heaptrackCALL_SITE() );
+
+		pxLock->ulLock = spinlockFREE;
+		pxLock->pxWaiters = NULL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxLock;
+}
+/*-----------------------------------------------------------*/
+
+void vSpinLockDelete( SpinLockHandle_t xLock )
+{
+SpinLock_t * const pxLock = xLock;
+
+	configASSERT( pxLock );
+	configASSERT( pxLock->ulLock == spinlockFREE );
+
+	vPortFree( pxLock );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTryTake( SpinLock_t * const pxLock, const uint32_t ulHolder )
+{
+BaseType_t xReturn;
+
+	if( ulPortCompareAndSwap( &( pxLock->ulLock ), spinlockFREE, ulHolder ) == spinlockFREE )
+	{
+		/* Nothing guarded by the lock may be accessed before it is held. */
+		portDATA_MEMORY_BARRIER();
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSpin( SpinLock_t * const pxLock, const uint32_t ulHolder )
+{
+BaseType_t xReturn = pdFAIL;
+uint32_t ulSpins, ulLock;
+
+	for( ulSpins = 0; ulSpins < ( uint32_t ) configSPIN_LOCK_SPIN_COUNT; ulSpins++ )
+	{
+		ulLock = pxLock->ulLock;
+
+		if( ulLock == spinlockFREE )
+		{
+			xReturn = prvTryTake( pxLock, ulHolder );
+
+			if( xReturn == pdPASS )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( spinlockHOLDER( ulLock ) == ulHolder )
+		{
+			/* Held by a task of this core, which cannot give the lock while
+			this task spins. */
+			break;
+		}
+		else
+		{
+			/* The holder sends an event as it gives the lock.  An event sent
+			since the lock word was read ends the wait straight away. */
+			portWAIT_FOR_EVENT();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeOrMark( SpinLock_t * const pxLock, const uint32_t ulHolder, const BaseType_t xMark )
+{
+BaseType_t xReturn = pdFAIL;
+uint32_t ulLock, ulNewLock;
+BaseType_t xDone = pdFALSE;
+
+	while( xDone == pdFALSE )
+	{
+		ulLock = pxLock->ulLock;
+
+		if( ulLock == spinlockFREE )
+		{
+			/* A task that takes the lock while others are blocked on it must
+			wake one of them when it gives the lock. */
+			ulNewLock = ( pxLock->pxWaiters != NULL ) ? ( ulHolder | spinlockWAITERS ) : ulHolder;
+
+			if( ulPortCompareAndSwap( &( pxLock->ulLock ), spinlockFREE, ulNewLock ) == spinlockFREE )
+			{
+				portDATA_MEMORY_BARRIER();
+				xReturn = pdPASS;
+				xDone = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( xMark == pdFALSE ) || ( ( ulLock & spinlockWAITERS ) != 0UL ) )
+		{
+			xDone = pdTRUE;
+		}
+		else
+		{
+			/* Fails, and is retried, if the lock was given in the meantime. */
+			if( ulPortCompareAndSwap( &( pxLock->ulLock ), ulLock, ulLock | spinlockWAITERS ) == ulLock )
+			{
+				xDone = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveWaiter( SpinLock_t * const pxLock, const SpinLockWaiter_t * const pxWaiter )
+{
+SpinLockWaiter_t **ppxLink = &( pxLock->pxWaiters );
+
+	while( ( *ppxLink != NULL ) && ( *ppxLink != pxWaiter ) )
+	{
+		ppxLink = &( ( *ppxLink )->pxNext );
+	}
+
+	if( *ppxLink != NULL )
+	{
+		*ppxLink = pxWaiter->pxNext;
+	}
+	else
+	{
+		/* Already removed by the task that gave the lock. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWait( SpinLock_t * const pxLock, const uint32_t ulHolder, TickType_t xTicksToWait )
+{
+SpinLockWaiter_t xWaiter;
+SpinLockWaiter_t **ppxLink;
+TimeOut_t xTimeOut;
+BaseType_t xReturn;
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+	}
+	#endif
+
+	xWaiter.xTask = xTaskGetCurrentTaskHandle();
+	xWaiter.uxPriority = uxTaskPriorityGet( NULL );
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Marking the lock before blocking means the holder wakes a task
+			when it gives the lock, whether it gives it before or after this
+			task blocks. */
+			xReturn = prvTakeOrMark( pxLock, ulHolder, pdTRUE );
+
+			if( xReturn != pdPASS )
+			{
+				/* Behind the tasks of the same or higher priority. */
+				ppxLink = &( pxLock->pxWaiters );
+				while( ( *ppxLink != NULL ) && ( ( *ppxLink )->uxPriority >= xWaiter.uxPriority ) )
+				{
+					ppxLink = &( ( *ppxLink )->pxNext );
+				}
+				xWaiter.pxNext = *ppxLink;
+				*ppxLink = &xWaiter;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn == pdPASS )
+		{
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) ulTaskNotifyTakeIndexed( configSPIN_LOCK_NOTIFY_INDEX, pdTRUE, xTicksToWait );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				prvRemoveWaiter( pxLock, &xWaiter );
+
+				/* The lock may have been given as the wait timed out.  If it
+				is held, the tasks still blocked need its holder to wake one of
+				them, as this task may have been the one woken. */
+				xReturn = prvTakeOrMark( pxLock, ulHolder, ( BaseType_t ) ( pxLock->pxWaiters != NULL ) );
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			{
+				prvRemoveWaiter( pxLock, &xWaiter );
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpinLockTake( SpinLockHandle_t xLock, TickType_t xTicksToWait )
+{
+SpinLock_t * const pxLock = xLock;
+const uint32_t ulHolder = portGET_CORE_ID() + 1UL;
+BaseType_t xReturn;
+
+	configASSERT( pxLock );
+
+	xReturn = prvTryTake( pxLock, ulHolder );
+
+	if( xReturn != pdPASS )
+	{
+		xReturn = prvSpin( pxLock, ulHolder );
+
+		if( ( xReturn != pdPASS ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+		{
+			xReturn = prvWait( pxLock, ulHolder, xTicksToWait );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vSpinLockGive( SpinLockHandle_t xLock )
+{
+SpinLock_t * const pxLock = xLock;
+uint32_t ulLock;
+TaskHandle_t xWaitingTask = NULL;
+
+	configASSERT( pxLock );
+
+	/* Everything guarded by the lock must be in memory before it is free. */
+	portDATA_MEMORY_BARRIER();
+	ulLock = ulPortAtomicExchange( &( pxLock->ulLock ), spinlockFREE );
+	configASSERT( spinlockHOLDER( ulLock ) == ( portGET_CORE_ID() + 1UL ) );
+
+	/* Wake any task of the other core that is spinning on the lock. */
+	portSEND_EVENT();
+
+	if( ( ulLock & spinlockWAITERS ) != 0UL )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* The woken task takes the lock, or marks it again, when it runs,
+			so the tasks behind it are woken in turn. */
+			if( pxLock->pxWaiters != NULL )
+			{
+				xWaitingTask = pxLock->pxWaiters->xTask;
+				pxLock->pxWaiters = pxLock->pxWaiters->pxNext;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xWaitingTask != NULL )
+		{
+			( void ) xTaskNotifyGiveIndexed( xWaitingTask, configSPIN_LOCK_NOTIFY_INDEX );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include spin locks.  If you want to include them then ensure
+configUSE_SPIN_LOCKS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SPIN_LOCKS == 1 */
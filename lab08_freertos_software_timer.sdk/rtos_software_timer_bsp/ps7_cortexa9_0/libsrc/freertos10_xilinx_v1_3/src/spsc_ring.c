@@ -0,0 +1,438 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_ring.h"
+#include "heap_track.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include single producer, single consumer rings.  This #if is closed at the
+very bottom of this file. */
+#if( configUSE_SPSC_RINGS == 1 )
+
+#ifndef portDATA_MEMORY_BARRIER
+	#error portDATA_MEMORY_BARRIER() must be defined in portmacro.h to use single producer, single consumer rings
+#endif
+
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 in FreeRTOSConfig.h to use single producer, single consumer rings
+#endif
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use single producer, single consumer rings
+#endif
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use single producer, single consumer rings
+#endif
+
+/*
+ * The indexes count the items ever sent and received, and wrap at the range
+ * of UBaseType_t.  As the length is a power of two the slot of an index is the
+ * index masked with the length minus one, and the number of items in the ring
+ * is always uxHead - uxTail, even across the wrap.
+ */
+typedef struct SPSCRingDefinition
+{
+	/* Written by the producer only. */
+	volatile UBaseType_t uxHead;				/*< The index of the next item to be sent. */
+	TaskHandle_t volatile xWaitingProducer;		/*< The producer task while it waits for a free slot, otherwise NULL. */
+
+	/* Written by the consumer only. */
+	volatile UBaseType_t uxTail;				/*< The index of the next item to be received. */
+	TaskHandle_t volatile xWaitingConsumer;		/*< The consumer task while it waits for an item, otherwise NULL. */
+
+	UBaseType_t uxMask;							/*< The length of the ring minus one. */
+	UBaseType_t uxItemSize;
+	uint8_t *pucStorage;
+} SPSCRing_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copies an item into the ring and publishes it, if the ring is not full.
+ */
+static BaseType_t prvWriteItem( SPSCRing_t * const pxRing, const void *pvItem );
+
+/*
+ * Copies the oldest item out of the ring and frees its slot, if the ring is
+ * not empty.
+ */
+static BaseType_t prvReadItem( SPSCRing_t * const pxRing, void *pvItem );
+
+/*
+ * prvWriteItem() with the signature prvWait() expects.
+ */
+static BaseType_t prvTryWrite( SPSCRing_t * const pxRing, void *pvItem );
+
+/*
+ * Blocks the calling task until the other side publishes, with *pxWaiting the
+ * calling side's waiting task handle, and pxTry the operation that is retried.
+ */
+static BaseType_t prvWait( SPSCRing_t * const pxRing, TaskHandle_t volatile *pxWaiting, BaseType_t ( *pxTry )( SPSCRing_t * const, void * ), void *pvItem, TickType_t xTicksToWait );
+
+/*-----------------------------------------------------------*/
+
+SPSCRingHandle_t xSPSCRingCreate( UBaseType_t uxLength, UBaseType_t uxItemSize )
+{
+SPSCRing_t *pxRing;
+size_t xHeaderSizeInBytes;
+
+	/* The length must be a power of two. */
+	configASSERT( uxLength > ( UBaseType_t ) 0 );
+	configASSERT( ( uxLength & ( uxLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 );
+	configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+	/* The storage area follows the ring structure, aligned so items that need
+	alignment can be copied in and out efficiently. */
+	xHeaderSizeInBytes = ( sizeof( SPSCRing_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxRing = ( SPSCRing_t * ) pvPortMalloc( xHeaderSizeInBytes + ( size_t ) ( uxLength * uxItemSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+	if( pxRing != NULL )
+	{
+		heaptrackSET_CALL_SITE( pxRing, heaptrackCALL_SITE() );
+
+		pxRing->uxHead = ( UBaseType_t ) 0;
+		pxRing->xWaitingProducer = NULL;
+		pxRing->uxTail = ( UBaseType_t ) 0;
+		pxRing->xWaitingConsumer = NULL;
+		pxRing->uxMask = uxLength - ( UBaseType_t ) 1;
+		pxRing->uxItemSize = uxItemSize;
+		pxRing->pucStorage = ( ( uint8_t * ) pxRing ) + xHeaderSizeInBytes; /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxRing;
+}
+/*-----------------------------------------------------------*/
+
+void vSPSCRingDelete( SPSCRingHandle_t xRing )
+{
+SPSCRing_t * const pxRing = xRing;
+
+	configASSERT( pxRing );
+	configASSERT( ( pxRing->xWaitingProducer == NULL ) && ( pxRing->xWaitingConsumer == NULL ) );
+
+	vPortFree( pxRing );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( SPSCRing_t * const pxRing, const void *pvItem )
+{
+const UBaseType_t uxHead = pxRing->uxHead;
+BaseType_t xReturn;
+
+	if( ( uxHead - pxRing->uxTail ) <= pxRing->uxMask )
+	{
+		/* The write to the slot depends on the read of uxTail through the
+		branch, so cannot overwrite an item the consumer is still reading.
+		The item must be in memory before the new head is. */
+		( void ) memcpy( ( void * ) &( pxRing->pucStorage[ ( uxHead & pxRing->uxMask ) * pxRing->uxItemSize ] ), pvItem, ( size_t ) pxRing->uxItemSize );
+		portDATA_MEMORY_BARRIER();
+		pxRing->uxHead = uxHead + ( UBaseType_t ) 1;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = errQUEUE_FULL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( SPSCRing_t * const pxRing, void *pvItem )
+{
+const UBaseType_t uxTail = pxRing->uxTail;
+BaseType_t xReturn;
+
+	if( pxRing->uxHead != uxTail )
+	{
+		/* The item must not be read before the head that published it, and
+		must be read completely before the slot is freed. */
+		portDATA_MEMORY_BARRIER();
+		( void ) memcpy( pvItem, ( const void * ) &( pxRing->pucStorage[ ( uxTail & pxRing->uxMask ) * pxRing->uxItemSize ] ), ( size_t ) pxRing->uxItemSize );
+		portDATA_MEMORY_BARRIER();
+		pxRing->uxTail = uxTail + ( UBaseType_t ) 1;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = errQUEUE_EMPTY;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWait( SPSCRing_t * const pxRing, TaskHandle_t volatile *pxWaiting, BaseType_t ( *pxTry )( SPSCRing_t * const, void * ), void *pvItem, TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xReturn;
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+	}
+	#endif
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		/* The wait is announced before the ring is checked again, and the
+		other side publishes before it checks for a waiting task, so either
+		this check succeeds or the other side gives the notification. */
+		*pxWaiting = xTaskGetCurrentTaskHandle();
+		portDATA_MEMORY_BARRIER();
+
+		xReturn = pxTry( pxRing, pvItem );
+
+		if( xReturn == pdPASS )
+		{
+			/* A notification the other side gives now is left pending, and at
+			worst returns the next wait on the ring straight away. */
+			*pxWaiting = NULL;
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) ulTaskNotifyTakeIndexed( configSPSC_RING_NOTIFY_INDEX, pdTRUE, xTicksToWait );
+		*pxWaiting = NULL;
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			/* Timed out, but the ring may have changed since the wait ended. */
+			xReturn = pxTry( pxRing, pvItem );
+			break;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTryWrite( SPSCRing_t * const pxRing, void *pvItem )
+{
+	return prvWriteItem( pxRing, pvItem );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingSend( SPSCRingHandle_t xRing, const void *pvItem, TickType_t xTicksToWait )
+{
+SPSCRing_t * const pxRing = xRing;
+BaseType_t xReturn;
+TaskHandle_t xConsumer;
+
+	configASSERT( pxRing );
+	configASSERT( pvItem );
+
+	xReturn = prvWriteItem( pxRing, pvItem );
+
+	if( ( xReturn != pdPASS ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		xReturn = prvWait( pxRing, &( pxRing->xWaitingProducer ), prvTryWrite, ( void * ) pvItem, xTicksToWait );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xReturn == pdPASS )
+	{
+		/* The new head must be visible before the waiting consumer is read. */
+		portDATA_MEMORY_BARRIER();
+		xConsumer = pxRing->xWaitingConsumer;
+
+		if( xConsumer != NULL )
+		{
+			( void ) xTaskNotifyGiveIndexed( xConsumer, configSPSC_RING_NOTIFY_INDEX );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingSendFromISR( SPSCRingHandle_t xRing, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+SPSCRing_t * const pxRing = xRing;
+BaseType_t xReturn;
+TaskHandle_t xConsumer;
+
+	configASSERT( pxRing );
+	configASSERT( pvItem );
+
+	xReturn = prvWriteItem( pxRing, pvItem );
+
+	if( xReturn == pdPASS )
+	{
+		portDATA_MEMORY_BARRIER();
+		xConsumer = pxRing->xWaitingConsumer;
+
+		if( xConsumer != NULL )
+		{
+			vTaskNotifyGiveIndexedFromISR( xConsumer, configSPSC_RING_NOTIFY_INDEX, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingReceive( SPSCRingHandle_t xRing, void *pvItem, TickType_t xTicksToWait )
+{
+SPSCRing_t * const pxRing = xRing;
+BaseType_t xReturn;
+TaskHandle_t xProducer;
+
+	configASSERT( pxRing );
+	configASSERT( pvItem );
+
+	xReturn = prvReadItem( pxRing, pvItem );
+
+	if( ( xReturn != pdPASS ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		xReturn = prvWait( pxRing, &( pxRing->xWaitingConsumer ), prvReadItem, pvItem, xTicksToWait );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xReturn == pdPASS )
+	{
+		/* The new tail must be visible before the waiting producer is read. */
+		portDATA_MEMORY_BARRIER();
+		xProducer = pxRing->xWaitingProducer;
+
+		if( xProducer != NULL )
+		{
+			( void ) xTaskNotifyGiveIndexed( xProducer, configSPSC_RING_NOTIFY_INDEX );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCRingReceiveFromISR( SPSCRingHandle_t xRing, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+SPSCRing_t * const pxRing = xRing;
+BaseType_t xReturn;
+TaskHandle_t xProducer;
+
+	configASSERT( pxRing );
+	configASSERT( pvItem );
+
+	xReturn = prvReadItem( pxRing, pvItem );
+
+	if( xReturn == pdPASS )
+	{
+		portDATA_MEMORY_BARRIER();
+		xProducer = pxRing->xWaitingProducer;
+
+		if( xProducer != NULL )
+		{
+			vTaskNotifyGiveIndexedFromISR( xProducer, configSPSC_RING_NOTIFY_INDEX, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSPSCRingItemsWaiting( SPSCRingHandle_t xRing )
+{
+SPSCRing_t * const pxRing = xRing;
+
+	configASSERT( pxRing );
+
+	return pxRing->uxHead - pxRing->uxTail;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include single producer, single consumer rings.  If you want to include them
+then ensure configUSE_SPSC_RINGS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SPSC_RINGS == 1 */
@@ -0,0 +1,364 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "stack_profile.h"
+
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+	#include <stdio.h>
+#endif
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include the stack profiler.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_STACK_PROFILER == 1 )
+
+#if( configUSE_TIMERS != 1 )
+	#error The stack profiler samples from a software timer.  Set configUSE_TIMERS to 1 in FreeRTOSConfig.h.
+#endif
+
+#if( configUSE_TRACE_FACILITY != 1 )
+	#error The stack profiler uses uxTaskGetSystemState().  Set configUSE_TRACE_FACILITY to 1 in FreeRTOSConfig.h.
+#endif
+
+#if( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS != 1 ) )
+	#error The stack profiler needs the size of each task stack.  Set configRECORD_STACK_HIGH_ADDRESS to 1 in FreeRTOSConfig.h.
+#endif
+
+/* The value tasks.c fills new task stacks with, also used for the mode
+stacks. */
+#define spSTACK_FILL_BYTE		( 0xa5U )
+
+/* The number of processor mode stacks that can be profiled. */
+#define spMAX_MODE_STACKS		8
+
+/* The bytes left unfilled below the stack frame of xStackProfileStart(), when
+it is running on one of the mode stacks, for the frames of the functions it
+calls. */
+#define spFILL_CLEARANCE		256U
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The callback of the sample timer.
+ */
+static void prvSampleTimerCallback( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records ulPeakBytes of use of the stack called pcName, claiming a free entry
+ * if the stack has not been seen before.  The use is not recorded if the table
+ * is full.
+ */
+static void prvRecordStack( const char *pcName, BaseType_t xIsTask, uint32_t ulSizeBytes, uint32_t ulPeakBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of bytes from pucLow up that still hold
+ * spSTACK_FILL_BYTE, stopping at pucHigh.
+ */
+static uint32_t prvCountUnusedBytes( const uint8_t *pucLow, const uint8_t *pucHigh ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the recommended size of a stack with a peak use of ulPeakBytes.
+ */
+static uint32_t prvRecommendedBytes( uint32_t ulPeakBytes ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+PRIVILEGED_DATA static StackProfileEntry_t xEntries[ configSTACK_PROFILE_MAX_ENTRIES ];
+PRIVILEGED_DATA static UBaseType_t uxEntries = 0U;
+PRIVILEGED_DATA static StackProfileRegion_t xModeStacks[ spMAX_MODE_STACKS ];
+PRIVILEGED_DATA static UBaseType_t uxModeStacks = 0U;
+PRIVILEGED_DATA static TaskStatus_t xTaskStatus[ configSTACK_PROFILE_MAX_ENTRIES ];
+PRIVILEGED_DATA static TimerHandle_t xSampleTimer = NULL;
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	PRIVILEGED_DATA static StaticTimer_t xSampleTimerBuffer;
+#endif
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xStackProfileStart( TickType_t xSamplePeriod )
+{
+uint8_t ucMarker;
+uint8_t *pucFillEnd, *puc;
+UBaseType_t x;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( xSampleTimer == NULL );
+	configASSERT( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED );
+
+	uxModeStacks = portGET_MODE_STACKS( xModeStacks, ( UBaseType_t ) spMAX_MODE_STACKS );
+	configASSERT( uxModeStacks <= ( UBaseType_t ) spMAX_MODE_STACKS );
+
+	for( x = 0; x < uxModeStacks; x++ )
+	{
+		pucFillEnd = xModeStacks[ x ].pucHigh;
+
+		/* The stack this function is running on is only filled up to a little
+		below the marker, which is in the current stack frame. */
+		if( ( &ucMarker >= xModeStacks[ x ].pucLow ) && ( &ucMarker < xModeStacks[ x ].pucHigh ) )
+		{
+			pucFillEnd = &ucMarker - spFILL_CLEARANCE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( puc = xModeStacks[ x ].pucLow; puc < pucFillEnd; puc++ )
+		{
+			*puc = ( uint8_t ) spSTACK_FILL_BYTE;
+		}
+	}
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		xSampleTimer = xTimerCreateStatic( "StackProf", xSamplePeriod, pdTRUE, NULL, prvSampleTimerCallback, &xSampleTimerBuffer );
+	}
+	#else
+	{
+		xSampleTimer = xTimerCreate( "StackProf", xSamplePeriod, pdTRUE, NULL, prvSampleTimerCallback );
+	}
+	#endif
+
+	if( xSampleTimer != NULL )
+	{
+		xReturn = xTimerStart( xSampleTimer, 0 );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSampleTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+	vStackProfileSample();
+}
+/*-----------------------------------------------------------*/
+
+void vStackProfileSample( void )
+{
+UBaseType_t uxTasks, x;
+uint32_t ulSizeBytes, ulUnusedBytes;
+
+	/* The scheduler is kept suspended so tasks are not deleted while their
+	stacks are measured, and so the table is updated by one caller at a time.
+	Measuring a stack reads its unused part, so the time taken grows with the
+	amount of stack that is over-provisioned. */
+	vTaskSuspendAll();
+	{
+		for( x = 0; x < uxModeStacks; x++ )
+		{
+			ulSizeBytes = ( uint32_t ) ( xModeStacks[ x ].pucHigh - xModeStacks[ x ].pucLow );
+			ulUnusedBytes = prvCountUnusedBytes( xModeStacks[ x ].pucLow, xModeStacks[ x ].pucHigh );
+			prvRecordStack( xModeStacks[ x ].pcName, pdFALSE, ulSizeBytes, ulSizeBytes - ulUnusedBytes );
+		}
+
+		/* Nothing is returned if there are more tasks than entries in
+		xTaskStatus[]. */
+		uxTasks = uxTaskGetSystemState( xTaskStatus, ( UBaseType_t ) configSTACK_PROFILE_MAX_ENTRIES, NULL );
+
+		for( x = 0; x < uxTasks; x++ )
+		{
+			/* pxEndOfStack is the top of stack aligned down, so the size is
+			rounded back up. */
+			ulSizeBytes = ( ( uint32_t ) ( xTaskStatus[ x ].pxEndOfStack - xTaskStatus[ x ].pxStackBase ) + 1UL ) * ( uint32_t ) sizeof( StackType_t );
+			ulSizeBytes = ( ulSizeBytes + ( uint32_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( uint32_t ) portBYTE_ALIGNMENT_MASK );
+			ulUnusedBytes = ( uint32_t ) xTaskStatus[ x ].usStackHighWaterMark * ( uint32_t ) sizeof( StackType_t );
+
+			if( ulUnusedBytes > ulSizeBytes )
+			{
+				ulUnusedBytes = ulSizeBytes;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvRecordStack( xTaskStatus[ x ].pcTaskName, pdTRUE, ulSizeBytes, ulSizeBytes - ulUnusedBytes );
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordStack( const char *pcName, BaseType_t xIsTask, uint32_t ulSizeBytes, uint32_t ulPeakBytes )
+{
+StackProfileEntry_t *pxEntry = NULL;
+UBaseType_t x;
+
+	/* Stacks are identified by name, so a task that is deleted and created
+	again keeps its peak, unless it is created with a stack of another size. */
+	for( x = 0; x < uxEntries; x++ )
+	{
+		if( ( xEntries[ x ].xIsTask == xIsTask ) && ( strncmp( xEntries[ x ].pcName, pcName, ( size_t ) configMAX_TASK_NAME_LEN ) == 0 ) )
+		{
+			pxEntry = &( xEntries[ x ] );
+			break;
+		}
+	}
+
+	if( ( pxEntry == NULL ) && ( uxEntries < ( UBaseType_t ) configSTACK_PROFILE_MAX_ENTRIES ) )
+	{
+		pxEntry = &( xEntries[ uxEntries ] );
+		uxEntries++;
+
+		strncpy( pxEntry->pcName, pcName, ( size_t ) configMAX_TASK_NAME_LEN );
+		pxEntry->pcName[ configMAX_TASK_NAME_LEN - 1 ] = ( char ) 0x00;
+		pxEntry->xIsTask = xIsTask;
+		pxEntry->ulSizeBytes = ulSizeBytes;
+		pxEntry->ulPeakBytes = 0UL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxEntry != NULL )
+	{
+		/* A peak measured on a stack of another size says nothing about this
+		one, and one above the size would wrap the unused part below. */
+		if( ulSizeBytes != pxEntry->ulSizeBytes )
+		{
+			pxEntry->ulSizeBytes = ulSizeBytes;
+			pxEntry->ulPeakBytes = 0UL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulPeakBytes > pxEntry->ulPeakBytes )
+		{
+			pxEntry->ulPeakBytes = ulPeakBytes;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxEntry->ulRecommendedBytes = prvRecommendedBytes( pxEntry->ulPeakBytes );
+		pxEntry->xNearOverflow = ( ( ulSizeBytes - pxEntry->ulPeakBytes ) < ( pxEntry->ulRecommendedBytes - pxEntry->ulPeakBytes ) ) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCountUnusedBytes( const uint8_t *pucLow, const uint8_t *pucHigh )
+{
+const uint8_t *puc = pucLow;
+
+	while( ( puc < pucHigh ) && ( *puc == ( uint8_t ) spSTACK_FILL_BYTE ) )
+	{
+		puc++;
+	}
+
+	return ( uint32_t ) ( puc - pucLow );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRecommendedBytes( uint32_t ulPeakBytes )
+{
+uint32_t ulBytes;
+
+	ulBytes = ulPeakBytes + ( ( ulPeakBytes * ( uint32_t ) configSTACK_PROFILE_MARGIN_PERCENT ) / 100UL );
+
+	return ( ulBytes + ( uint32_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( uint32_t ) portBYTE_ALIGNMENT_MASK );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxStackProfileGetReport( StackProfileEntry_t *pxEntryArray, const UBaseType_t uxArraySize )
+{
+UBaseType_t x, uxWritten = 0;
+
+	configASSERT( pxEntryArray );
+
+	vTaskSuspendAll();
+	{
+		/* Entries are claimed in the order of the first sample, which
+		measures the mode stacks first. */
+		for( x = 0; ( x < uxEntries ) && ( uxWritten < uxArraySize ); x++ )
+		{
+			pxEntryArray[ uxWritten ] = xEntries[ x ];
+			uxWritten++;
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxWritten;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+	void vStackProfileList( char *pcWriteBuffer )
+	{
+	static StackProfileEntry_t xEntryCopy[ configSTACK_PROFILE_MAX_ENTRIES ];
+	UBaseType_t uxCount, x;
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* The static copy avoids placing the table on the calling task's
+		stack, so this function is not reentrant. */
+		uxCount = uxStackProfileGetReport( xEntryCopy, ( UBaseType_t ) configSTACK_PROFILE_MAX_ENTRIES );
+
+		for( x = 0; x < uxCount; x++ )
+		{
+			sprintf( pcWriteBuffer, "%s\t%s\t%u\t%u\t%u%s\r\n", xEntryCopy[ x ].pcName, ( xEntryCopy[ x ].xIsTask != pdFALSE ) ? "task" : "mode", ( unsigned int ) xEntryCopy[ x ].ulSizeBytes, ( unsigned int ) xEntryCopy[ x ].ulPeakBytes, ( unsigned int ) xEntryCopy[ x ].ulRecommendedBytes, ( xEntryCopy[ x ].xNearOverflow != pdFALSE ) ? "\t!" : "" ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+			pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+		}
+	}
+
+#endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
+
+/* This entire source file will be skipped if the application is not configured
+to include the stack profiler.  If you want to include the stack profiler then
+ensure configUSE_STACK_PROFILER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_STACK_PROFILER == 1 */
@@ -0,0 +1,150 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef STACK_PROFILE_H
+#define STACK_PROFILE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include stack_profile.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Stack profiling.
+ *
+ * When configUSE_STACK_PROFILER is set to 1 in FreeRTOSConfig.h,
+ * xStackProfileStart() creates an auto-reload software timer that
+ * periodically measures how much of each stack has ever been used, by counting
+ * the bytes at the far end of the stack that still hold the value the stack was
+ * filled with.  The stacks of all the tasks are measured, as are the processor
+ * mode stacks the port reports through portGET_MODE_STACKS(), which on the
+ * Zynq are the IRQ, supervisor, abort, FIQ, undefined and system stacks
+ * defined in lscript.ld.  Note the port's IRQ handler runs the interrupt
+ * handlers on the supervisor stack, so that is the stack interrupt nesting
+ * grows.
+ *
+ * The peak use of each stack is kept across samples, and of a task across the
+ * task being deleted and created again with the same name and stack size.  A
+ * task created again with another stack size starts a new peak.  A recommended
+ * size is derived from the peak by adding configSTACK_PROFILE_MARGIN_PERCENT
+ * percent, so over-provisioned stacks can be reduced, and stacks whose unused
+ * part has become smaller than that margin are flagged.
+ *
+ * A stack only ever records its deepest use, so a code path that has not run
+ * since the stack was filled is not accounted for.  The report is only as good
+ * as the coverage of the run that produced it.
+ */
+
+/* A processor mode stack, as reported by the port. */
+typedef struct xSTACK_PROFILE_REGION
+{
+	const char *pcName;		/* The name used in the report. */
+	uint8_t *pucLow;		/* The lowest address of the stack. */
+	uint8_t *pucHigh;		/* One past the highest address of the stack, where the stack pointer starts. */
+} StackProfileRegion_t;
+
+/* Used with uxStackProfileGetReport() to obtain the profile of each stack.
+All the sizes are in bytes, to within portBYTE_ALIGNMENT for task stacks. */
+typedef struct xSTACK_PROFILE_ENTRY
+{
+	char pcName[ configMAX_TASK_NAME_LEN ];	/* The name of the task, or of the processor mode stack. */
+	BaseType_t xIsTask;						/* pdTRUE for a task stack, pdFALSE for a processor mode stack. */
+	uint32_t ulSizeBytes;					/* The size of the stack. */
+	uint32_t ulPeakBytes;					/* The most of the stack that has ever been used. */
+	uint32_t ulRecommendedBytes;			/* ulPeakBytes plus the margin, rounded up to portBYTE_ALIGNMENT. */
+	BaseType_t xNearOverflow;				/* pdTRUE if the unused part of the stack is smaller than the margin. */
+} StackProfileEntry_t;
+
+/**
+ * stack_profile.h
+ * <pre>BaseType_t xStackProfileStart( TickType_t xSamplePeriod );</pre>
+ *
+ * Fills the unused parts of the processor mode stacks, then creates and starts
+ * the timer that samples all the stacks every xSamplePeriod ticks.
+ *
+ * xStackProfileStart() must be called before vTaskStartScheduler(), while
+ * interrupts are still disabled, as it writes to the mode stacks the interrupt
+ * handlers use.  The part of the stack the caller is running on that lies
+ * above its stack frame is left as it is.
+ *
+ * @return pdPASS if the timer was created, otherwise pdFAIL.
+ */
+BaseType_t xStackProfileStart( TickType_t xSamplePeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * stack_profile.h
+ * <pre>void vStackProfileSample( void );</pre>
+ *
+ * Measures all the stacks at once, in addition to the periodic samples, for
+ * example just before the report is read.
+ */
+void vStackProfileSample( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * stack_profile.h
+ * <pre>UBaseType_t uxStackProfileGetReport( StackProfileEntry_t *pxEntryArray, const UBaseType_t uxArraySize );</pre>
+ *
+ * Copies the profile of each stack measured so far into pxEntryArray, the
+ * processor mode stacks first.
+ *
+ * @param pxEntryArray An array into which the profiles are written.
+ *
+ * @param uxArraySize The number of entries in pxEntryArray.  At most
+ * configSTACK_PROFILE_MAX_ENTRIES entries are ever written.
+ *
+ * @return The number of entries written to pxEntryArray.
+ */
+UBaseType_t uxStackProfileGetReport( StackProfileEntry_t *pxEntryArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+
+	/**
+	 * stack_profile.h
+	 * <pre>void vStackProfileList( char *pcWriteBuffer );</pre>
+	 *
+	 * Writes a human readable table of the stacks into pcWriteBuffer, giving
+	 * the size, the peak use and the recommended size of each in bytes, and
+	 * marking with a '!' the stacks that are close to overflowing.  Each stack
+	 * needs approximately 40 bytes.
+	 *
+	 * As with vTaskList(), this function is provided for convenience only, has
+	 * a dependency on sprintf(), and production systems should call
+	 * uxStackProfileGetReport() directly.
+	 */
+	void vStackProfileList( char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_PROFILE_H */
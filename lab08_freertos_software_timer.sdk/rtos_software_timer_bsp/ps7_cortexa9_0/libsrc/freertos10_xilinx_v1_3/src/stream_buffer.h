@@ -64,6 +64,18 @@ extern "C" {
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/**
+ * The data waiting in a stream buffer, as returned by
+ * xStreamBufferReceiveSpans().  Data that wraps past the end of the buffer's
+ * storage area continues in the second span, otherwise the second span has a
+ * length of zero.
+ */
+typedef struct xSTREAM_BUFFER_SPANS
+{
+	uint8_t *pucSpan[ 2 ];
+	size_t xSpanLengthBytes[ 2 ];
+} StreamBufferSpans_t;
+
 
 /**
  * message_buffer.h
@@ -829,6 +841,206 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveSpans( StreamBufferHandle_t xStreamBuffer,
+                                  StreamBufferSpans_t * const pxSpans,
+                                  TickType_t xTicksToWait );
+</pre>
+ *
+ * Returns the data waiting in a stream buffer in place, without copying it
+ * out.  The data is described by up to two spans: the bytes from the oldest
+ * byte to the end of the buffer's storage area, and, if the data wraps, the
+ * bytes from the start of the storage area onwards.
+ *
+ * The data stays in the stream buffer, and the spans stay valid, until the
+ * reader calls vStreamBufferReleaseSpans() (or
+ * vStreamBufferReleaseSpansFromISR()) to remove however many bytes it has
+ * consumed.  Bytes sent while the reader holds the spans are not included in
+ * them, but are returned by the next call.
+ *
+ * As xStreamBufferReceive(), only one task or interrupt may read from a stream
+ * buffer.  Message buffers cannot be read this way.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read.
+ *
+ * @param pxSpans The structure the spans are written to.
+ *
+ * @param xTicksToWait The maximum time the task should remain in the Blocked
+ * state to wait for data if the stream buffer is empty, as xStreamBufferReceive().
+ *
+ * @return The total number of bytes in the two spans, which is zero if the
+ * stream buffer was still empty when the block time expired.
+ *
+ * \defgroup xStreamBufferReceiveSpans xStreamBufferReceiveSpans
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveSpans( StreamBufferHandle_t xStreamBuffer,
+								  StreamBufferSpans_t * const pxSpans,
+								  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         StreamBufferSpans_t * const pxSpans );
+</pre>
+ *
+ * A version of xStreamBufferReceiveSpans() that can be called from an
+ * interrupt service routine, for example to start a DMA transfer out of the
+ * stream buffer.  It never blocks.
+ *
+ * \defgroup xStreamBufferReceiveSpansFromISR xStreamBufferReceiveSpansFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+										 StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferReleaseSpans( StreamBufferHandle_t xStreamBuffer, size_t xBytesConsumed );
+void vStreamBufferReleaseSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xBytesConsumed,
+                                       BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Removes the oldest xBytesConsumed bytes from a stream buffer after they have
+ * been read in place through xStreamBufferReceiveSpans(), and unblocks a task
+ * that is waiting for space to send.  xBytesConsumed may be less than the
+ * bytes in the spans, in which case the rest stay in the buffer.
+ *
+ * Example use:
+<pre>
+void vParserTask( void *pvParameters )
+{
+StreamBufferSpans_t xSpans;
+size_t xConsumed;
+
+    for( ;; )
+    {
+        xStreamBufferReceiveSpans( xRxStream, &xSpans, portMAX_DELAY );
+
+        // Parse as many whole records as the two spans contain.
+        xConsumed = xParseRecords( xSpans.pucSpan[ 0 ], xSpans.xSpanLengthBytes[ 0 ],
+                                   xSpans.pucSpan[ 1 ], xSpans.xSpanLengthBytes[ 1 ] );
+
+        vStreamBufferReleaseSpans( xRxStream, xConsumed );
+    }
+}
+</pre>
+ *
+ * \defgroup vStreamBufferReleaseSpans vStreamBufferReleaseSpans
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReleaseSpans( StreamBufferHandle_t xStreamBuffer, size_t xBytesConsumed ) PRIVILEGED_FUNCTION;
+void vStreamBufferReleaseSpansFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xBytesConsumed,
+									   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateDMA( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+</pre>
+ *
+ * Creates a stream buffer, as xStreamBufferCreate(), whose storage area starts
+ * on a cache line boundary and is a whole number of cache lines
+ * (portCACHE_LINE_SIZE bytes) long.  A DMA engine can then write into the
+ * storage area through xStreamBufferGetWriteSpan(), and the driver can
+ * invalidate the data cache over the transfer (for example with
+ * Xil_DCacheInvalidateRange()) without discarding anything outside the stream
+ * buffer.  The capacity may be rounded up.
+ *
+ * The data cache must be invalidated after the transfer completes and before
+ * the transfer is committed.  Do not also write to the stream buffer with
+ * xStreamBufferSend(), as the cache lines that write dirties could then be
+ * invalidated.
+ *
+ * \defgroup xStreamBufferCreateDMA xStreamBufferCreateDMA
+ * \ingroup StreamBufferManagement
+ */
+StreamBufferHandle_t xStreamBufferCreateDMA( size_t xBufferSizeBytes, size_t xTriggerLevelBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferGetWriteSpan( StreamBufferHandle_t xStreamBuffer, uint8_t ** const ppucSpan );
+</pre>
+ *
+ * Returns the free space at the head of a stream buffer that can be written
+ * in place, for example by a DMA engine.  The space is contiguous, so it
+ * stops at the end of the storage area even if there is more free space at
+ * the start.  The bytes written become part of the stream when they are
+ * committed with xStreamBufferCommitWrite() or
+ * xStreamBufferCommitWriteFromISR().  It never blocks, and can be called from
+ * an interrupt service routine.
+ *
+ * As xStreamBufferSend(), only one task or interrupt may write to a stream
+ * buffer.  Message buffers cannot be written this way.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write.
+ *
+ * @param ppucSpan Set to the start of the free space.
+ *
+ * @return The number of bytes that can be written at *ppucSpan.
+ *
+ * \defgroup xStreamBufferGetWriteSpan xStreamBufferGetWriteSpan
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetWriteSpan( StreamBufferHandle_t xStreamBuffer, uint8_t ** const ppucSpan ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten );
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xBytesWritten,
+                                        BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Adds the first xBytesWritten bytes of the span returned by
+ * xStreamBufferGetWriteSpan() to the stream, and unblocks a task waiting to
+ * receive once the trigger level is reached.  xBytesWritten must not exceed
+ * the length of that span.
+ *
+ * Example use, from the interrupt that signals the end of a receive DMA
+ * transfer:
+<pre>
+void vDMADoneHandler( void *pvCallBackRef )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+uint8_t *pucSpan;
+size_t xLength;
+
+    Xil_DCacheInvalidateRange( ( INTPTR ) pucDMATarget, xDMALength );
+    xStreamBufferCommitWriteFromISR( xRxStream, xDMALength, &xHigherPriorityTaskWoken );
+
+    // Start the next transfer into the next free span.
+    xLength = xStreamBufferGetWriteSpan( xRxStream, &pucSpan );
+    vStartDMA( pucSpan, xLength );
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+</pre>
+ *
+ * @return xBytesWritten.
+ *
+ * \defgroup xStreamBufferCommitWrite xStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										size_t xBytesWritten,
+										BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
@@ -39,6 +39,9 @@ task.h is included from an application file. */
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+#include "critical_profile.h"
+#include "heap_track.h"
+#include "object_pool.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -64,6 +67,15 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+/* With a single notification per task the index passed to the notification
+functions is always 0, so accesses to the arrays below compile to the same
+code as before the arrays were added. */
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES == 1 )
+	#define taskNOTIFY_INDEX( uxIndex )	( ( UBaseType_t ) 0U )
+#else
+	#define taskNOTIFY_INDEX( uxIndex )	( uxIndex )
+#endif
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
@@ -274,10 +286,45 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 		xMPU_SETTINGS	xMPUSettings;		/*< The MPU settings are defined as part of the port layer.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
 	#endif
 
+	/* The members up to iTaskErrno are used by every context switch, or
+	whenever the task blocks or is unblocked, so they are kept together at the
+	start of the TCB.  With a 32 byte cache line and no MPU, pxTopOfStack to
+	pxStack fill the first line and xEventListItem to uxRcuPreempted the
+	second.  The members after them are only used by less frequent calls. */
 	ListItem_t			xStateListItem;	/*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
-	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
 	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
 	StackType_t			*pxStack;			/*< Points to the start of the stack. */
+	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
+
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
+	#if( INCLUDE_xTaskAbortDelay == 1 )
+		uint8_t ucDelayAborted;
+	#endif
+
+	#if( configUSE_RCU == 1 )
+		UBaseType_t		uxRcuNesting;		/*< The depth of the RCU read sections the task is inside. */
+		UBaseType_t		uxRcuPreempted;		/*< Zero, or one more than the grace period parity the task was counted against when it was switched out inside a read section. */
+	#endif
+
+	#if( configUSE_POSIX_ERRNO == 1 )
+		int iTaskErrno;
+	#endif
+
+	#if ( configUSE_MUTEXES == 1 )
+		UBaseType_t		uxBasePriority;		/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+		UBaseType_t		uxMutexesHeld;
+		#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+			void		*pvMutexBlockedOn;	/*< The mutex the task is blocked waiting to take, if any.  Lets priority inheritance follow a chain of blocked mutex holders. */
+		#endif
+	#endif
+
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	#endif
+
 	char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
 	#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
@@ -293,11 +340,6 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 		UBaseType_t		uxTaskNumber;		/*< Stores a number specifically for use by third party trace code. */
 	#endif
 
-	#if ( configUSE_MUTEXES == 1 )
-		UBaseType_t		uxBasePriority;		/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
-		UBaseType_t		uxMutexesHeld;
-	#endif
-
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		TaskHookFunction_t pxTaskTag;
 	#endif
@@ -321,26 +363,13 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 		struct	_reent xNewLib_reent;
 	#endif
 
-	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
-	#endif
-
 	/* See the comments above the definition of
 	tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE. */
 	#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
 		uint8_t	ucStaticallyAllocated; 		/*< Set to pdTRUE if the task is a statically allocated to ensure no attempt is made to free the memory. */
 	#endif
 
-	#if( INCLUDE_xTaskAbortDelay == 1 )
-		uint8_t ucDelayAborted;
-	#endif
-
-	#if( configUSE_POSIX_ERRNO == 1 )
-		int iTaskErrno;
-	#endif
-
-} tskTCB;
+} portCONTROL_BLOCK_ALIGNED tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
 below to enable the use of older kernel aware debuggers. */
@@ -348,18 +377,18 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB portFAST_DATA = NULL;
 
 /* Lists for ready and blocked tasks. --------------------
 xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
+PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ] portFAST_BSS;/*< Prioritised ready tasks. */
+PRIVILEGED_DATA static List_t xDelayedTaskList1 portFAST_BSS;				/*< Delayed tasks. */
+PRIVILEGED_DATA static List_t xDelayedTaskList2 portFAST_BSS;				/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList portFAST_BSS;		/*< Points to the delayed task list currently being used. */
+PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList portFAST_BSS;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+PRIVILEGED_DATA static List_t xPendingReadyList portFAST_BSS;				/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
 
@@ -382,14 +411,14 @@ the errno of the currently running task. */
 
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+PRIVILEGED_DATA static volatile TickType_t xTickCount portFAST_DATA	= ( TickType_t ) configINITIAL_TICK_COUNT;
+PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority portFAST_DATA	= tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime portFAST_DATA	= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
@@ -400,7 +429,17 @@ moves the task's event list item into the xPendingReadyList, ready for the
 kernel to move the task from the pending ready list into the real ready list
 when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
-PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
+PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended portFAST_DATA	= ( UBaseType_t ) pdFALSE;
+
+#if ( configUSE_RCU == 1 )
+
+	/* The number of tasks that were switched out while inside an RCU read
+	section, counted against the parity of the grace period that was current
+	when they were switched out, and the grace period counter itself. */
+	PRIVILEGED_DATA static volatile UBaseType_t uxRcuPreemptedReaders[ 2 ] = { 0U, 0U };
+	PRIVILEGED_DATA static volatile UBaseType_t uxRcuGracePeriod = 0U;
+
+#endif
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
@@ -577,6 +616,27 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of a mutex holder to uxNewPriority, moving the holder to
+ * the matching ready list if it is ready and, when transitive priority
+ * inheritance is used, to its new position in any event list it is blocked on.
+ */
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInheritPriority( TCB_t * const pxMutexHolderTCB, const UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Moves a task whose priority has just changed to its new position in the
+ * priority ordered event list it is blocked on, if any.
+ */
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvRepositionOnEventList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -707,10 +767,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) configKERNEL_OBJECT_MALLOC( sizeof( TCB_t ) );
 
 			if( pxNewTCB != NULL )
 			{
+				heaptrackSET_CALL_SITE( pxNewTCB, heaptrackCALL_SITE() );
+
 				/* Store the stack location in the TCB. */
 				pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
 
@@ -762,19 +824,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) configKERNEL_OBJECT_MALLOC( sizeof( TCB_t ) );
 
 			if( pxNewTCB != NULL )
 			{
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) configKERNEL_OBJECT_MALLOC( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					configKERNEL_OBJECT_FREE( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -784,12 +846,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+			pxStack = configKERNEL_OBJECT_MALLOC( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+				pxNewTCB = ( TCB_t * ) configKERNEL_OBJECT_MALLOC( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -800,7 +862,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				{
 					/* The stack cannot be used as the TCB was not created.  Free
 					it again. */
-					vPortFree( pxStack );
+					configKERNEL_OBJECT_FREE( pxStack );
 				}
 			}
 			else
@@ -820,6 +882,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			}
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
+			/* Charge the TCB and the stack to the caller of xTaskCreate()
+			rather than to this function. */
+			heaptrackSET_CALL_SITE( pxNewTCB, heaptrackCALL_SITE() );
+			heaptrackSET_CALL_SITE( pxNewTCB->pxStack, heaptrackCALL_SITE() );
+
 			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
 			prvAddNewTaskToReadyList( pxNewTCB );
 			xReturn = pdPASS;
@@ -942,9 +1009,21 @@ UBaseType_t x;
 	{
 		pxNewTCB->uxBasePriority = uxPriority;
 		pxNewTCB->uxMutexesHeld = 0;
+		#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+		{
+			pxNewTCB->pvMutexBlockedOn = NULL;
+		}
+		#endif
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configUSE_RCU == 1 )
+	{
+		pxNewTCB->uxRcuNesting = 0;
+		pxNewTCB->uxRcuPreempted = 0;
+	}
+	#endif /* configUSE_RCU */
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -996,8 +1075,8 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		( void ) memset( ( void * ) &( pxNewTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxNewTCB->ulNotifiedValue ) );
+		( void ) memset( ( void * ) &( pxNewTCB->ucNotifyState[ 0 ] ), taskNOT_WAITING_NOTIFICATION, sizeof( pxNewTCB->ucNotifyState ) );
 	}
 	#endif
 
@@ -1130,6 +1209,18 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	{
 	TCB_t *pxTCB;
 
+		#if ( configUSE_HEAP_TRACKING == 1 )
+		{
+			/* The blocks of the task are moved to the unknown task with the
+			scheduler suspended, the lock of the other writers of the heap
+			tracker, rather than inside the critical section below, as the scan
+			grows with configHEAP_TRACKING_MAX_BLOCKS.  The scheduler is
+			suspended first so a task deleting itself is not switched out
+			before the scan. */
+			vTaskSuspendAll();
+		}
+		#endif /* configUSE_HEAP_TRACKING */
+
 		taskENTER_CRITICAL();
 		{
 			/* If null is passed in here then it is the calling task that is
@@ -1156,6 +1247,25 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( configUSE_RCU == 1 )
+			{
+				/* A task deleted inside an RCU read section leaves it, so the
+				grace period it was counted against can end, and a task that
+				deletes itself is not counted when it is switched out. */
+				if( pxTCB->uxRcuPreempted != ( UBaseType_t ) 0U )
+				{
+					( uxRcuPreemptedReaders[ pxTCB->uxRcuPreempted - ( UBaseType_t ) 1U ] )--;
+					pxTCB->uxRcuPreempted = ( UBaseType_t ) 0U;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxTCB->uxRcuNesting = ( UBaseType_t ) 0U;
+			}
+			#endif /* configUSE_RCU */
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1197,6 +1307,13 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		}
 		taskEXIT_CRITICAL();
 
+		#if ( configUSE_HEAP_TRACKING == 1 )
+		{
+			heaptrackTASK_DELETE( pxTCB );
+			( void ) xTaskResumeAll();
+		}
+		#endif /* configUSE_HEAP_TRACKING */
+
 		/* Force a reschedule if it is the currently running task that has just
 		been deleted. */
 		if( xSchedulerRunning != pdFALSE )
@@ -1387,17 +1504,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						UBaseType_t uxIndex;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( uxIndex = 0; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1702,11 +1823,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t uxIndex;
+
+				for( uxIndex = 0; uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ uxIndex ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but is
+						now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ uxIndex ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -2076,6 +2202,17 @@ void vTaskSuspendAll( void )
 	post in the FreeRTOS support forum before reporting this as a bug! -
 	http://goo.gl/wu4acr */
 	++uxSchedulerSuspended;
+
+	#if( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+	{
+		/* The scheduler is now suspended, so the calling task cannot be
+		switched out before the start of the section is recorded. */
+		if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+		{
+			criticalprofileSECTION_START( eCriticalProfileSchedulerSuspended, __builtin_return_address( 0 ) );
+		}
+	}
+	#endif
 }
 /*----------------------------------------------------------*/
 
@@ -2162,6 +2299,8 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
+			criticalprofileSECTION_END( eCriticalProfileSchedulerSuspended );
+
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
 			{
 				/* Move any readied tasks from the pending list into the
@@ -2910,6 +3049,10 @@ void vTaskSwitchContext( void )
 		xYieldPending = pdFALSE;
 		traceTASK_SWITCHED_OUT();
 
+		/* A task that yields from within a critical section takes its
+		interrupt mask with it, so close the section being profiled. */
+		criticalprofileSECTION_END( eCriticalProfileInterruptMask );
+
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
 				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
@@ -2940,6 +3083,23 @@ void vTaskSwitchContext( void )
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
+		/* A task switched out inside an RCU read section may still hold a
+		pointer to the version it read, so count it against the current grace
+		period until it leaves the section. */
+		#if ( configUSE_RCU == 1 )
+		{
+			if( ( pxCurrentTCB->uxRcuNesting != ( UBaseType_t ) 0U ) && ( pxCurrentTCB->uxRcuPreempted == ( UBaseType_t ) 0U ) )
+			{
+				pxCurrentTCB->uxRcuPreempted = ( uxRcuGracePeriod & ( UBaseType_t ) 1U ) + ( UBaseType_t ) 1U;
+				( uxRcuPreemptedReaders[ pxCurrentTCB->uxRcuPreempted - ( UBaseType_t ) 1U ] )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_RCU */
+
 		/* Before the currently running task is switched out, save its errno. */
 		#if( configUSE_POSIX_ERRNO == 1 )
 		{
@@ -3004,7 +3164,9 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 	list.  It is safe to access the event list here because it is part of an
 	event group implementation - and interrupts don't access event groups
 	directly (instead they access them indirectly by pending function calls to
-	the task level). */
+	the task level).  When configUSE_EVENT_GROUP_INDEX is 1 interrupts do access
+	event groups directly, and the event groups implementation calls this
+	function from within a critical section as well. */
 	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3146,6 +3308,63 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_INDEX == 1 )
+
+	BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+	{
+	TCB_t *pxUnblockedTCB;
+	BaseType_t xReturn;
+
+		/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS MASKED.  It is used by
+		the indexed event groups implementation, which lets interrupts set
+		event bits directly, so unlike vTaskRemoveFromUnorderedEventList() the
+		scheduler need not be suspended. */
+
+		/* Store the new item value in the event list. */
+		listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+		pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		configASSERT( pxUnblockedTCB );
+		( void ) uxListRemove( pxEventListItem );
+
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxUnblockedTCB );
+		}
+		else
+		{
+			/* The delayed and ready lists cannot be accessed, so hold this task
+			pending until the scheduler is resumed.  The item value set above
+			is kept while the task is on the pending ready list. */
+			vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+		}
+
+		if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+		{
+			/* As xTaskRemoveFromEventList(), the yield is also marked pending
+			in case the interrupt does not use its xHigherPriorityTaskWoken
+			parameter. */
+			xReturn = pdTRUE;
+			xYieldPending = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		#if( configUSE_TICKLESS_IDLE != 0 )
+		{
+			prvResetNextTaskUnblockTime();
+		}
+		#endif
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EVENT_GROUP_INDEX */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3572,6 +3791,12 @@ static void prvCheckTasksWaitingTermination( void )
 		pxTaskStatus->pxStackBase = pxTCB->pxStack;
 		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
 
+		#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+		{
+			pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
+		}
+		#endif
+
 		#if ( configUSE_MUTEXES == 1 )
 		{
 			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
@@ -3755,8 +3980,8 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			configKERNEL_OBJECT_FREE( pxTCB->pxStack );
+			configKERNEL_OBJECT_FREE( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
 		{
@@ -3767,14 +3992,14 @@ static void prvCheckTasksWaitingTermination( void )
 			{
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				configKERNEL_OBJECT_FREE( pxTCB->pxStack );
+				configKERNEL_OBJECT_FREE( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				configKERNEL_OBJECT_FREE( pxTCB );
 			}
 			else
 			{
@@ -3859,6 +4084,81 @@ TCB_t *pxTCB;
 #endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	static void prvRepositionOnEventList( TCB_t * const pxTCB )
+	{
+	List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+		/* If the task is blocked on a priority ordered event list, such as the
+		list of tasks waiting for a mutex, then its position in that list has
+		to follow its new priority too.  The pending ready list is not ordered
+		so is left alone. */
+		if( ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+		{
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInheritPriority( TCB_t * const pxMutexHolderTCB, const UBaseType_t uxNewPriority )
+	{
+		/* Adjust the mutex holder state to account for its new
+		priority.  Only reset the event list item value if the value is
+		not being used for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+			#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+			{
+				prvRepositionOnEventList( pxMutexHolderTCB );
+			}
+			#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* If the task being modified is in the ready state it will need
+		to be moved into a new list. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+		{
+			if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Inherit the priority before being moved into the new list. */
+			pxMutexHolderTCB->uxPriority = uxNewPriority;
+			prvAddTaskToReadyList( pxMutexHolderTCB );
+		}
+		else
+		{
+			/* Just inherit the priority. */
+			pxMutexHolderTCB->uxPriority = uxNewPriority;
+		}
+
+		traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, uxNewPriority );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
@@ -3876,42 +4176,7 @@ TCB_t *pxTCB;
 			inherit the priority of the task attempting to obtain the mutex. */
 			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
 			{
-				/* Adjust the mutex holder state to account for its new
-				priority.  Only reset the event list item value if the value is
-				not being used for anything else. */
-				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* If the task being modified is in the ready state it will need
-				to be moved into a new list. */
-				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-				{
-					if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-					{
-						taskRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* Inherit the priority before being moved into the new list. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-					prvAddTaskToReadyList( pxMutexHolderTCB );
-				}
-				else
-				{
-					/* Just inherit the priority. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-				}
-
-				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+				prvInheritPriority( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
 				/* Inheritance occurred. */
 				xReturn = pdTRUE;
@@ -3946,6 +4211,204 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	BaseType_t xTaskPriorityInheritChained( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+	BaseType_t xReturn = pdFALSE;
+
+		/* Unlike xTaskPriorityInherit(), only report inheritance when the
+		holder's priority actually changed.  The caller stops walking a chain
+		of blocked mutex holders as soon as this returns pdFALSE, which also
+		ends the walk if the chain loops back on itself. */
+		if( pxMutexHolderTCB != NULL )
+		{
+			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			{
+				prvInheritPriority( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	void vTaskSetMutexBlockedOn( void *pvMutex )
+	{
+		pxCurrentTCB->pvMutexBlockedOn = pvMutex;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	void *pvTaskGetMutexBlockedOn( TaskHandle_t xTask )
+	{
+	TCB_t * const pxTCB = xTask;
+	void *pvReturn = NULL;
+
+		/* The mutex is only reported while the task is still waiting on an
+		event list.  A task that has been unblocked but has not yet run to
+		clear pvMutexBlockedOn no longer passes priority along. */
+		if( pxTCB != NULL )
+		{
+			if( ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL ) && ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != &xPendingReadyList ) )
+			{
+				pvReturn = pxTCB->pvMutexBlockedOn;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RCU == 1 )
+
+	void vTaskRcuReadLock( void )
+	{
+		/* Only the calling task's own TCB is written, so readers never contend
+		with each other or with a writer.  The nesting count must be visible to
+		vTaskSwitchContext() before the protected pointer is loaded. */
+		( pxCurrentTCB->uxRcuNesting )++;
+		portMEMORY_BARRIER();
+	}
+
+#endif /* configUSE_RCU */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RCU == 1 )
+
+	void vTaskRcuReadUnlock( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+
+		configASSERT( pxTCB->uxRcuNesting != ( UBaseType_t ) 0U );
+
+		portMEMORY_BARRIER();
+		( pxTCB->uxRcuNesting )--;
+		portMEMORY_BARRIER();
+
+		/* The nesting count is cleared before the preempted flag is tested, so
+		a switch between the two cannot count the task a second time.  Only a
+		task that was switched out inside the section takes the slow path. */
+		if( ( pxTCB->uxRcuNesting == ( UBaseType_t ) 0U ) && ( pxTCB->uxRcuPreempted != ( UBaseType_t ) 0U ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				( uxRcuPreemptedReaders[ pxTCB->uxRcuPreempted - ( UBaseType_t ) 1U ] )--;
+				pxTCB->uxRcuPreempted = ( UBaseType_t ) 0U;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_RCU */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RCU == 1 )
+
+	void vTaskRcuSynchronize( void )
+	{
+	UBaseType_t uxParity, uxStarted;
+	BaseType_t xStarted = pdFALSE, xComplete = pdFALSE;
+
+		/* A task cannot wait for the read section it is itself inside. */
+		configASSERT( pxCurrentTCB->uxRcuNesting == ( UBaseType_t ) 0U );
+
+		/* The new version must be published before any reader that is counted
+		against the next grace period could load the pointer. */
+		portDATA_MEMORY_BARRIER();
+
+		/* Only one core runs the scheduler, so while this task runs every other
+		task inside a read section has been switched out and counted by
+		vTaskSwitchContext().  Starting a grace period flips the parity that
+		newly switched out readers are counted against, and the grace period
+		ends once the readers counted against the old parity have left their
+		sections.  A grace period cannot start while readers of the previous
+		one remain, so that the two generations are never counted together. */
+		while( xComplete == pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				uxParity = uxRcuGracePeriod & ( UBaseType_t ) 1U;
+
+				if( xStarted == pdFALSE )
+				{
+					if( ( uxRcuPreemptedReaders[ 0 ] == ( UBaseType_t ) 0U ) && ( uxRcuPreemptedReaders[ 1 ] == ( UBaseType_t ) 0U ) )
+					{
+						/* No task is inside a read section. */
+						xComplete = pdTRUE;
+					}
+					else if( uxRcuPreemptedReaders[ uxParity ^ ( UBaseType_t ) 1U ] == ( UBaseType_t ) 0U )
+					{
+						uxRcuGracePeriod++;
+						uxStarted = uxRcuGracePeriod;
+						xStarted = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( ( uxRcuGracePeriod != uxStarted ) || ( uxRcuPreemptedReaders[ uxParity ^ ( UBaseType_t ) 1U ] == ( UBaseType_t ) 0U ) )
+				{
+					/* Either the old readers have left, or another writer has
+					already started a grace period after them, which it could
+					only do once they had left. */
+					xComplete = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xComplete == pdFALSE )
+			{
+				/* The readers being waited for run at any priority, so give
+				them a tick to leave their sections. */
+				vTaskDelay( ( TickType_t ) 1 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+#endif /* configUSE_RCU */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
 	BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
@@ -4079,6 +4542,15 @@ TCB_t *pxTCB;
 					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
 					{
 						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+						#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+						{
+							/* The holder may itself be waiting for another
+							mutex, in which case the next holder along the
+							chain reads its priority from that list. */
+							prvRepositionOnEventList( pxTCB );
+						}
+						#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
 					}
 					else
 					{
@@ -4128,6 +4600,53 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+	BaseType_t xTaskPriorityDisinheritChainedAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	UBaseType_t uxPriorityUsedOnEntry;
+	BaseType_t xReturn = pdFALSE;
+
+		/* As xTaskPriorityInheritChained(), only report a change when the
+		holder's priority was actually lowered.  The priority only ever moves
+		down here, so a walk along a chain that loops back on itself still
+		ends.  A chain that loops back to the task that timed out, which is
+		deadlocked, ends at that task: as when a task holds several mutexes,
+		it keeps its inherited priority until it gives the mutex back. */
+		if( ( pxTCB != NULL ) && ( pxTCB != pxCurrentTCB ) )
+		{
+			uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+			if( uxHighestPriorityWaitingTask < uxPriorityUsedOnEntry )
+			{
+				vTaskPriorityDisinheritAfterTimeout( pxMutexHolder, uxHighestPriorityWaitingTask );
+
+				if( pxTCB->uxPriority != uxPriorityUsedOnEntry )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
@@ -4476,17 +4995,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToWait ) ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4514,17 +5035,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4532,7 +5053,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToWait ) ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4544,22 +5065,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToWait ) ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToWait ) ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4592,14 +5115,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToWait ) ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4608,11 +5131,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToWait ) ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToWait ) ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4624,44 +5147,46 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToNotify ) ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = ulValue;
 					}
 					else
 					{
@@ -4679,7 +5204,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] == ~0UL );
 
 					break;
 			}
@@ -4738,7 +5263,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4746,6 +5271,8 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4771,30 +5298,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToNotify ) ];
+			pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = ulValue;
 					}
 					else
 					{
@@ -4812,7 +5339,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] == ~0UL );
 					break;
 			}
 
@@ -4867,13 +5394,15 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4897,12 +5426,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToNotify ) ];
+			pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToNotify ) ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ taskNOTIFY_INDEX( uxIndexToNotify ) ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -4954,20 +5483,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToClear ) ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ taskNOTIFY_INDEX( uxIndexToClear ) ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
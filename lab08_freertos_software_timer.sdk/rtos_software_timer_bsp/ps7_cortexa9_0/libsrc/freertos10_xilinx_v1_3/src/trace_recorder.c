@@ -0,0 +1,227 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2012 - 2019 Xilinx, Inc. All rights reserved.
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "trace_recorder.h"
+
+/* Xilinx includes. */
+#include "xil_printf.h"
+#include "xparameters.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  This #if is closed at the very bottom of this
+file. */
+#if( configUSE_TRACE_RECORDER == 1 )
+
+#if( configUSE_TRACE_FACILITY != 1 )
+	#error configUSE_TRACE_FACILITY must be set to 1 in FreeRTOSConfig.h to use the trace recorder
+#endif
+
+/* The number of task names kept for the dump, indexed by task number. */
+#define trNAMED_TASKS		256
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Appends an event to the buffer, if recording and not full.
+ */
+static void prvRecordEvent( uint8_t ucEvent, uint8_t ucTask, uint32_t ulParameter );
+
+/*-----------------------------------------------------------*/
+
+static TraceRecorderEvent_t xEvents[ configTRACE_RECORDER_BUFFER_EVENTS ];
+static uint32_t ulEventCount = 0;
+static uint32_t ulEventsDropped = 0;
+static BaseType_t xRecording = pdTRUE;
+
+/* The number given to the next task created.  Task number 0 is kept for
+events raised by interrupts. */
+static uint8_t ucNextTaskNumber = 1;
+
+/* The name and creation priority of each task, kept so tasks that have since
+been deleted can still be named in the dump. */
+static char cTaskNames[ trNAMED_TASKS ][ configMAX_TASK_NAME_LEN ];
+static uint8_t ucTaskPriorities[ trNAMED_TASKS ];
+
+/*-----------------------------------------------------------*/
+
+static void prvRecordEvent( uint8_t ucEvent, uint8_t ucTask, uint32_t ulParameter )
+{
+UBaseType_t uxSavedInterruptStatus;
+TraceRecorderEvent_t *pxEvent;
+
+	/* Events are recorded from both tasks and interrupts. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( xRecording != pdFALSE )
+		{
+			if( ulEventCount < ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS )
+			{
+				pxEvent = &( xEvents[ ulEventCount ] );
+				pxEvent->ulTimestamp = portGET_CYCLE_COUNT();
+				pxEvent->ucEvent = ucEvent;
+				pxEvent->ucTask = ucTask;
+				pxEvent->usParameter = ( uint16_t ) ulParameter;
+				ulEventCount++;
+			}
+			else
+			{
+				ulEventsDropped++;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderTaskEvent( uint8_t ucEvent, void *pvTask, uint32_t ulParameter )
+{
+uint8_t ucTask;
+
+	if( ucEvent == tracerecorderTASK_CREATE )
+	{
+		/* Number the task.  This is called from within a critical section. */
+		ucTask = ucNextTaskNumber;
+		ucNextTaskNumber++;
+		if( ucNextTaskNumber == tracerecorderNO_TASK )
+		{
+			ucNextTaskNumber++;
+		}
+		vTaskSetTaskNumber( ( TaskHandle_t ) pvTask, ( UBaseType_t ) ucTask );
+
+		/* The name has been copied into the TCB by the time the task is
+		created, and does not change afterwards. */
+		strncpy( cTaskNames[ ucTask ], pcTaskGetName( ( TaskHandle_t ) pvTask ), configMAX_TASK_NAME_LEN );
+		cTaskNames[ ucTask ][ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+		ucTaskPriorities[ ucTask ] = ( uint8_t ) ulParameter;
+	}
+	else
+	{
+		ucTask = ( uint8_t ) uxTaskGetTaskNumber( ( TaskHandle_t ) pvTask );
+	}
+
+	prvRecordEvent( ucEvent, ucTask, ulParameter );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderCurrentTaskEvent( uint8_t ucEvent, uint32_t ulParameter )
+{
+	prvRecordEvent( ucEvent, ( uint8_t ) uxTaskGetTaskNumber( xTaskGetCurrentTaskHandle() ), ulParameter );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderInterruptEvent( uint8_t ucEvent, uint32_t ulParameter )
+{
+	prvRecordEvent( ucEvent, tracerecorderNO_TASK, ulParameter );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( void )
+{
+	taskENTER_CRITICAL();
+	{
+		ulEventCount = 0;
+		ulEventsDropped = 0;
+		xRecording = pdTRUE;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+	xRecording = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTraceRecorderGetEvents( const TraceRecorderEvent_t **ppxEvents )
+{
+	*ppxEvents = xEvents;
+	return ulEventCount;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderDump( void )
+{
+uint32_t ulEvent;
+BaseType_t xTask;
+uint8_t ucSeen[ trNAMED_TASKS ];
+
+	vTraceRecorderStop();
+
+	xil_printf( "TRACE_BEGIN,%u,%u,%u\r\n", ( unsigned int ) XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ,
+				( unsigned int ) ulEventCount, ( unsigned int ) ulEventsDropped );
+
+	/* Name each task that appears in the trace. */
+	memset( ucSeen, 0x00, sizeof( ucSeen ) );
+	for( ulEvent = 0; ulEvent < ulEventCount; ulEvent++ )
+	{
+		ucSeen[ xEvents[ ulEvent ].ucTask ] = 1;
+	}
+
+	for( xTask = 1; xTask < trNAMED_TASKS; xTask++ )
+	{
+		if( ucSeen[ xTask ] != 0 )
+		{
+			xil_printf( "TRACE_TASK,%d,%s,%u\r\n", ( int ) xTask, cTaskNames[ xTask ], ( unsigned int ) ucTaskPriorities[ xTask ] );
+		}
+	}
+
+	for( ulEvent = 0; ulEvent < ulEventCount; ulEvent++ )
+	{
+		xil_printf( "TRACE,%08x,%u,%u,%u\r\n",
+					( unsigned int ) xEvents[ ulEvent ].ulTimestamp,
+					( unsigned int ) xEvents[ ulEvent ].ucEvent,
+					( unsigned int ) xEvents[ ulEvent ].ucTask,
+					( unsigned int ) xEvents[ ulEvent ].usParameter );
+	}
+
+	xil_printf( "TRACE_END\r\n" );
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  If you want to include the trace recorder then
+ensure configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TRACE_RECORDER == 1 */
@@ -0,0 +1,195 @@
+ /*
+ * FreeRTOS Kernel V10.0.0
+ * Copyright (C) 2010-2018 Xilinx, Inc. All Rights Reserved.
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software. If you wish to use our Amazon
+ * FreeRTOS name, please do so in a fair use way that does not cause confusion.
+ *
+ * THE SOFTWARE IS PROVIDED "AS-IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Configuration of the host simulation build.  It follows the BSP's
+ * FreeRTOSConfig.h so the application sees the same kernel, except where the
+ * target settings have no meaning on the host.
+ */
+
+#ifndef _FREERTOSCONFIG_H
+#define _FREERTOSCONFIG_H
+
+#include "xparameters.h"
+
+#define configUSE_PREEMPTION 1
+
+#define configUSE_MUTEXES 1
+
+#define INCLUDE_xSemaphoreGetMutexHolder 1
+
+#define configUSE_RECURSIVE_MUTEXES 1
+
+#define configUSE_COUNTING_SEMAPHORES 1
+
+#define configUSE_TIMERS 1
+
+/* The idle hook advances virtual time, see portmacro.h. */
+#define configUSE_IDLE_HOOK 1
+
+#define configUSE_TICK_HOOK 1
+
+#define configUSE_DAEMON_TASK_STARTUP_HOOK 0
+
+#define configUSE_MALLOC_FAILED_HOOK 1
+
+#define configUSE_TRACE_FACILITY 1
+
+#define configUSE_NEWLIB_REENTRANT 0
+#define configUSE_NEWLIB_MALLOC_BRIDGE 0
+
+#define configSTREAM_BUFFER 1
+
+#define configMESSAGE_BUFFER 1
+
+/* The application's tasks and timers, and the idle and timer tasks, are
+created in memory allocated at compile time rather than on the heap. */
+#define configSUPPORT_STATIC_ALLOCATION 1
+
+#define configUSE_16_BIT_TICKS 0
+
+#define configUSE_APPLICATION_TASK_TAG 0
+
+#define configUSE_CO_ROUTINES 0
+
+#define configCPU_CLOCK_HZ XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ
+
+#define configTICK_RATE_HZ (100)
+
+#define configMAX_PRIORITIES (8)
+
+#define configMAX_CO_ROUTINE_PRIORITIES 2
+
+#define configMINIMAL_STACK_SIZE ( ( unsigned short ) 200)
+
+/* Twice the target heap, StackType_t is twice the size on a 64-bit host. */
+#define configTOTAL_HEAP_SIZE ( ( size_t ) ( 65536 ) )
+
+#define configTOTAL_BULK_HEAP_SIZE ( 2097152 )
+
+#define configTOTAL_DMA_HEAP_SIZE ( 1048576 )
+
+#define configUSE_TLSF_HEAP 1
+
+#define configUSE_OBJECT_POOLS 1
+
+/* { block size, number of blocks } of each kernel object pool. */
+#define configOBJECT_POOL_CLASSES									\
+	{ sizeof( StaticTimer_t ), 4 },									\
+	{ sizeof( StaticTask_t ), 8 },									\
+	{ sizeof( StaticQueue_t ) + 64, 8 },							\
+	{ configMINIMAL_STACK_SIZE * sizeof( StackType_t ), 6 },		\
+	{ configMINIMAL_STACK_SIZE * 2 * sizeof( StackType_t ), 4 }
+
+#define configMAX_TASK_NAME_LEN 10
+
+#define configIDLE_SHOULD_YIELD 1
+
+#define configUSE_TIME_SLICING 1
+
+#define configTIMER_TASK_PRIORITY (configMAX_PRIORITIES - 1)
+
+#define configTIMER_QUEUE_LENGTH 10
+
+#define configTIMER_TASK_STACK_DEPTH ((configMINIMAL_STACK_SIZE) * 2)
+
+#define configASSERT( x ) if( ( x ) == 0 ) vApplicationAssert( __FILE__, __LINE__ )
+
+#define configUSE_QUEUE_SETS 1
+
+#define configUSE_ZERO_COPY_QUEUES 1
+
+#define configUSE_SPSC_RINGS 1
+#define configSPSC_RING_NOTIFY_INDEX 1
+
+#define configUSE_ARENAS 1
+#define configARENA_OVERRUN_CHECK 0
+
+#define configUSE_EVENT_GROUP_INDEX 1
+
+#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE 1
+
+#define configUSE_MUTEX_METRICS 1
+
+#define configUSE_SPIN_LOCKS 1
+#define configSPIN_LOCK_NOTIFY_INDEX 2
+
+#define configUSE_RCU 1
+
+#define configUSE_QUEUE_SET_BITMAP 1
+
+#define configUSE_TASK_NOTIFICATIONS 1
+
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
+
+/* Tasks run on their thread's stack, not on the FreeRTOS stack. */
+#define configCHECK_FOR_STACK_OVERFLOW 0
+
+#define configQUEUE_REGISTRY_SIZE 10
+
+#define configUSE_STATS_FORMATTING_FUNCTIONS 1
+
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
+
+#define configGENERATE_RUN_TIME_STATS 0
+
+#define configUSE_CRITICAL_SECTION_PROFILING 0
+#define configUSE_HEAP_TRACKING 1
+#define configUSE_STACK_PROFILER 1
+#define configRECORD_STACK_HIGH_ADDRESS 1
+
+/* Set SIM_TRACE to print the trace when the simulation ends. */
+#define configUSE_TRACE_RECORDER 1
+#define configTRACE_RECORDER_BUFFER_EVENTS 65536
+
+#define configUSE_TICKLESS_IDLE	0
+#define configTASK_RETURN_ADDRESS    NULL
+#define INCLUDE_vTaskPrioritySet             1
+#define INCLUDE_uxTaskPriorityGet            1
+#define INCLUDE_vTaskDelete                  1
+#define INCLUDE_vTaskCleanUpResources        1
+#define INCLUDE_vTaskSuspend                 1
+#define INCLUDE_vTaskDelayUntil              1
+#define INCLUDE_vTaskDelay                   1
+#define INCLUDE_eTaskGetState                1
+#define INCLUDE_xTimerPendFunctionCall       1
+#define INCLUDE_pcTaskGetTaskName            1
+#define INCLUDE_xTaskGetCurrentTaskHandle    1
+#define portPOINTER_SIZE_TYPE	uintptr_t
+#define portTICK_TYPE_IS_ATOMIC 1
+#define configMESSAGE_BUFFER_LENGTH_TYPE uint32_t
+#define configSTACK_DEPTH_TYPE uint32_t
+
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+
+void vApplicationAssert( const char *pcFile, uint32_t ulLine );
+
+#include "trace_recorder.h"
+
+#endif
@@ -0,0 +1,696 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * kernel_check: runs kernel scenarios that the applications never reach, on
+ * the simulated kernel, and checks their outcome.
+ *
+ * CHECKtask runs the scenarios one after the other.  Each scenario creates
+ * its own tasks and objects, waits for them with vTaskDelay(), and deletes
+ * them again before the next one starts.  As time is virtual, every run takes
+ * the same path.  The result of each scenario is printed as:
+ *
+ *	CHECK_BEGIN,kernel_check
+ *	CHECK,<scenario>,pass
+ *	CHECK,<scenario>,fail,<first failed expectation>
+ *	CHECK_END,<failed scenarios>
+ *
+ * and the exit status is 0 only if every scenario passed.  A scenario that
+ * trips a configASSERT() ends the run with the simulator's assert message
+ * instead, and a non-zero status.
+ *
+ * Scenarios:
+ *
+ *   mutex_chain  - transitive priority inheritance along a chain of two
+ *                  mutexes, then a deadlocked cycle of the same mutexes that
+ *                  is broken by timeouts.  CHAINC holds M1 and CHAINB
+ *                  holds M2 while blocked on M1.  CHAIND blocks on M2,
+ *                  raising B and, through M1, C.  C then blocks on M2 as well.
+ *                  D times out, then C, whose timeout walks the chain back to
+ *                  C itself.
+ *
+ *   rcu_delete_reader - RCUREADER is switched out inside an RCU read section
+ *                  and deleted there.  RCUWRITER then publishes a new version,
+ *                  which must not wait for the deleted reader.
+ *
+ *   heap_track   - HTWORKER allocates blocks from one call site and frees
+ *                  every other one, then the rest, which shifts entries of the
+ *                  tracker's side table back over the freed ones.  It then
+ *                  creates stream buffers from two call sites, which must be
+ *                  charged to those call sites rather than to stream_buffer.c,
+ *                  and to HTWORKER until it is deleted.  vHeapTrackList() must
+ *                  list HTWORKER.
+ *
+ *   stack_profile - SPTASK is created on a large stack, which is marked as
+ *                  used well into it, and sampled.  It is then deleted and
+ *                  created again with the same name on a smaller stack, marked
+ *                  as used to near its end.  The profile must start a new peak
+ *                  for the smaller stack and flag it, and vStackProfileList()
+ *                  must list it.  The simulated tasks run on their threads'
+ *                  stacks, so the use is marked by hand.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rcu.h"
+#include "stream_buffer.h"
+#include "heap_track.h"
+#include "stack_profile.h"
+
+#if( configUSE_TRANSITIVE_PRIORITY_INHERITANCE != 1 )
+	#error mutex_chain checks transitive priority inheritance
+#endif
+
+#if( configUSE_RCU != 1 )
+	#error rcu_delete_reader checks RCU
+#endif
+
+#if( ( configUSE_HEAP_TRACKING != 1 ) || ( configUSE_STATS_FORMATTING_FUNCTIONS != 1 ) )
+	#error heap_track checks the heap tracker and vHeapTrackList()
+#endif
+
+#if( ( configUSE_STACK_PROFILER != 1 ) || ( configSUPPORT_STATIC_ALLOCATION != 1 ) )
+	#error stack_profile checks the stack profiler on stacks given to xTaskCreateStatic()
+#endif
+
+#define checkPRIORITY				( configMAX_PRIORITIES - 2 )	/* CHECKtask, above every scenario task */
+#define checkSTACK_SIZE				( configMINIMAL_STACK_SIZE * 2 )
+#define checkMAX_DETAIL				96
+
+/* The priorities of the mutex_chain tasks. */
+#define checkCHAIN_PRIORITY_B		( tskIDLE_PRIORITY + 2 )
+#define checkCHAIN_PRIORITY_C		( tskIDLE_PRIORITY + 3 )
+#define checkCHAIN_PRIORITY_D		( tskIDLE_PRIORITY + 5 )
+
+/* The mutex_chain timeline, in ticks from the start of the scenario. */
+#define checkCHAIN_D_BLOCKS			2		/* D blocks on M2 */
+#define checkCHAIN_C_BLOCKS			6		/* C blocks on M2 */
+#define checkCHAIN_D_TIMEOUT		10		/* D gives up 10 ticks after blocking */
+#define checkCHAIN_C_TIMEOUT		20		/* C gives up 20 ticks after blocking */
+#define checkCHAIN_B_TIMEOUT		100		/* B waits for M1 until C gives it */
+
+/* The ticks the rcu_delete_reader writer is given to publish. */
+#define checkRCU_PUBLISH_TICKS		20
+
+/* The blocks of heap_track.  The stream buffer counts differ from each other
+and from anything else live, so each call site can be told apart. */
+#define checkHT_BLOCKS				64
+#define checkHT_STREAMS_A			5
+#define checkHT_STREAMS_B			9
+#define checkHT_STREAM_SIZE			100
+#define checkHT_MAX_SITES			64
+#define checkHT_LIST_SIZE			8192
+
+/* The stacks of stack_profile, in words, and the words marked as used on
+each.  The use of the small stack is within configSTACK_PROFILE_MARGIN_PERCENT
+of its end. */
+#define checkSP_LARGE_DEPTH			1024
+#define checkSP_LARGE_USED			700
+#define checkSP_SMALL_DEPTH			256
+#define checkSP_SMALL_USED			250
+#define checkSP_LIST_SIZE			2048
+
+typedef struct CHECK_SCENARIO
+{
+	const char *pcName;
+	void ( *pxFunction )( void );
+} CheckScenario_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the scenarios and ends the simulation.
+ */
+static void prvCHECKtask( void *pvParameters );
+
+/*
+ * Fails the running scenario if xCondition is pdFALSE, recording the first
+ * failed expectation in cDetail.
+ */
+static void prvExpect( BaseType_t xCondition, const char *pcWhat, UBaseType_t uxGot, UBaseType_t uxWanted );
+
+/*
+ * The scenarios, and the tasks they create.
+ */
+static void prvMutexChainCheck( void );
+static void prvChainTaskB( void *pvParameters );
+static void prvChainTaskC( void *pvParameters );
+static void prvChainTaskD( void *pvParameters );
+static void prvRcuDeleteReaderCheck( void );
+static void prvRcuReaderTask( void *pvParameters );
+static void prvRcuWriterTask( void *pvParameters );
+static void prvHeapTrackCheck( void );
+static void prvHeapTrackWorker( void *pvParameters );
+
+/*
+ * Waits for the heap_track worker to reach uxStep.
+ */
+static void prvHeapTrackWait( UBaseType_t uxStep );
+
+/*
+ * Writes the call sites holding live blocks that are not in xHTBaseline[]
+ * into pxSites, and returns their number.
+ */
+static UBaseType_t prvHeapTrackNewSites( HeapTrackSite_t *pxSites );
+
+/*
+ * Returns the entry of xTask among the tasks of the heap tracker, or NULL.
+ */
+static const HeapTrackTask_t *prvHeapTrackFindTask( TaskHandle_t xTask );
+static void prvStackProfileCheck( void );
+static void prvStackProfileTask( void *pvParameters );
+
+/*
+ * Creates SPTASK on puxStack, marks uxUsed words at its top as used, takes a
+ * sample, and returns the profile of SPTASK in pxEntry.
+ */
+static TaskHandle_t prvStackProfileCreate( StaticTask_t *pxTaskBuffer, StackType_t *puxStack, UBaseType_t uxDepth, UBaseType_t uxUsed, StackProfileEntry_t *pxEntry );
+
+/*-----------------------------------------------------------*/
+
+static const CheckScenario_t xScenarios[] =
+{
+	{ "mutex_chain",		prvMutexChainCheck			},
+	{ "rcu_delete_reader",	prvRcuDeleteReaderCheck		},
+	{ "heap_track",			prvHeapTrackCheck			},
+	{ "stack_profile",		prvStackProfileCheck		},
+};
+
+/* The outcome of the running scenario. */
+static BaseType_t xResult;
+static char cDetail[ checkMAX_DETAIL ];
+
+/* The objects and outcomes of mutex_chain. */
+static SemaphoreHandle_t xChainM1;
+static SemaphoreHandle_t xChainM2;
+static volatile BaseType_t xChainTakeD;
+static volatile BaseType_t xChainTakeC;
+static volatile BaseType_t xChainTakeB;
+static volatile UBaseType_t uxChainPriorityCAfterTimeout;
+static volatile UBaseType_t uxChainPriorityCAfterGive;
+static volatile UBaseType_t uxChainPriorityBAfterGive;
+static volatile BaseType_t xChainDone;
+
+/* The objects and outcomes of rcu_delete_reader. */
+static RcuHandle_t xRcu;
+static volatile BaseType_t xRcuPublished;
+
+/* The objects and outcomes of heap_track. */
+static void *pvHTBlocks[ checkHT_BLOCKS ];
+static StreamBufferHandle_t xHTStreams[ checkHT_STREAMS_A + checkHT_STREAMS_B ];
+static volatile UBaseType_t uxHTStep;
+static HeapTrackSite_t xHTBaseline[ checkHT_MAX_SITES ];
+static UBaseType_t uxHTBaselineSites;
+static HeapTrackSite_t xHTSites[ checkHT_MAX_SITES ];
+static HeapTrackTask_t xHTTasks[ configHEAP_TRACKING_MAX_TASKS + 1 ];
+static char cHTList[ checkHT_LIST_SIZE ];
+
+/* The memory and outcomes of stack_profile. */
+static StaticTask_t xSPLargeTaskBuffer, xSPSmallTaskBuffer;
+static StackType_t uxSPLargeStack[ checkSP_LARGE_DEPTH ];
+static StackType_t uxSPSmallStack[ checkSP_SMALL_DEPTH ];
+static StackProfileEntry_t xSPReport[ configSTACK_PROFILE_MAX_ENTRIES ];
+static char cSPList[ checkSP_LIST_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvCHECKtask, "CHECKtask", checkSTACK_SIZE, NULL, checkPRIORITY, NULL );
+	vTaskStartScheduler();
+
+	return 1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCHECKtask( void *pvParameters )
+{
+size_t x;
+UBaseType_t uxFailed = 0;
+
+	( void ) pvParameters;
+
+	printf( "CHECK_BEGIN,kernel_check\n" );
+
+	for( x = 0; x < sizeof( xScenarios ) / sizeof( xScenarios[ 0 ] ); x++ )
+	{
+		xResult = pdPASS;
+		cDetail[ 0 ] = '\0';
+
+		xScenarios[ x ].pxFunction();
+
+		if( xResult == pdPASS )
+		{
+			printf( "CHECK,%s,pass\n", xScenarios[ x ].pcName );
+		}
+		else
+		{
+			printf( "CHECK,%s,fail,%s\n", xScenarios[ x ].pcName, cDetail );
+			uxFailed++;
+		}
+	}
+
+	printf( "CHECK_END,%lu\n", ( unsigned long ) uxFailed );
+	fflush( stdout );
+	exit( ( uxFailed == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvExpect( BaseType_t xCondition, const char *pcWhat, UBaseType_t uxGot, UBaseType_t uxWanted )
+{
+	if( ( xCondition == pdFALSE ) && ( xResult == pdPASS ) )
+	{
+		snprintf( cDetail, sizeof( cDetail ), "%s %lu not %lu", pcWhat, ( unsigned long ) uxGot, ( unsigned long ) uxWanted );
+		xResult = pdFAIL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexChainCheck( void )
+{
+TaskHandle_t xTaskB, xTaskC, xTaskD;
+UBaseType_t uxPriority;
+
+	xChainM1 = xSemaphoreCreateMutex();
+	xChainM2 = xSemaphoreCreateMutex();
+	configASSERT( xChainM1 && xChainM2 );
+	xChainDone = pdFALSE;
+
+	/* C runs first and takes M1, then B takes M2 and blocks on M1. */
+	xTaskCreate( prvChainTaskC, "CHAINC", checkSTACK_SIZE, NULL, checkCHAIN_PRIORITY_C, &xTaskC );
+	xTaskCreate( prvChainTaskB, "CHAINB", checkSTACK_SIZE, NULL, checkCHAIN_PRIORITY_B, &xTaskB );
+	xTaskCreate( prvChainTaskD, "CHAIND", checkSTACK_SIZE, NULL, checkCHAIN_PRIORITY_D, &xTaskD );
+
+	/* D is blocked on M2: B inherits D's priority, and so does C through the
+	M1 that B is blocked on. */
+	vTaskDelay( checkCHAIN_D_BLOCKS + 1 );
+	uxPriority = uxTaskPriorityGet( xTaskB );
+	prvExpect( uxPriority == checkCHAIN_PRIORITY_D, "B inherited", uxPriority, checkCHAIN_PRIORITY_D );
+	uxPriority = uxTaskPriorityGet( xTaskC );
+	prvExpect( uxPriority == checkCHAIN_PRIORITY_D, "C inherited", uxPriority, checkCHAIN_PRIORITY_D );
+
+	/* D has timed out, but C, which is still waiting for M2, has D's priority
+	itself, so neither B nor C drop. */
+	vTaskDelay( checkCHAIN_D_TIMEOUT );
+	prvExpect( xChainTakeD == pdFALSE, "D took M2", ( UBaseType_t ) xChainTakeD, pdFALSE );
+	uxPriority = uxTaskPriorityGet( xTaskB );
+	prvExpect( uxPriority == checkCHAIN_PRIORITY_D, "B after D timed out", uxPriority, checkCHAIN_PRIORITY_D );
+	uxPriority = uxTaskPriorityGet( xTaskC );
+	prvExpect( uxPriority == checkCHAIN_PRIORITY_D, "C after D timed out", uxPriority, checkCHAIN_PRIORITY_D );
+
+	/* C has timed out, which breaks the cycle.  C keeps D's priority until it
+	gives M1, B then takes M1 and both are back at their own priorities. */
+	while( xChainDone == pdFALSE )
+	{
+		vTaskDelay( 1 );
+	}
+
+	prvExpect( xChainTakeC == pdFALSE, "C took M2", ( UBaseType_t ) xChainTakeC, pdFALSE );
+	prvExpect( xChainTakeB == pdTRUE, "B took M1", ( UBaseType_t ) xChainTakeB, pdTRUE );
+	prvExpect( uxChainPriorityCAfterTimeout == checkCHAIN_PRIORITY_D, "C after timing out", uxChainPriorityCAfterTimeout, checkCHAIN_PRIORITY_D );
+	prvExpect( uxChainPriorityCAfterGive == checkCHAIN_PRIORITY_C, "C after giving M1", uxChainPriorityCAfterGive, checkCHAIN_PRIORITY_C );
+	prvExpect( uxChainPriorityBAfterGive == checkCHAIN_PRIORITY_B, "B after giving M2", uxChainPriorityBAfterGive, checkCHAIN_PRIORITY_B );
+
+	vTaskDelete( xTaskB );
+	vTaskDelete( xTaskC );
+	vTaskDelete( xTaskD );
+	vSemaphoreDelete( xChainM1 );
+	vSemaphoreDelete( xChainM2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTaskB( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xSemaphoreTake( xChainM2, 0 );
+	xChainTakeB = xSemaphoreTake( xChainM1, checkCHAIN_B_TIMEOUT );
+
+	if( xChainTakeB != pdFALSE )
+	{
+		xSemaphoreGive( xChainM1 );
+	}
+	xSemaphoreGive( xChainM2 );
+	uxChainPriorityBAfterGive = uxTaskPriorityGet( NULL );
+	xChainDone = pdTRUE;
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTaskC( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xSemaphoreTake( xChainM1, 0 );
+	vTaskDelay( checkCHAIN_C_BLOCKS );
+
+	/* Closes the cycle: B waits for C's M1, C waits for B's M2. */
+	xChainTakeC = xSemaphoreTake( xChainM2, checkCHAIN_C_TIMEOUT );
+	uxChainPriorityCAfterTimeout = uxTaskPriorityGet( NULL );
+
+	xSemaphoreGive( xChainM1 );
+	uxChainPriorityCAfterGive = uxTaskPriorityGet( NULL );
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTaskD( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTaskDelay( checkCHAIN_D_BLOCKS );
+	xChainTakeD = xSemaphoreTake( xChainM2, checkCHAIN_D_TIMEOUT );
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRcuDeleteReaderCheck( void )
+{
+TaskHandle_t xReader, xWriter;
+uint32_t *pulVersion;
+TickType_t xTicks;
+
+	pulVersion = pvPortMalloc( sizeof( uint32_t ) );
+	configASSERT( pulVersion );
+	*pulVersion = 1UL;
+	xRcu = xRcuCreate( pulVersion );
+	configASSERT( xRcu );
+	xRcuPublished = pdFALSE;
+
+	/* The reader enters a read section and is switched out inside it, which
+	counts it against the current grace period, then it is deleted. */
+	xTaskCreate( prvRcuReaderTask, "RCUREADER", checkSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xReader );
+	vTaskDelay( 2 );
+	prvExpect( eTaskGetState( xReader ) == eSuspended, "reader state", ( UBaseType_t ) eTaskGetState( xReader ), eSuspended );
+	vTaskDelete( xReader );
+
+	/* The writer must not wait for the deleted reader to leave. */
+	xTaskCreate( prvRcuWriterTask, "RCUWRITER", checkSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xWriter );
+	for( xTicks = 0; ( xTicks < checkRCU_PUBLISH_TICKS ) && ( xRcuPublished == pdFALSE ); xTicks++ )
+	{
+		vTaskDelay( 1 );
+	}
+
+	prvExpect( xRcuPublished == pdTRUE, "published", ( UBaseType_t ) xRcuPublished, pdTRUE );
+
+	/* A writer still waiting is left, as deleting it inside vRcuPublish()
+	would leak the version it publishes. */
+	if( xRcuPublished != pdFALSE )
+	{
+		vTaskDelete( xWriter );
+		vRcuDelete( xRcu );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRcuReaderTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	( void ) pvRcuReadLock( xRcu );
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRcuWriterTask( void *pvParameters )
+{
+uint32_t *pulVersion;
+
+	( void ) pvParameters;
+
+	pulVersion = pvRcuCopy( xRcu, sizeof( uint32_t ) );
+	configASSERT( pulVersion );
+	( *pulVersion )++;
+	vRcuPublish( xRcu, pulVersion );
+	xRcuPublished = pdTRUE;
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapTrackCheck( void )
+{
+TaskHandle_t xWorker;
+HeapTrackSite_t xNew[ checkHT_MAX_SITES ];
+const HeapTrackTask_t *pxTask;
+UBaseType_t uxNew, uxUnknownBlocks;
+size_t x;
+char cLine[ configMAX_TASK_NAME_LEN + 2 ];
+
+	uxHTStep = 0;
+	uxHTBaselineSites = uxHeapTrackGetSites( xHTBaseline, ( UBaseType_t ) checkHT_MAX_SITES );
+	pxTask = prvHeapTrackFindTask( NULL );
+	uxUnknownBlocks = ( pxTask != NULL ) ? pxTask->uxLiveBlocks : 0;
+
+	xTaskCreate( prvHeapTrackWorker, "HTWORKER", checkSTACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xWorker );
+
+	/* Half the blocks are freed: one new call site holds the other half. */
+	prvHeapTrackWait( 1 );
+	uxNew = prvHeapTrackNewSites( xNew );
+	prvExpect( uxNew == 1, "sites after freeing half", uxNew, 1 );
+	prvExpect( xNew[ 0 ].uxLiveBlocks == ( checkHT_BLOCKS / 2 ), "blocks after freeing half", xNew[ 0 ].uxLiveBlocks, checkHT_BLOCKS / 2 );
+
+	/* All the blocks are freed and the stream buffers created: the only new
+	call sites are the two xStreamBufferCreate() calls of the worker. */
+	vTaskResume( xWorker );
+	prvHeapTrackWait( 2 );
+	uxNew = prvHeapTrackNewSites( xNew );
+	prvExpect( uxNew == 2, "stream buffer sites", uxNew, 2 );
+	prvExpect( ( xNew[ 0 ].uxLiveBlocks == checkHT_STREAMS_B ) && ( xNew[ 1 ].uxLiveBlocks == checkHT_STREAMS_A ), "first site blocks", xNew[ 0 ].uxLiveBlocks, checkHT_STREAMS_B );
+	prvExpect( xNew[ 0 ].pvCallSite != xNew[ 1 ].pvCallSite, "distinct sites", 0, 1 );
+	prvExpect( ulHeapTrackGetUntracked() == 0UL, "untracked", ( UBaseType_t ) ulHeapTrackGetUntracked(), 0 );
+
+	pxTask = prvHeapTrackFindTask( xWorker );
+	prvExpect( pxTask != NULL, "worker tracked", 0, 1 );
+	if( pxTask != NULL )
+	{
+		prvExpect( pxTask->uxLiveBlocks == ( checkHT_STREAMS_A + checkHT_STREAMS_B ), "worker blocks", pxTask->uxLiveBlocks, checkHT_STREAMS_A + checkHT_STREAMS_B );
+		prvExpect( pxTask->ulAllocations == ( checkHT_BLOCKS + checkHT_STREAMS_A + checkHT_STREAMS_B ), "worker allocations", ( UBaseType_t ) pxTask->ulAllocations, checkHT_BLOCKS + checkHT_STREAMS_A + checkHT_STREAMS_B );
+	}
+
+	vHeapTrackList( cHTList );
+	snprintf( cLine, sizeof( cLine ), "\n%s\t", "HTWORKER" );
+	prvExpect( strstr( cHTList, cLine ) != NULL, "HTWORKER listed", 0, 1 );
+
+	/* The blocks of the deleted worker move to the unknown task. */
+	vTaskDelete( xWorker );
+	prvExpect( prvHeapTrackFindTask( xWorker ) == NULL, "deleted worker tracked", 1, 0 );
+	pxTask = prvHeapTrackFindTask( NULL );
+	prvExpect( ( pxTask != NULL ) && ( pxTask->uxLiveBlocks == ( uxUnknownBlocks + checkHT_STREAMS_A + checkHT_STREAMS_B ) ), "unknown task blocks", ( pxTask != NULL ) ? pxTask->uxLiveBlocks : 0, uxUnknownBlocks + checkHT_STREAMS_A + checkHT_STREAMS_B );
+
+	for( x = 0; x < ( checkHT_STREAMS_A + checkHT_STREAMS_B ); x++ )
+	{
+		vStreamBufferDelete( xHTStreams[ x ] );
+	}
+
+	uxNew = prvHeapTrackNewSites( xNew );
+	prvExpect( uxNew == 0, "sites after deleting", uxNew, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapTrackWorker( void *pvParameters )
+{
+size_t x;
+
+	( void ) pvParameters;
+
+	for( x = 0; x < checkHT_BLOCKS; x++ )
+	{
+		pvHTBlocks[ x ] = pvPortMalloc( 16 + x );
+		configASSERT( pvHTBlocks[ x ] );
+	}
+
+	for( x = 0; x < checkHT_BLOCKS; x += 2 )
+	{
+		vPortFree( pvHTBlocks[ x ] );
+	}
+
+	uxHTStep = 1;
+	vTaskSuspend( NULL );
+
+	for( x = 1; x < checkHT_BLOCKS; x += 2 )
+	{
+		vPortFree( pvHTBlocks[ x ] );
+	}
+
+	for( x = 0; x < checkHT_STREAMS_A; x++ )
+	{
+		xHTStreams[ x ] = xStreamBufferCreate( checkHT_STREAM_SIZE, 1 );
+		configASSERT( xHTStreams[ x ] );
+	}
+
+	for( x = checkHT_STREAMS_A; x < ( checkHT_STREAMS_A + checkHT_STREAMS_B ); x++ )
+	{
+		xHTStreams[ x ] = xStreamBufferCreate( checkHT_STREAM_SIZE, 1 );
+		configASSERT( xHTStreams[ x ] );
+	}
+
+	uxHTStep = 2;
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapTrackWait( UBaseType_t uxStep )
+{
+	while( uxHTStep < uxStep )
+	{
+		vTaskDelay( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHeapTrackNewSites( HeapTrackSite_t *pxSites )
+{
+UBaseType_t uxSites, uxNew = 0, x, y;
+BaseType_t xFound;
+
+	uxSites = uxHeapTrackGetSites( xHTSites, ( UBaseType_t ) checkHT_MAX_SITES );
+
+	for( x = 0; x < uxSites; x++ )
+	{
+		xFound = pdFALSE;
+
+		for( y = 0; y < uxHTBaselineSites; y++ )
+		{
+			if( xHTBaseline[ y ].pvCallSite == xHTSites[ x ].pvCallSite )
+			{
+				xFound = pdTRUE;
+				break;
+			}
+		}
+
+		if( xFound == pdFALSE )
+		{
+			pxSites[ uxNew ] = xHTSites[ x ];
+			uxNew++;
+		}
+	}
+
+	return uxNew;
+}
+/*-----------------------------------------------------------*/
+
+static const HeapTrackTask_t *prvHeapTrackFindTask( TaskHandle_t xTask )
+{
+UBaseType_t uxTasks, x;
+const HeapTrackTask_t *pxReturn = NULL;
+
+	uxTasks = uxHeapTrackGetTasks( xHTTasks, ( UBaseType_t ) ( configHEAP_TRACKING_MAX_TASKS + 1 ) );
+
+	for( x = 0; x < uxTasks; x++ )
+	{
+		if( xHTTasks[ x ].xTask == xTask )
+		{
+			pxReturn = &( xHTTasks[ x ] );
+			break;
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStackProfileCheck( void )
+{
+TaskHandle_t xTask;
+StackProfileEntry_t xEntry;
+char cLine[ configMAX_TASK_NAME_LEN + 40 ];
+
+	xTask = prvStackProfileCreate( &xSPLargeTaskBuffer, uxSPLargeStack, checkSP_LARGE_DEPTH, checkSP_LARGE_USED, &xEntry );
+	prvExpect( xEntry.ulSizeBytes == ( checkSP_LARGE_DEPTH * sizeof( StackType_t ) ), "large size", xEntry.ulSizeBytes, checkSP_LARGE_DEPTH * sizeof( StackType_t ) );
+	prvExpect( xEntry.ulPeakBytes == ( checkSP_LARGE_USED * sizeof( StackType_t ) ), "large peak", xEntry.ulPeakBytes, checkSP_LARGE_USED * sizeof( StackType_t ) );
+	prvExpect( xEntry.xNearOverflow == pdFALSE, "large near overflow", ( UBaseType_t ) xEntry.xNearOverflow, pdFALSE );
+
+	/* Let the idle task clean up SPTASK before it is created again. */
+	vTaskDelete( xTask );
+	vTaskDelay( 2 );
+
+	xTask = prvStackProfileCreate( &xSPSmallTaskBuffer, uxSPSmallStack, checkSP_SMALL_DEPTH, checkSP_SMALL_USED, &xEntry );
+	prvExpect( xEntry.ulSizeBytes == ( checkSP_SMALL_DEPTH * sizeof( StackType_t ) ), "small size", xEntry.ulSizeBytes, checkSP_SMALL_DEPTH * sizeof( StackType_t ) );
+	prvExpect( xEntry.ulPeakBytes == ( checkSP_SMALL_USED * sizeof( StackType_t ) ), "small peak", xEntry.ulPeakBytes, checkSP_SMALL_USED * sizeof( StackType_t ) );
+	prvExpect( xEntry.xNearOverflow != pdFALSE, "small near overflow", ( UBaseType_t ) xEntry.xNearOverflow, pdTRUE );
+
+	vStackProfileList( cSPList );
+	snprintf( cLine, sizeof( cLine ), "SPTASK\ttask\t%u\t%u\t", ( unsigned int ) ( checkSP_SMALL_DEPTH * sizeof( StackType_t ) ), ( unsigned int ) ( checkSP_SMALL_USED * sizeof( StackType_t ) ) );
+	prvExpect( strstr( cSPList, cLine ) != NULL, "SPTASK listed", 0, 1 );
+
+	vTaskDelete( xTask );
+	vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStackProfileTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvStackProfileCreate( StaticTask_t *pxTaskBuffer, StackType_t *puxStack, UBaseType_t uxDepth, UBaseType_t uxUsed, StackProfileEntry_t *pxEntry )
+{
+TaskHandle_t xTask;
+UBaseType_t uxEntries, x;
+
+	xTask = xTaskCreateStatic( prvStackProfileTask, "SPTASK", ( uint32_t ) uxDepth, NULL, tskIDLE_PRIORITY + 1, puxStack, pxTaskBuffer );
+	configASSERT( xTask );
+
+	/* The stack grows down from the top, and its use is measured up to the
+	lowest word that no longer holds the fill value.  The simulator keeps the
+	thread of the task at the top of the stack, so only the lowest used word
+	is marked. */
+	puxStack[ uxDepth - uxUsed ] = ( StackType_t ) 0;
+	vStackProfileSample();
+
+	memset( pxEntry, 0x00, sizeof( *pxEntry ) );
+	uxEntries = uxStackProfileGetReport( xSPReport, ( UBaseType_t ) configSTACK_PROFILE_MAX_ENTRIES );
+
+	for( x = 0; x < uxEntries; x++ )
+	{
+		if( ( xSPReport[ x ].xIsTask != pdFALSE ) && ( strcmp( xSPReport[ x ].pcName, "SPTASK" ) == 0 ) )
+		{
+			*pxEntry = xSPReport[ x ];
+			break;
+		}
+	}
+
+	return xTask;
+}
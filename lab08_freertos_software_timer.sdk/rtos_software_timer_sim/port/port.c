@@ -0,0 +1,571 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Simulated BSP includes. */
+#include "xil_printf.h"
+
+#ifndef configCPU_CLOCK_HZ
+	#error configCPU_CLOCK_HZ must be defined to the simulated CPU clock in FreeRTOSConfig.h
+#endif
+
+#if( configUSE_IDLE_HOOK == 0 )
+	#error configUSE_IDLE_HOOK must be 1, the idle hook advances virtual time
+#endif
+
+/* The number of simulated CPU cycles between two ticks. */
+#define portCYCLES_PER_TICK			( ( uint64_t ) configCPU_CLOCK_HZ / ( uint64_t ) configTICK_RATE_HZ )
+
+/* The critical nesting value before the scheduler starts.  As on the target,
+it keeps interrupts masked until the first task starts. */
+#define portINITIAL_CRITICAL_NESTING	( ( UBaseType_t ) 9999 )
+
+/* The run length, in ticks, is read from this environment variable.  The
+simulation runs until it is killed if the variable is not set. */
+#define portRUN_TICKS_VARIABLE		"SIM_TICKS"
+
+/* If this environment variable is set the trace recorder buffer is printed
+when the simulation ends. */
+#define portTRACE_DUMP_VARIABLE		"SIM_TRACE"
+
+/*-----------------------------------------------------------*/
+
+/* The thread that runs a task, and the interrupt state it last ran with.  It
+lives at the top of the task's stack, and the TCB's pxTopOfStack points to it
+for the life of the task. */
+typedef struct SIM_THREAD
+{
+	pthread_t xThread;
+	pthread_cond_t xResume;				/* Signalled when the task is switched in. */
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	BaseType_t xRunning;				/* pdTRUE while the task is the one switched in. */
+	BaseType_t xExit;					/* pdTRUE once the task has been deleted. */
+	UBaseType_t uxCriticalNesting;
+	BaseType_t xInterruptsMasked;
+} SimThread_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The entry point of every task thread.  Waits to be switched in before
+ * running the task function.
+ */
+static void *prvTaskThread( void *pvParameters );
+
+/*
+ * Blocks the calling thread until its task is switched in again, then
+ * restores the interrupt state of the task.  Exits the thread instead if the
+ * task was deleted while it was switched out.  Called with xSwitchMutex held,
+ * returns with it released.
+ */
+static void prvWaitToRun( SimThread_t *pxThread );
+
+/*
+ * Selects the next task to run and hands the processor to its thread.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Takes every tick interrupt that has fallen due, provided interrupts are not
+ * masked.
+ */
+static void prvServiceInterrupts( void );
+
+/*
+ * Ends the simulation.
+ */
+static void prvEndSimulation( void ) __attribute__((noreturn));
+
+/*-----------------------------------------------------------*/
+
+/* Held while the processor is being handed from one thread to another.  Only
+the thread of the running task is ever outside pthread_cond_wait(). */
+static pthread_mutex_t xSwitchMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* The main thread waits on this once the scheduler has started.  It is never
+signalled: the simulation ends by calling exit(). */
+static pthread_cond_t xMainThreadWait = PTHREAD_COND_INITIALIZER;
+
+/* The interrupt state of the running task. */
+static UBaseType_t uxCriticalNesting = portINITIAL_CRITICAL_NESTING;
+static BaseType_t xInterruptsMasked = pdTRUE;
+
+/* pdTRUE while the tick interrupt handler is running, and set by
+portYIELD_FROM_ISR() to request a context switch when it exits. */
+static BaseType_t xInInterrupt = pdFALSE;
+static BaseType_t xYieldFromInterrupt = pdFALSE;
+
+/* Virtual time, in simulated CPU cycles. */
+static uint64_t ullCycles = 0;
+static uint64_t ullNextTickCycles = 0;
+static BaseType_t xSchedulerRunning = pdFALSE;
+
+/* The number of ticks to run for, or 0 to run until killed. */
+static TickType_t xRunTicks = 0;
+
+/* The simulated interrupt requested by vPortSimulateInterruptAt(), if any. */
+static void ( *pxInterruptHandler )( void ) = NULL;
+static uint64_t ullInterruptCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+SimThread_t *pxThread;
+int iResult;
+
+	/* The stack is never used by the task itself, which runs on the stack of
+	its thread, so the thread's control block is kept at the top of it. */
+	pxThread = ( SimThread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( SimThread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->xRunning = pdFALSE;
+	pxThread->xExit = pdFALSE;
+	pxThread->uxCriticalNesting = 0;
+	pxThread->xInterruptsMasked = pdFALSE;
+	pthread_cond_init( &( pxThread->xResume ), NULL );
+
+	iResult = pthread_create( &( pxThread->xThread ), NULL, prvTaskThread, pxThread );
+	configASSERT( iResult == 0 );
+	( void ) iResult;
+
+	return ( StackType_t * ) pxThread;
+}
+/*-----------------------------------------------------------*/
+
+static SimThread_t *prvCurrentThread( void )
+{
+	/* The first member of a TCB is pxTopOfStack. */
+	return *( SimThread_t ** ) xTaskGetCurrentTaskHandle();
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTaskThread( void *pvParameters )
+{
+SimThread_t *pxThread = ( SimThread_t * ) pvParameters;
+
+	pthread_mutex_lock( &xSwitchMutex );
+	prvWaitToRun( pxThread );
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* A task must not return from its implementing function.  On the target
+	it would fall into prvTaskExitError(). */
+	fflush( stdout );
+	fprintf( stderr, "SIM: a task returned from its implementing function\n" );
+	abort();
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitToRun( SimThread_t *pxThread )
+{
+	while( ( pxThread->xRunning == pdFALSE ) && ( pxThread->xExit == pdFALSE ) )
+	{
+		pthread_cond_wait( &( pxThread->xResume ), &xSwitchMutex );
+	}
+
+	if( pxThread->xExit != pdFALSE )
+	{
+		pthread_mutex_unlock( &xSwitchMutex );
+		pthread_exit( NULL );
+	}
+
+	pthread_mutex_unlock( &xSwitchMutex );
+
+	uxCriticalNesting = pxThread->uxCriticalNesting;
+	xInterruptsMasked = pxThread->xInterruptsMasked;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+SimThread_t *pxFrom, *pxTo;
+
+	pxFrom = prvCurrentThread();
+	pxFrom->uxCriticalNesting = uxCriticalNesting;
+	pxFrom->xInterruptsMasked = xInterruptsMasked;
+
+	/* As on the target, the switch is made with interrupts masked. */
+	xInterruptsMasked = pdTRUE;
+	ullCycles += portSIM_CONTEXT_SWITCH_CYCLES;
+	vTaskSwitchContext();
+	pxTo = prvCurrentThread();
+
+	if( pxTo != pxFrom )
+	{
+		pthread_mutex_lock( &xSwitchMutex );
+		pxFrom->xRunning = pdFALSE;
+		pxTo->xRunning = pdTRUE;
+		pthread_cond_signal( &( pxTo->xResume ) );
+		prvWaitToRun( pxFrom );
+	}
+	else
+	{
+		xInterruptsMasked = pxFrom->xInterruptsMasked;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+const char *pcRunTicks;
+SimThread_t *pxFirst;
+
+	pcRunTicks = getenv( portRUN_TICKS_VARIABLE );
+	if( pcRunTicks != NULL )
+	{
+		xRunTicks = ( TickType_t ) strtoul( pcRunTicks, NULL, 0 );
+	}
+
+	ullNextTickCycles = ullCycles + portCYCLES_PER_TICK;
+	xSchedulerRunning = pdTRUE;
+
+	/* Start the first task.  The scheduler has already selected it. */
+	pxFirst = prvCurrentThread();
+	pthread_mutex_lock( &xSwitchMutex );
+	pxFirst->xRunning = pdTRUE;
+	pthread_cond_signal( &( pxFirst->xResume ) );
+
+	/* The main thread takes no further part in the simulation. */
+	for( ;; )
+	{
+		pthread_cond_wait( &xMainThreadWait, &xSwitchMutex );
+	}
+
+	/* Should not get here. */
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	prvEndSimulation();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndSimulation( void )
+{
+	#if( configUSE_TRACE_RECORDER == 1 )
+	{
+		if( getenv( portTRACE_DUMP_VARIABLE ) != NULL )
+		{
+			vTraceRecorderDump();
+		}
+	}
+	#endif
+
+	fflush( stdout );
+	fprintf( stderr, "SIM: stopped at tick %lu, cycle %llu\n",
+			 ( unsigned long ) xTaskGetTickCount(), ( unsigned long long ) ullCycles );
+	exit( EXIT_SUCCESS );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	prvSwitchContext();
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( BaseType_t xSwitchRequired )
+{
+	if( xSwitchRequired != pdFALSE )
+	{
+		if( xInInterrupt != pdFALSE )
+		{
+			xYieldFromInterrupt = pdTRUE;
+		}
+		else
+		{
+			prvSwitchContext();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	xInterruptsMasked = pdTRUE;
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( uxCriticalNesting > 0 )
+	{
+		uxCriticalNesting--;
+
+		if( uxCriticalNesting == 0 )
+		{
+			xInterruptsMasked = pdFALSE;
+			vPortSimulateCycles( portSIM_CRITICAL_SECTION_CYCLES );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsMasked = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xInterruptsMasked = pdFALSE;
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t ulPortSetInterruptMask( void )
+{
+UBaseType_t ulReturn = ( UBaseType_t ) xInterruptsMasked;
+
+	xInterruptsMasked = pdTRUE;
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t ulNewMaskValue )
+{
+	xInterruptsMasked = ( BaseType_t ) ulNewMaskValue;
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pvTCB )
+{
+SimThread_t *pxThread = *( SimThread_t ** ) pvTCB;
+
+	/* The thread is waiting in prvWaitToRun(), either in its own context
+	switch or before its first.  Wait for it to exit before the stack that
+	holds pxThread is freed. */
+	pthread_mutex_lock( &xSwitchMutex );
+	pxThread->xExit = pdTRUE;
+	pthread_cond_signal( &( pxThread->xResume ) );
+	pthread_mutex_unlock( &xSwitchMutex );
+
+	pthread_join( pxThread->xThread, NULL );
+	pthread_cond_destroy( &( pxThread->xResume ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvServiceInterrupts( void )
+{
+BaseType_t xSwitchRequired;
+void ( *pxHandler )( void );
+
+	while( ( xSchedulerRunning != pdFALSE ) && ( xInterruptsMasked == pdFALSE ) )
+	{
+		xSwitchRequired = pdFALSE;
+		xInterruptsMasked = pdTRUE;
+		xInInterrupt = pdTRUE;
+
+		/* Take whichever interrupt fell due first. */
+		if( ( pxInterruptHandler != NULL ) && ( ullCycles >= ullInterruptCycles ) && ( ullInterruptCycles <= ullNextTickCycles ) )
+		{
+			pxHandler = pxInterruptHandler;
+			pxInterruptHandler = NULL;
+			pxHandler();
+		}
+		else if( ullCycles >= ullNextTickCycles )
+		{
+			ullNextTickCycles += portCYCLES_PER_TICK;
+			ullCycles += portSIM_TICK_INTERRUPT_CYCLES;
+			xSwitchRequired = xTaskIncrementTick();
+
+			if( ( xRunTicks != 0 ) && ( xTaskGetTickCount() >= xRunTicks ) )
+			{
+				prvEndSimulation();
+			}
+		}
+		else
+		{
+			xInInterrupt = pdFALSE;
+			xInterruptsMasked = pdFALSE;
+			break;
+		}
+
+		xInInterrupt = pdFALSE;
+		xInterruptsMasked = pdFALSE;
+
+		if( ( xSwitchRequired != pdFALSE ) || ( xYieldFromInterrupt != pdFALSE ) )
+		{
+			xYieldFromInterrupt = pdFALSE;
+			prvSwitchContext();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateCycles( uint32_t ulCycles )
+{
+	ullCycles += ulCycles;
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateWaitForInterrupt( void )
+{
+uint64_t ullNextInterrupt = ullNextTickCycles;
+
+	if( ( pxInterruptHandler != NULL ) && ( ullInterruptCycles < ullNextInterrupt ) )
+	{
+		ullNextInterrupt = ullInterruptCycles;
+	}
+
+	if( ullCycles < ullNextInterrupt )
+	{
+		ullCycles = ullNextInterrupt;
+	}
+
+	prvServiceInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateInterruptAt( uint64_t ullAtCycle, void ( *pxHandler )( void ) )
+{
+	ullInterruptCycles = ullAtCycle;
+	pxInterruptHandler = pxHandler;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortSimulatedCycles( void )
+{
+	return ullCycles;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableCycleCounter( void )
+{
+	/* The virtual clock always runs. */
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetCycleCount( void )
+{
+uint32_t ulCount = ( uint32_t ) ullCycles;
+
+	vPortSimulateCycles( portSIM_CYCLE_COUNTER_CYCLES );
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Default implementations of the callbacks FreeRTOSConfig.h may require, as
+ * provided for the target by portZynq7000.c.  They are declared as weak
+ * symbols so the application can override them.
+ */
+void vApplicationAssert( const char *pcFileName, uint32_t ulLine ) __attribute__((weak));
+void vApplicationTickHook( void ) __attribute__((weak));
+void vApplicationIdleHook( void ) __attribute__((weak));
+void vApplicationMallocFailedHook( void ) __attribute__((weak));
+void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __attribute__((weak));
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize ) __attribute__((weak));
+	#if( configUSE_TIMERS == 1 )
+		void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize ) __attribute__((weak));
+	#endif
+#endif
+
+void vApplicationAssert( const char *pcFileName, uint32_t ulLine )
+{
+	fflush( stdout );
+	fprintf( stderr, "SIM: assert failed in %s, line %lu\n", pcFileName, ( unsigned long ) ulLine );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+/* The processor has nothing to do until the next interrupt. */
+void vApplicationIdleHook( void )
+{
+	vPortSimulateWaitForInterrupt();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	xil_printf( "vApplicationMallocFailedHook() called\n" );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName )
+{
+	( void ) xTask;
+
+	fflush( stdout );
+	fprintf( stderr, "SIM: task %s overflowed its stack\n", pcTaskName );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+	{
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+		*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+		*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+		*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if( configUSE_TIMERS == 1 )
+
+		void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+		{
+		static StaticTask_t xTimerTaskTCB;
+		static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+			*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+			*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+			*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+		}
+
+	#endif /* configUSE_TIMERS */
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
@@ -0,0 +1,183 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * Host simulation port.  Each task runs in its own POSIX thread, but only the
+ * thread of the task selected by the scheduler is ever allowed to run, so the
+ * simulation behaves like the single core target.  Time is virtual: it is a
+ * count of simulated CPU cycles that advances by a fixed cost at each call
+ * into the port layer and the simulated peripherals, and jumps straight to the
+ * next tick when the idle task runs.  The tick "interrupt" is taken at the
+ * first of those calls made with interrupts enabled after the tick falls due,
+ * so a run depends only on its inputs and replays exactly.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uintptr_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+/*-----------------------------------------------------------*/
+
+/* Hardware specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portCACHE_LINE_SIZE			32	/* as the target, so buffers are laid out alike */
+
+/* The TCBs and queues are aligned as on the target, so they are laid out
+alike too.  Only heap_tlsf.c can allocate them aligned. */
+#if( configUSE_TLSF_HEAP == 1 )
+	#define portCONTROL_BLOCK_ALIGNMENT	portCACHE_LINE_SIZE
+	#define portCONTROL_BLOCK_ALIGNED	__attribute__( ( aligned( portCONTROL_BLOCK_ALIGNMENT ) ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Simulated costs, in CPU cycles, of the operations that advance virtual
+time.  They only need to be of the right order for the target: the
+simulation is for checking scheduling behaviour, not for timing code. */
+#ifndef portSIM_CRITICAL_SECTION_CYCLES
+	#define portSIM_CRITICAL_SECTION_CYCLES		50
+#endif
+
+#ifndef portSIM_CONTEXT_SWITCH_CYCLES
+	#define portSIM_CONTEXT_SWITCH_CYCLES		300
+#endif
+
+#ifndef portSIM_TICK_INTERRUPT_CYCLES
+	#define portSIM_TICK_INTERRUPT_CYCLES		1000
+#endif
+
+#ifndef portSIM_CYCLE_COUNTER_CYCLES
+	#define portSIM_CYCLE_COUNTER_CYCLES		10
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Task utilities. */
+void vPortYield( void );
+void vPortYieldFromISR( BaseType_t xSwitchRequired );
+#define portYIELD() vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) vPortYieldFromISR( xSwitchRequired )
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+
+/*-----------------------------------------------------------*/
+
+/* Critical section control. */
+void vPortEnterCritical( void );
+void vPortExitCritical( void );
+void vPortDisableInterrupts( void );
+void vPortEnableInterrupts( void );
+UBaseType_t ulPortSetInterruptMask( void );
+void vPortClearInterruptMask( UBaseType_t ulNewMaskValue );
+
+#define portENTER_CRITICAL()		vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+#define portDISABLE_INTERRUPTS()	vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()		vPortEnableInterrupts()
+#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	vPortClearInterruptMask( x )
+
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+not required for this port but included in case common demo code that uses these
+macros is used. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )	void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )	void vFunction( void *pvParameters )
+
+/* There is no FPU context to manage on the host. */
+#define portTASK_USES_FLOATING_POINT()
+
+/* The thread of a deleted task is stopped when its TCB is freed. */
+void vPortCleanUpTCB( void *pvTCB );
+#define portCLEAN_UP_TCB( pxTCB ) vPortCleanUpTCB( ( void * ) ( pxTCB ) )
+
+/*-----------------------------------------------------------*/
+
+/* Virtual time.  vPortSimulateCycles() charges the calling task for work that
+takes simulated time, such as a peripheral access, and takes any interrupt that
+falls due.  vPortSimulateWaitForInterrupt() is the simulated WFI: it advances
+virtual time to the next tick.  The default idle hook calls it, so an
+application that provides its own idle hook must call it too. */
+void vPortSimulateCycles( uint32_t ulCycles );
+void vPortSimulateWaitForInterrupt( void );
+uint64_t ullPortSimulatedCycles( void );
+
+/* Requests a simulated peripheral interrupt: pxHandler is called, as an
+interrupt service routine, once virtual time reaches ullAtCycle.  There is one
+such interrupt source, so a request replaces any that is still pending.  The
+handler may request the next interrupt, and may use portYIELD_FROM_ISR(). */
+void vPortSimulateInterruptAt( uint64_t ullAtCycle, void ( *pxHandler )( void ) );
+
+/* The cycle counter is the virtual clock. */
+void vPortEnableCycleCounter( void );
+uint32_t ulPortGetCycleCount( void );
+#define portGET_CYCLE_COUNT() ulPortGetCycleCount()
+
+#define portNOP()
+#define portINLINE __inline
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+#define portDATA_MEMORY_BARRIER() __sync_synchronize()
+
+/* The atomic operations of the target, on the host.  Only one task runs at a
+time, so waiting for an event is a no-op and there is a single core. */
+#define ulPortCompareAndSwap( pulDestination, ulComparand, ulExchange ) __sync_val_compare_and_swap( ( pulDestination ), ( ulComparand ), ( ulExchange ) )
+#define ulPortAtomicExchange( pulDestination, ulExchange ) __sync_lock_test_and_set( ( pulDestination ), ( ulExchange ) )
+#define portWAIT_FOR_EVENT()
+#define portSEND_EVENT()
+#define portGET_CORE_ID() ( 0UL )
+
+#ifdef __cplusplus
+	} /* extern C */
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,597 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * trace_replay: replays a trace printed by the trace recorder on the simulated
+ * kernel, and compares the response times of each task with those recorded.
+ *
+ *	trace_replay [-p NAME=PRIORITY]... TRACE
+ *
+ * TRACE is the output of a run with configUSE_TRACE_RECORDER set to 1 that
+ * ended with a call to vTraceRecorderDump(), on the board or in the
+ * simulation; lines that are not part of the dump are ignored.  "-" reads the
+ * standard input.
+ *
+ * The trace is first cut into jobs.  A job of a task is released when the
+ * task is created or moved to the Ready state from the Blocked or Suspended
+ * state, and completes when the task next blocks, suspends itself or is
+ * deleted.  Its demand is the time the task spent running between the two.
+ * Releases that happen before the scheduler starts are moved to the start.
+ * The idle task is not replayed.  A job still running when the trace ends,
+ * such as the whole run of a task that never blocks, is replayed for the time
+ * it ran so that it loads the processor as it did, but has no response time.
+ *
+ * Each task that ran a job is then created again, at its recorded priority or
+ * at the priority given with -p, as a task that takes a notification and runs
+ * for the demand of its next job.  A simulated interrupt gives the
+ * notifications at the recorded release times.  When every job has completed
+ * the tool prints, for each task, the minimum, average and maximum response
+ * times in microseconds, recorded and replayed, and whether the jobs completed
+ * in the recorded order:
+ *
+ *	REPLAY_BEGIN,<trace>,<jobs>
+ *	REPLAY_FIELDS,task,recorded_priority,priority,jobs,...
+ *	REPLAY,<task>,<recorded priority>,<priority>,<jobs>,<times...>
+ *	REPLAY_ORDER,same | REPLAY_ORDER,differs,<first differing job>
+ *	REPLAY_END
+ *
+ * A replay with the recorded priorities checks the model; replays with other
+ * priorities show the effect of a priority assignment on the same workload
+ * before it is tried on the board.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error The replayed tasks are released by direct to task notifications
+#endif
+
+/* Limits of the trace that can be replayed. */
+#define replayMAX_TASKS				256
+#define replayMAX_JOBS				65536
+#define replayMAX_LINE				128
+
+/* The longest a replayed job runs without calling into the kernel, so the
+replay sees interrupts at about the same points as the recorded run. */
+#define replayCHUNK_CYCLES			100
+
+/* Indexes into the response times of a job. */
+#define replayRECORDED				0
+#define replayREPLAYED				1
+
+/* The name of the idle task, which is not replayed. */
+#define replayIDLE_TASK_NAME		"IDLE"
+
+typedef struct REPLAY_JOB
+{
+	uint64_t ullRelease;				/* Relative to the start of the scheduler. */
+	uint64_t ullDemand;
+	uint64_t ullResponse[ 2 ];			/* Recorded and replayed. */
+	BaseType_t xCompleted;				/* pdFALSE if the trace ended first. */
+	uint8_t ucTask;
+} ReplayJob_t;
+
+typedef struct REPLAY_TASK
+{
+	char cName[ configMAX_TASK_NAME_LEN ];
+	UBaseType_t uxRecordedPriority;
+	UBaseType_t uxPriority;
+	BaseType_t xBlocked;				/* Blocked or suspended in the trace. */
+	BaseType_t xRunning;				/* Running in the trace. */
+	BaseType_t xInJob;					/* Released and not yet completed. */
+	uint64_t ullRelease;
+	uint64_t ullDemand;
+	uint64_t ullRunningSince;
+	uint32_t ulJobs;					/* Completed jobs. */
+	BaseType_t xReplayed;
+	TaskHandle_t xHandle;
+} ReplayTask_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Reads the trace into xJobs[], in the order the jobs completed.
+ */
+static void prvReadTrace( FILE *pxFile );
+
+/*
+ * Ends the current job of a task at ullNow, if it is in one.  xCompleted is
+ * pdFALSE for a job cut short by the end of the trace.
+ */
+static void prvEndJob( uint8_t ucTask, uint64_t ullNow, BaseType_t xCompleted );
+
+/*
+ * The simulated interrupt that releases the jobs.
+ */
+static void prvReleaseHandler( void );
+
+/*
+ * The body of each replayed task.
+ */
+static void prvReplayTask( void *pvParameters );
+
+/*
+ * Prints the response times, recorded and replayed.
+ */
+static void prvPrintReport( void );
+
+/*-----------------------------------------------------------*/
+
+static ReplayTask_t xTasks[ replayMAX_TASKS ];
+static ReplayJob_t xJobs[ replayMAX_JOBS ];
+static uint32_t ulJobCount = 0;
+static uint32_t ulCompletedJobCount = 0;
+
+/* The cycle count of the first switch in, in the trace. */
+static uint64_t ullTraceStart = 0;
+static BaseType_t xTraceStarted = pdFALSE;
+static uint32_t ulTraceHz = configCPU_CLOCK_HZ;
+
+/* The jobs in the order of their release, and the next to be released. */
+static uint32_t ulReleaseOrder[ replayMAX_JOBS ];
+static uint32_t ulNextRelease = 0;
+
+/* The simulated cycle count at which the replay started. */
+static uint64_t ullReplayStart = 0;
+
+/* The task of each job, in the order the replayed jobs completed. */
+static uint8_t ucCompletionOrder[ replayMAX_JOBS ];
+static uint32_t ulCompleted = 0;
+
+static const char *pcTraceName = NULL;
+
+/*-----------------------------------------------------------*/
+
+static void prvEndJob( uint8_t ucTask, uint64_t ullNow, BaseType_t xCompleted )
+{
+ReplayTask_t *pxTask = &( xTasks[ ucTask ] );
+ReplayJob_t *pxJob;
+uint64_t ullRelease;
+
+	if( pxTask->xRunning != pdFALSE )
+	{
+		pxTask->ullDemand += ullNow - pxTask->ullRunningSince;
+		pxTask->xRunning = pdFALSE;
+	}
+
+	/* The idle task is not replayed. */
+	if( ( pxTask->xInJob != pdFALSE ) && ( ulJobCount < replayMAX_JOBS ) && ( strcmp( pxTask->cName, replayIDLE_TASK_NAME ) != 0 ) )
+	{
+		ullRelease = ( pxTask->ullRelease > ullTraceStart ) ? pxTask->ullRelease : ullTraceStart;
+
+		pxJob = &( xJobs[ ulJobCount ] );
+		pxJob->ullRelease = ullRelease - ullTraceStart;
+		pxJob->ullDemand = pxTask->ullDemand;
+		pxJob->ullResponse[ replayRECORDED ] = ullNow - ullRelease;
+		pxJob->xCompleted = xCompleted;
+		pxJob->ucTask = ucTask;
+		ulJobCount++;
+		pxTask->xReplayed = pdTRUE;
+
+		if( xCompleted != pdFALSE )
+		{
+			ulCompletedJobCount++;
+			pxTask->ulJobs++;
+		}
+	}
+
+	pxTask->xInJob = pdFALSE;
+	pxTask->xBlocked = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadTrace( FILE *pxFile )
+{
+char cLine[ replayMAX_LINE ];
+char cName[ replayMAX_LINE ];
+unsigned int uxTimestamp, uxEvent, uxTask, uxParameter, uxCount, uxDropped;
+uint32_t ulLastTimestamp = 0;
+uint64_t ullHigh = 0, ullNow = 0;
+int lCurrent = -1;
+ReplayTask_t *pxTask;
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		if( sscanf( cLine, "TRACE,%x,%u,%u,%u", &uxTimestamp, &uxEvent, &uxTask, &uxParameter ) == 4 )
+		{
+			/* The recorded timestamps are 32 bits wide. */
+			if( ( uint32_t ) uxTimestamp < ulLastTimestamp )
+			{
+				ullHigh += 0x100000000ULL;
+			}
+			ulLastTimestamp = ( uint32_t ) uxTimestamp;
+			ullNow = ullHigh | ( uint64_t ) uxTimestamp;
+
+			pxTask = &( xTasks[ uxTask % replayMAX_TASKS ] );
+
+			switch( uxEvent )
+			{
+				case tracerecorderTASK_CREATE:
+					pxTask->xInJob = pdTRUE;
+					pxTask->xBlocked = pdFALSE;
+					pxTask->ullRelease = ullNow;
+					pxTask->ullDemand = 0;
+					break;
+
+				case tracerecorderTASK_READY:
+					if( pxTask->xBlocked != pdFALSE )
+					{
+						pxTask->xInJob = pdTRUE;
+						pxTask->xBlocked = pdFALSE;
+						pxTask->ullRelease = ullNow;
+						pxTask->ullDemand = 0;
+					}
+					break;
+
+				case tracerecorderTASK_SWITCHED_IN:
+					if( xTraceStarted == pdFALSE )
+					{
+						xTraceStarted = pdTRUE;
+						ullTraceStart = ullNow;
+					}
+
+					if( ( lCurrent >= 0 ) && ( xTasks[ lCurrent ].xRunning != pdFALSE ) )
+					{
+						xTasks[ lCurrent ].ullDemand += ullNow - xTasks[ lCurrent ].ullRunningSince;
+						xTasks[ lCurrent ].xRunning = pdFALSE;
+					}
+
+					lCurrent = ( int ) ( uxTask % replayMAX_TASKS );
+					pxTask->xRunning = pdTRUE;
+					pxTask->ullRunningSince = ullNow;
+					break;
+
+				case tracerecorderTASK_BLOCKED:
+				case tracerecorderTASK_SUSPENDED:
+				case tracerecorderTASK_DELETE:
+					if( pxTask->xRunning != pdFALSE )
+					{
+						prvEndJob( ( uint8_t ) uxTask, ullNow, pdTRUE );
+					}
+					else
+					{
+						/* Suspended or deleted by another task: the job it
+						was in never completed. */
+						pxTask->xInJob = pdFALSE;
+						pxTask->xBlocked = pdTRUE;
+					}
+					break;
+
+				default:
+					/* Ticks, priority changes and queue operations are not
+					needed to rebuild the jobs. */
+					break;
+			}
+		}
+		else if( sscanf( cLine, "TRACE_TASK,%u,%127[^,],%u", &uxTask, cName, &uxParameter ) == 3 )
+		{
+			pxTask = &( xTasks[ uxTask % replayMAX_TASKS ] );
+			cName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+			strcpy( pxTask->cName, cName );
+			pxTask->uxRecordedPriority = ( UBaseType_t ) uxParameter;
+			pxTask->uxPriority = ( UBaseType_t ) uxParameter;
+		}
+		else if( sscanf( cLine, "TRACE_BEGIN,%u,%u,%u", &uxParameter, &uxCount, &uxDropped ) == 3 )
+		{
+			ulTraceHz = ( uint32_t ) uxParameter;
+
+			if( uxDropped != 0 )
+			{
+				fprintf( stderr, "trace_replay: the trace buffer filled, %u events were not recorded\n", uxDropped );
+			}
+		}
+	}
+
+	/* Jobs completed in the trace are all in xJobs[] before those it cut
+	short. */
+	for( uxTask = 0; uxTask < replayMAX_TASKS; uxTask++ )
+	{
+		prvEndJob( ( uint8_t ) uxTask, ullNow, pdFALSE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseHandler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+uint64_t ullNow = ullPortSimulatedCycles();
+ReplayJob_t *pxJob;
+
+	while( ulNextRelease < ulJobCount )
+	{
+		pxJob = &( xJobs[ ulReleaseOrder[ ulNextRelease ] ] );
+
+		if( ( ullReplayStart + pxJob->ullRelease ) > ullNow )
+		{
+			vPortSimulateInterruptAt( ullReplayStart + pxJob->ullRelease, prvReleaseHandler );
+			break;
+		}
+
+		vTaskNotifyGiveFromISR( xTasks[ pxJob->ucTask ].xHandle, &xHigherPriorityTaskWoken );
+		ulNextRelease++;
+	}
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReplayTask( void *pvParameters )
+{
+uint8_t ucTask = ( uint8_t ) ( uintptr_t ) pvParameters;
+uint32_t ulJob, ulChunk;
+uint64_t ullRemaining, ullNow;
+
+	for( ulJob = 0; ulJob < ulJobCount; ulJob++ )
+	{
+		if( xJobs[ ulJob ].ucTask != ucTask )
+		{
+			continue;
+		}
+
+		ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+
+		for( ullRemaining = xJobs[ ulJob ].ullDemand; ullRemaining > 0; ullRemaining -= ulChunk )
+		{
+			ulChunk = ( ullRemaining > replayCHUNK_CYCLES ) ? replayCHUNK_CYCLES : ( uint32_t ) ullRemaining;
+			vPortSimulateCycles( ulChunk );
+		}
+
+		if( xJobs[ ulJob ].xCompleted == pdFALSE )
+		{
+			continue;
+		}
+
+		taskENTER_CRITICAL();
+		{
+			ullNow = ullPortSimulatedCycles();
+			xJobs[ ulJob ].ullResponse[ replayREPLAYED ] = ullNow - ( ullReplayStart + xJobs[ ulJob ].ullRelease );
+			ucCompletionOrder[ ulCompleted ] = ucTask;
+			ulCompleted++;
+
+			/* Tasks replaying jobs the trace cut short may keep the idle
+			task from running, so the last job to complete ends the replay. */
+			if( ulCompleted == ulCompletedJobCount )
+			{
+				prvPrintReport();
+				fflush( stdout );
+				exit( 0 );
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintReport( void )
+{
+uint32_t ulTask, ulJob, ulJobs, ulKind;
+uint64_t ullMin[ 2 ], ullMax[ 2 ], ullSum[ 2 ], ullResponse;
+const double dUsPerCycle = 1000000.0 / ( double ) ulTraceHz;
+
+	printf( "REPLAY_BEGIN,%s,%u\n", pcTraceName, ( unsigned int ) ulCompletedJobCount );
+	printf( "REPLAY_FIELDS,task,recorded_priority,priority,jobs,"
+			"recorded_min_us,recorded_avg_us,recorded_max_us,"
+			"replayed_min_us,replayed_avg_us,replayed_max_us\n" );
+
+	for( ulTask = 0; ulTask < replayMAX_TASKS; ulTask++ )
+	{
+		if( xTasks[ ulTask ].ulJobs == 0 )
+		{
+			continue;
+		}
+
+		ulJobs = 0;
+		for( ulKind = 0; ulKind < 2; ulKind++ )
+		{
+			ullMin[ ulKind ] = UINT64_MAX;
+			ullMax[ ulKind ] = 0;
+			ullSum[ ulKind ] = 0;
+		}
+
+		for( ulJob = 0; ulJob < ulCompletedJobCount; ulJob++ )
+		{
+			if( xJobs[ ulJob ].ucTask != ulTask )
+			{
+				continue;
+			}
+
+			ulJobs++;
+			for( ulKind = 0; ulKind < 2; ulKind++ )
+			{
+				ullResponse = xJobs[ ulJob ].ullResponse[ ulKind ];
+				ullMin[ ulKind ] = ( ullResponse < ullMin[ ulKind ] ) ? ullResponse : ullMin[ ulKind ];
+				ullMax[ ulKind ] = ( ullResponse > ullMax[ ulKind ] ) ? ullResponse : ullMax[ ulKind ];
+				ullSum[ ulKind ] += ullResponse;
+			}
+		}
+
+		printf( "REPLAY,%s,%u,%u,%u", xTasks[ ulTask ].cName, ( unsigned int ) xTasks[ ulTask ].uxRecordedPriority,
+				( unsigned int ) xTasks[ ulTask ].uxPriority, ( unsigned int ) ulJobs );
+
+		for( ulKind = 0; ulKind < 2; ulKind++ )
+		{
+			printf( ",%.1f,%.1f,%.1f", ( double ) ullMin[ ulKind ] * dUsPerCycle,
+					( ( double ) ullSum[ ulKind ] / ( double ) ulJobs ) * dUsPerCycle,
+					( double ) ullMax[ ulKind ] * dUsPerCycle );
+		}
+		printf( "\n" );
+	}
+
+	for( ulJob = 0; ulJob < ulCompletedJobCount; ulJob++ )
+	{
+		if( ucCompletionOrder[ ulJob ] != xJobs[ ulJob ].ucTask )
+		{
+			break;
+		}
+	}
+
+	if( ulJob == ulCompletedJobCount )
+	{
+		printf( "REPLAY_ORDER,same\n" );
+	}
+	else
+	{
+		printf( "REPLAY_ORDER,differs,%u\n", ( unsigned int ) ulJob );
+	}
+
+	printf( "REPLAY_END\n" );
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareReleases( const void *pvA, const void *pvB )
+{
+const ReplayJob_t *pxA = &( xJobs[ *( const uint32_t * ) pvA ] );
+const ReplayJob_t *pxB = &( xJobs[ *( const uint32_t * ) pvB ] );
+
+	if( pxA->ullRelease != pxB->ullRelease )
+	{
+		return ( pxA->ullRelease < pxB->ullRelease ) ? -1 : 1;
+	}
+
+	/* Keep the order of completion for jobs released together. */
+	return ( *( const uint32_t * ) pvA < *( const uint32_t * ) pvB ) ? -1 : 1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUsage( void )
+{
+	fprintf( stderr, "usage: trace_replay [-p NAME=PRIORITY]... TRACE\n" );
+	exit( 2 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char **argv )
+{
+FILE *pxFile;
+int lArg;
+uint32_t ulTask, ulJob;
+const char *pcPriority;
+BaseType_t xFound;
+UBaseType_t uxPriority;
+
+	/* The trace is read first, so -p can name the tasks it holds. */
+	if( ( argc < 2 ) || ( strcmp( argv[ argc - 1 ], "-p" ) == 0 ) )
+	{
+		prvUsage();
+	}
+
+	pcTraceName = argv[ argc - 1 ];
+	pxFile = ( strcmp( pcTraceName, "-" ) == 0 ) ? stdin : fopen( pcTraceName, "r" );
+	if( pxFile == NULL )
+	{
+		perror( pcTraceName );
+		return 1;
+	}
+
+	prvReadTrace( pxFile );
+	if( pxFile != stdin )
+	{
+		fclose( pxFile );
+	}
+
+	if( ulCompletedJobCount == 0 )
+	{
+		fprintf( stderr, "trace_replay: %s holds no complete jobs\n", pcTraceName );
+		return 1;
+	}
+
+	for( lArg = 1; lArg < argc - 1; lArg++ )
+	{
+		if( ( strcmp( argv[ lArg ], "-p" ) != 0 ) || ( lArg + 1 >= argc - 1 ) )
+		{
+			prvUsage();
+		}
+
+		lArg++;
+		pcPriority = strrchr( argv[ lArg ], '=' );
+		if( pcPriority == NULL )
+		{
+			prvUsage();
+		}
+
+		xFound = pdFALSE;
+		uxPriority = ( UBaseType_t ) strtoul( pcPriority + 1, NULL, 10 );
+		for( ulTask = 0; ulTask < replayMAX_TASKS; ulTask++ )
+		{
+			if( ( strncmp( xTasks[ ulTask ].cName, argv[ lArg ], ( size_t ) ( pcPriority - argv[ lArg ] ) ) == 0 ) &&
+				( xTasks[ ulTask ].cName[ pcPriority - argv[ lArg ] ] == '\0' ) )
+			{
+				xTasks[ ulTask ].uxPriority = uxPriority;
+				xFound = pdTRUE;
+			}
+		}
+
+		if( xFound == pdFALSE )
+		{
+			fprintf( stderr, "trace_replay: no task named %.*s in %s\n", ( int ) ( pcPriority - argv[ lArg ] ), argv[ lArg ], pcTraceName );
+			return 1;
+		}
+	}
+
+	for( ulTask = 0; ulTask < replayMAX_TASKS; ulTask++ )
+	{
+		if( xTasks[ ulTask ].xReplayed == pdFALSE )
+		{
+			continue;
+		}
+
+		if( xTasks[ ulTask ].uxPriority >= configMAX_PRIORITIES )
+		{
+			xTasks[ ulTask ].uxPriority = configMAX_PRIORITIES - 1;
+		}
+
+		if( xTaskCreate( prvReplayTask, xTasks[ ulTask ].cName, configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ulTask,
+						 xTasks[ ulTask ].uxPriority, &( xTasks[ ulTask ].xHandle ) ) != pdPASS )
+		{
+			fprintf( stderr, "trace_replay: could not create task %s\n", xTasks[ ulTask ].cName );
+			return 1;
+		}
+	}
+
+	for( ulJob = 0; ulJob < ulJobCount; ulJob++ )
+	{
+		ulReleaseOrder[ ulJob ] = ulJob;
+	}
+	qsort( ulReleaseOrder, ulJobCount, sizeof( ulReleaseOrder[ 0 ] ), prvCompareReleases );
+
+	ullReplayStart = ullPortSimulatedCycles();
+	vPortSimulateInterruptAt( ullReplayStart + xJobs[ ulReleaseOrder[ 0 ] ].ullRelease, prvReleaseHandler );
+
+	vTaskStartScheduler();
+
+	return 1;
+}
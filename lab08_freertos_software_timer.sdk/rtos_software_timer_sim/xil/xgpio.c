@@ -0,0 +1,200 @@
+/*
+ * xgpio.c for the host simulation build.  See xgpio.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "xparameters.h"
+#include "xgpio.h"
+
+#define SIM_GPIO_CHANNELS	2
+
+/* One line of the input script. */
+typedef struct {
+	u64 TimeMs;
+	u16 DeviceId;
+	unsigned Channel;
+	u32 Value;
+} GpioEvent;
+
+/* The registers of one channel. */
+typedef struct {
+	u32 Input;
+	u32 Output;
+	u32 Direction;		/* 1 bits are inputs, as in the TRI register */
+} GpioChannel;
+
+static GpioChannel Channels[XPAR_XGPIO_NUM_INSTANCES][SIM_GPIO_CHANNELS];
+static GpioEvent *Events = NULL;
+static size_t EventCount = 0;
+static size_t NextEvent = 0;
+static int ScriptLoaded = 0;
+
+/*****************************************************************************/
+/* the virtual time in ms */
+static u64 GpioTimeMs(void)
+{
+	return ullPortSimulatedCycles() / ( configCPU_CLOCK_HZ / 1000ULL );
+}
+
+/*****************************************************************************/
+/* prints the virtual time at the start of a log line */
+static void GpioLogTime(void)
+{
+	u64 Ms = GpioTimeMs();
+
+	printf("[%6llu.%03llu s] ", (unsigned long long) (Ms / 1000),
+			(unsigned long long) (Ms % 1000));
+}
+
+/*****************************************************************************/
+/* reads the input script named by SIM_GPIO_SCRIPT_VARIABLE, if any */
+static void GpioLoadScript(void)
+{
+	const char *Path = getenv(SIM_GPIO_SCRIPT_VARIABLE);
+	FILE *Script;
+	char Line[128];
+	size_t Capacity = 0;
+	unsigned long long TimeMs;
+	unsigned DeviceId, Channel;
+	long Value;
+
+	ScriptLoaded = 1;
+	if (Path == NULL) {
+		return;
+	}
+
+	Script = (strcmp(Path, "-") == 0) ? stdin : fopen(Path, "r");
+	if (Script == NULL) {
+		fprintf(stderr, "SIM: cannot open GPIO script %s\n", Path);
+		exit(EXIT_FAILURE);
+	}
+
+	while (fgets(Line, sizeof(Line), Script) != NULL) {
+		char *Comment = strchr(Line, '#');
+		if (Comment != NULL) {
+			*Comment = '\0';
+		}
+		if (sscanf(Line, "%llu %u %u %li", &TimeMs, &DeviceId, &Channel,
+				&Value) != 4) {
+			continue;
+		}
+		if ((DeviceId >= XPAR_XGPIO_NUM_INSTANCES) ||
+				(Channel < 1) || (Channel > SIM_GPIO_CHANNELS)) {
+			fprintf(stderr, "SIM: bad GPIO script line: %s", Line);
+			exit(EXIT_FAILURE);
+		}
+		if (EventCount == Capacity) {
+			Capacity = (Capacity == 0) ? 16 : Capacity * 2;
+			Events = realloc(Events, Capacity * sizeof(GpioEvent));
+			if (Events == NULL) {
+				fprintf(stderr, "SIM: out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		Events[EventCount].TimeMs = TimeMs;
+		Events[EventCount].DeviceId = (u16) DeviceId;
+		Events[EventCount].Channel = Channel;
+		Events[EventCount].Value = (u32) Value;
+		EventCount++;
+	}
+
+	if (Script != stdin) {
+		fclose(Script);
+	}
+}
+
+/*****************************************************************************/
+/* charges for a register access, then applies the inputs that are due */
+static void GpioAccess(void)
+{
+	u64 Now;
+
+	vPortSimulateCycles(SIM_GPIO_ACCESS_CYCLES);
+
+	Now = GpioTimeMs();
+	while ((NextEvent < EventCount) && (Events[NextEvent].TimeMs <= Now)) {
+		GpioEvent *Event = &Events[NextEvent];
+
+		Channels[Event->DeviceId][Event->Channel - 1].Input = Event->Value;
+		GpioLogTime();
+		printf("GPIO %u.%u input 0x%X\r\n", (unsigned) Event->DeviceId,
+				Event->Channel, (unsigned) Event->Value);
+		NextEvent++;
+	}
+}
+
+/*****************************************************************************/
+int XGpio_Initialize(XGpio *InstancePtr, u16 DeviceId)
+{
+	if (DeviceId >= XPAR_XGPIO_NUM_INSTANCES) {
+		return XST_DEVICE_NOT_FOUND;
+	}
+
+	if (!ScriptLoaded) {
+		GpioLoadScript();
+	}
+
+	InstancePtr->DeviceId = DeviceId;
+	InstancePtr->IsDual = (DeviceId == XPAR_AXI_GPIO_0_DEVICE_ID) ?
+			XPAR_AXI_GPIO_0_IS_DUAL : XPAR_AXI_GPIO_1_IS_DUAL;
+	InstancePtr->IsReady = 1;
+
+	/* all bits are inputs out of reset */
+	Channels[DeviceId][0].Direction = 0xFFFFFFFF;
+	Channels[DeviceId][1].Direction = 0xFFFFFFFF;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+static GpioChannel *GpioGetChannel(XGpio *InstancePtr, unsigned Channel)
+{
+	configASSERT(InstancePtr->IsReady);
+	configASSERT((Channel == 1) || ((Channel == 2) && InstancePtr->IsDual));
+
+	return &Channels[InstancePtr->DeviceId][Channel - 1];
+}
+
+/*****************************************************************************/
+void XGpio_SetDataDirection(XGpio *InstancePtr, unsigned Channel,
+			    u32 DirectionMask)
+{
+	GpioChannel *Regs = GpioGetChannel(InstancePtr, Channel);
+
+	GpioAccess();
+	Regs->Direction = DirectionMask;
+}
+
+/*****************************************************************************/
+u32 XGpio_GetDataDirection(XGpio *InstancePtr, unsigned Channel)
+{
+	GpioChannel *Regs = GpioGetChannel(InstancePtr, Channel);
+
+	GpioAccess();
+	return Regs->Direction;
+}
+
+/*****************************************************************************/
+u32 XGpio_DiscreteRead(XGpio *InstancePtr, unsigned Channel)
+{
+	GpioChannel *Regs = GpioGetChannel(InstancePtr, Channel);
+
+	GpioAccess();
+	return (Regs->Input & Regs->Direction) | (Regs->Output & ~Regs->Direction);
+}
+
+/*****************************************************************************/
+void XGpio_DiscreteWrite(XGpio *InstancePtr, unsigned Channel, u32 Mask)
+{
+	GpioChannel *Regs = GpioGetChannel(InstancePtr, Channel);
+
+	GpioAccess();
+	Regs->Output = Mask;
+	GpioLogTime();
+	printf("GPIO %u.%u <= 0x%X\r\n", (unsigned) InstancePtr->DeviceId,
+			Channel, (unsigned) (Mask & ~Regs->Direction));
+}
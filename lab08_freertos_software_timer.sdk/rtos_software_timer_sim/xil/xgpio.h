@@ -0,0 +1,50 @@
+/*
+ * xgpio.h for the host simulation build.
+ *
+ * A model of the AXI GPIO driver used by the applications.  Outputs are
+ * logged to stdout with the virtual time of the write.  Inputs are driven by a
+ * script, read from the file named by the SIM_GPIO environment variable, or
+ * from stdin if it is "-".  Each line of the script is
+ *
+ *	<time in ms> <device id> <channel> <value>
+ *
+ * and sets the input of that channel from that time on.  Lines must be in
+ * time order, and everything after a '#' is a comment.  Inputs are 0 until
+ * set.  Each register access costs SIM_GPIO_ACCESS_CYCLES of virtual time.
+ */
+
+#ifndef XGPIO_H
+#define XGPIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xil_types.h"
+#include "xstatus.h"
+
+#ifndef SIM_GPIO_ACCESS_CYCLES
+	#define SIM_GPIO_ACCESS_CYCLES	130
+#endif
+
+/* The script is read from the file named by this environment variable. */
+#define SIM_GPIO_SCRIPT_VARIABLE	"SIM_GPIO"
+
+typedef struct {
+	u16 DeviceId;		/* Unique ID of device */
+	u32 IsReady;		/* Device is initialized and ready */
+	int IsDual;			/* Are 2 Channels supported in h/w */
+} XGpio;
+
+int XGpio_Initialize(XGpio *InstancePtr, u16 DeviceId);
+void XGpio_SetDataDirection(XGpio *InstancePtr, unsigned Channel,
+			    u32 DirectionMask);
+u32 XGpio_GetDataDirection(XGpio *InstancePtr, unsigned Channel);
+u32 XGpio_DiscreteRead(XGpio *InstancePtr, unsigned Channel);
+void XGpio_DiscreteWrite(XGpio *InstancePtr, unsigned Channel, u32 Mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XGPIO_H */
@@ -0,0 +1,9 @@
+/*
+ * xil_cache.c for the host simulation build.  See xil_cache_l.h.
+ */
+
+#include "xil_cache_l.h"
+
+void Xil_L1DCacheFlush(void)
+{
+}
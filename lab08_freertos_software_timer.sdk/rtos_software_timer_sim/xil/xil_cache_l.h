@@ -0,0 +1,21 @@
+/*
+ * xil_cache_l.h for the host simulation build.
+ *
+ * The simulation has no caches, so the L1 cache maintenance the applications
+ * use does nothing.
+ */
+
+#ifndef XIL_CACHE_L_H
+#define XIL_CACHE_L_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void Xil_L1DCacheFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_CACHE_L_H */
@@ -0,0 +1,17 @@
+/*
+ * xil_printf.c for the host simulation build.  See xil_printf.h.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "xil_printf.h"
+
+void xil_printf( const char *ctrl1, ...)
+{
+	va_list argp;
+
+	va_start(argp, ctrl1);
+	vprintf(ctrl1, argp);
+	va_end(argp);
+}
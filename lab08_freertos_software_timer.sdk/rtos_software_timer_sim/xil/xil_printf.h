@@ -0,0 +1,19 @@
+/*
+ * xil_printf.h for the host simulation build.  xil_printf() prints to stdout
+ * with the C library.
+ */
+
+#ifndef XIL_PRINTF_H
+#define XIL_PRINTF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void xil_printf( const char *ctrl1, ...) __attribute__((format(printf, 1, 2)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_PRINTF_H */
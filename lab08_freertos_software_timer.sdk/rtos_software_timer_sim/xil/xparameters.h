@@ -0,0 +1,22 @@
+/*
+ * xparameters.h for the host simulation build.
+ *
+ * Only the parameters the applications use are defined.  The values are those
+ * of the Zybo design in the BSP's xparameters.h.
+ */
+
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ 650000000
+
+/* Definitions for driver GPIO */
+#define XPAR_XGPIO_NUM_INSTANCES 2
+
+#define XPAR_AXI_GPIO_0_DEVICE_ID 0
+#define XPAR_AXI_GPIO_0_IS_DUAL 1
+
+#define XPAR_AXI_GPIO_1_DEVICE_ID 1
+#define XPAR_AXI_GPIO_1_IS_DUAL 0
+
+#endif /* XPARAMETERS_H */
@@ -0,0 +1,19 @@
+/*
+ * xpm_counter.c for the host simulation build.  See xpm_counter.h.
+ */
+
+#include "xpm_counter.h"
+
+void Xpm_SetEvents(s32 PmcrCfg)
+{
+	(void) PmcrCfg;
+}
+
+void Xpm_GetEventCounters(u32 *PmCtrValue)
+{
+	u32 Counter;
+
+	for (Counter = 0U; Counter < XPM_CTRCOUNT; Counter++) {
+		PmCtrValue[Counter] = 0U;
+	}
+}
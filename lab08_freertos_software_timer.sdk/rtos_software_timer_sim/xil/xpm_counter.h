@@ -0,0 +1,32 @@
+/*
+ * xpm_counter.h for the host simulation build.
+ *
+ * A model of the Cortex-A9 performance monitor event counters.  The
+ * simulation has no caches or TLBs to count the events of, so every counter
+ * reads 0.
+ */
+
+#ifndef XPMCOUNTER_H
+#define XPMCOUNTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "xil_types.h"
+
+#define XPM_CTRCOUNT 6U
+
+/* Counters 0 to 5 count the software increments, instruction cache refills,
+instruction TLB refills, data cache refills, data cache accesses and data TLB
+refills, as on the target. */
+#define XPM_CNTRCFG1	0
+
+void Xpm_SetEvents(s32 PmcrCfg);
+void Xpm_GetEventCounters(u32 *PmCtrValue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XPMCOUNTER_H */
@@ -0,0 +1,13 @@
+/*
+ * xstatus.h for the host simulation build.
+ */
+
+#ifndef XSTATUS_H
+#define XSTATUS_H
+
+#define XST_SUCCESS                     0L
+#define XST_FAILURE                     1L
+#define XST_DEVICE_NOT_FOUND            2L
+#define XST_INVALID_PARAM               15L
+
+#endif /* XSTATUS_H */